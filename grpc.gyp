@@ -255,6 +255,7 @@
         'test/core/end2end/tests/retry_throttled.cc',
         'test/core/end2end/tests/retry_too_many_attempts.cc',
         'test/core/end2end/tests/server_finishes_request.cc',
+        'test/core/end2end/tests/server_max_inflight_calls.cc',
         'test/core/end2end/tests/server_streaming.cc',
         'test/core/end2end/tests/shutdown_finishes_calls.cc',
         'test/core/end2end/tests/shutdown_finishes_tags.cc',
@@ -358,6 +359,7 @@
         'test/core/end2end/tests/retry_throttled.cc',
         'test/core/end2end/tests/retry_too_many_attempts.cc',
         'test/core/end2end/tests/server_finishes_request.cc',
+        'test/core/end2end/tests/server_max_inflight_calls.cc',
         'test/core/end2end/tests/server_streaming.cc',
         'test/core/end2end/tests/shutdown_finishes_calls.cc',
         'test/core/end2end/tests/shutdown_finishes_tags.cc',
@@ -478,6 +480,7 @@
         'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
+        'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
         'src/core/ext/filters/client_channel/lb_policy/xds/cds.cc',
@@ -555,6 +558,7 @@
         'src/core/ext/transport/chttp2/transport/stream_lists.cc',
         'src/core/ext/transport/chttp2/transport/stream_map.cc',
         'src/core/ext/transport/chttp2/transport/varint.cc',
+        'src/core/ext/transport/chttp2/transport/write_scheduler.cc',
         'src/core/ext/transport/chttp2/transport/writing.cc',
         'src/core/ext/transport/inproc/inproc_plugin.cc',
         'src/core/ext/transport/inproc/inproc_transport.cc',
@@ -780,6 +784,7 @@
         'src/core/lib/iomgr/executor.cc',
         'src/core/lib/iomgr/executor/mpmcqueue.cc',
         'src/core/lib/iomgr/executor/threadpool.cc',
+        'src/core/lib/iomgr/executor/work_stealing_threadpool.cc',
         'src/core/lib/iomgr/fork_posix.cc',
         'src/core/lib/iomgr/fork_windows.cc',
         'src/core/lib/iomgr/gethostname_fallback.cc',
@@ -809,11 +814,13 @@
         'src/core/lib/iomgr/pollset_set_windows.cc',
         'src/core/lib/iomgr/pollset_uv.cc',
         'src/core/lib/iomgr/pollset_windows.cc',
+        'src/core/lib/iomgr/read_buffer_pool.cc',
         'src/core/lib/iomgr/resolve_address.cc',
         'src/core/lib/iomgr/resolve_address_custom.cc',
         'src/core/lib/iomgr/resolve_address_posix.cc',
         'src/core/lib/iomgr/resolve_address_windows.cc',
         'src/core/lib/iomgr/resource_quota.cc',
+        'src/core/lib/iomgr/serializer_profiler.cc',
         'src/core/lib/iomgr/sockaddr_utils.cc',
         'src/core/lib/iomgr/socket_factory_posix.cc',
         'src/core/lib/iomgr/socket_mutator.cc',
@@ -846,6 +853,7 @@
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
         'src/core/lib/iomgr/timer_uv.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
@@ -940,6 +948,7 @@
         'src/core/lib/surface/version.cc',
         'src/core/lib/transport/authority_override.cc',
         'src/core/lib/transport/bdp_estimator.cc',
+        'src/core/lib/transport/bottleneck_estimator.cc',
         'src/core/lib/transport/byte_stream.cc',
         'src/core/lib/transport/connectivity_state.cc',
         'src/core/lib/transport/error_utils.cc',
@@ -1111,6 +1120,7 @@
         'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
+        'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
         'src/core/ext/filters/client_channel/lb_policy_registry.cc',
@@ -1180,6 +1190,7 @@
         'src/core/ext/transport/chttp2/transport/stream_lists.cc',
         'src/core/ext/transport/chttp2/transport/stream_map.cc',
         'src/core/ext/transport/chttp2/transport/varint.cc',
+        'src/core/ext/transport/chttp2/transport/write_scheduler.cc',
         'src/core/ext/transport/chttp2/transport/writing.cc',
         'src/core/ext/transport/inproc/inproc_plugin.cc',
         'src/core/ext/transport/inproc/inproc_transport.cc',
@@ -1245,6 +1256,7 @@
         'src/core/lib/iomgr/executor.cc',
         'src/core/lib/iomgr/executor/mpmcqueue.cc',
         'src/core/lib/iomgr/executor/threadpool.cc',
+        'src/core/lib/iomgr/executor/work_stealing_threadpool.cc',
         'src/core/lib/iomgr/fork_posix.cc',
         'src/core/lib/iomgr/fork_windows.cc',
         'src/core/lib/iomgr/gethostname_fallback.cc',
@@ -1274,11 +1286,13 @@
         'src/core/lib/iomgr/pollset_set_windows.cc',
         'src/core/lib/iomgr/pollset_uv.cc',
         'src/core/lib/iomgr/pollset_windows.cc',
+        'src/core/lib/iomgr/read_buffer_pool.cc',
         'src/core/lib/iomgr/resolve_address.cc',
         'src/core/lib/iomgr/resolve_address_custom.cc',
         'src/core/lib/iomgr/resolve_address_posix.cc',
         'src/core/lib/iomgr/resolve_address_windows.cc',
         'src/core/lib/iomgr/resource_quota.cc',
+        'src/core/lib/iomgr/serializer_profiler.cc',
         'src/core/lib/iomgr/sockaddr_utils.cc',
         'src/core/lib/iomgr/socket_factory_posix.cc',
         'src/core/lib/iomgr/socket_mutator.cc',
@@ -1311,6 +1325,7 @@
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
         'src/core/lib/iomgr/timer_uv.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
@@ -1350,6 +1365,7 @@
         'src/core/lib/surface/version.cc',
         'src/core/lib/transport/authority_override.cc',
         'src/core/lib/transport/bdp_estimator.cc',
+        'src/core/lib/transport/bottleneck_estimator.cc',
         'src/core/lib/transport/byte_stream.cc',
         'src/core/lib/transport/connectivity_state.cc',
         'src/core/lib/transport/error_utils.cc',
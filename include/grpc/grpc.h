@@ -135,6 +135,22 @@ GRPCAPI grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
                                               gpr_timespec deadline,
                                               void* reserved);
 
+/** Like grpc_completion_queue_next, but once an event is available returns
+    up to max_events of the events queued at that point in one call.
+
+    Fills in events and returns the number of entries written, which is at
+    least 1 (max_events must be at least 1). A timeout or the completion queue
+    being shut down is reported as a single GRPC_QUEUE_TIMEOUT or
+    GRPC_QUEUE_SHUTDOWN event, exactly as grpc_completion_queue_next would
+    return it.
+
+    Only valid on completion queues of type GRPC_CQ_NEXT. */
+GRPCAPI size_t grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                                grpc_event* events,
+                                                size_t max_events,
+                                                gpr_timespec deadline,
+                                                void* reserved);
+
 /** Blocks until an event with tag 'tag' is available, the completion queue is
     being shutdown or deadline is reached.
 
@@ -541,6 +557,14 @@ GRPCAPI char* grpc_channelz_get_subchannel(intptr_t subchannel_id);
    is allocated and must be freed by the application. */
 GRPCAPI char* grpc_channelz_get_socket(intptr_t socket_id);
 
+/* EXPERIMENTAL. Returns the contention profile of the process' combiners and
+   work serializers: per-serializer queue depth, time-in-queue and execution
+   time histograms, and the locations the most time was spent running work
+   created at. The profile is only collected by builds defining
+   GRPC_SERIALIZER_PROFILING, and is empty otherwise. The returned string is
+   allocated and must be freed by the application. */
+GRPCAPI char* grpc_channelz_get_serializer_profile(void);
+
 #ifdef __cplusplus
 }
 #endif
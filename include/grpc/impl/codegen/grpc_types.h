@@ -202,6 +202,23 @@ typedef struct {
 #define GRPC_ARG_HTTP2_MAX_FRAME_SIZE "grpc.http2.max_frame_size"
 /** Should BDP probing be performed? */
 #define GRPC_ARG_HTTP2_BDP_PROBE "grpc.http2.bdp_probe"
+/** How the initial window is sized from BDP probes, string valued:
+    "pid" (the default) smooths the BDP estimate with a PID controller, "bbr"
+    targets twice the product of the bottleneck bandwidth and the minimum
+    round-trip time measured by the probes, which converges faster on links
+    with a large BDP. Has no effect if BDP probing is disabled. */
+#define GRPC_ARG_HTTP2_FLOW_CONTROL_POLICY "grpc.http2.flow_control_policy"
+/** How the streams of a connection that have data to send share it, string
+    valued: "fifo" (the default) lets each stream send all that flow control
+    allows, in the order they have data. "wfq" shares the connection between
+    streams in proportion to their weights (see
+    GRPC_HTTP2_WRITE_WEIGHT_MD_KEY), and sends streams with only a small
+    message left to send ahead of the others. */
+#define GRPC_ARG_HTTP2_WRITE_SCHEDULER "grpc.http2.write_scheduler"
+/** Initial metadata key setting the weight of a call's stream under the "wfq"
+    write scheduler, an integer from 1 (the default) to 256. HTTP/2 transports
+    consume it whatever their scheduler, and never send it to the peer. */
+#define GRPC_HTTP2_WRITE_WEIGHT_MD_KEY "grpc-internal-write-weight"
 /** (DEPRECATED) Does not have any effect.
     Earlier, this arg configured the minimum time between successive ping frames
     without receiving any data/header frame, Int valued, milliseconds. This put
@@ -232,6 +249,18 @@ typedef struct {
 /** How much data are we willing to queue up per stream if
     GRPC_WRITE_BUFFER_HINT is set? This is an upper bound */
 #define GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE "grpc.http2.write_buffer_size"
+/** How long may the transport delay a write that carries application data
+    (new streams, messages, metadata) so that it can be coalesced with writes
+    started shortly afterwards, on any stream, into a single endpoint write?
+    Trades latency for fewer, larger writes. Int valued, milliseconds (the
+    resolution of timers), defaults to 0 (writes are never delayed). */
+#define GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_MS \
+  "grpc.http2.write_coalescing_delay_ms"
+/** When write coalescing is enabled, a delayed write is started early once
+    this many message bytes have been queued for it. Int valued, defaults to
+    65536. */
+#define GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES \
+  "grpc.http2.write_coalescing_bytes"
 /** Should we allow receipt of true-binary data on http2 connections?
     Defaults to on (1) */
 #define GRPC_ARG_HTTP2_ENABLE_TRUE_BINARY "grpc.http2.true_binary"
@@ -293,10 +322,34 @@ typedef struct {
 #define GRPC_ARG_MAX_METADATA_SIZE "grpc.max_metadata_size"
 /** If non-zero, allow the use of SO_REUSEPORT if it's available (default 1) */
 #define GRPC_ARG_ALLOW_REUSEPORT "grpc.so_reuseport"
+/** If non-zero, a server hands each accepted connection to the pollset of its
+    registered completion queue number (c % number of pollsets), where c is the
+    CPU that received the connection, instead of assigning pollsets round-robin.
+    Meant for servers whose completion queue i is only polled from core i, so
+    that a connection is handled on the core that receives its packets. With
+    SO_REUSEPORT, listener i also prefers connections received on CPU i.
+    Linux only (SO_INCOMING_CPU); elsewhere it has no effect. Default 0. */
+#define GRPC_ARG_SERVER_CPU_AFFINITY "grpc.server_cpu_affinity"
+/** If positive, connections accepted by a server get SO_BUSY_POLL set to this
+    many microseconds, and SO_PREFER_BUSY_POLL where the kernel supports it,
+    so that reads finding no data busy poll the network device queue instead
+    of sleeping. Values above the net.core.busy_read sysctl, and
+    SO_PREFER_BUSY_POLL, need CAP_NET_ADMIN. Linux only. Default 0. */
+#define GRPC_ARG_TCP_SERVER_BUSY_POLL_US "grpc.tcp_server_busy_poll_us"
 /** If non-zero, a pointer to a buffer pool (a pointer of type
  * grpc_resource_quota*). (use grpc_resource_quota_arg_vtable() to fetch an
  * appropriate pointer arg vtable) */
 #define GRPC_ARG_RESOURCE_QUOTA "grpc.resource_quota"
+/** Maximum number of calls a server keeps in flight: incoming calls beyond it
+    are rejected with RESOURCE_EXHAUSTED as soon as their stream is accepted,
+    before being matched to a request. Default unlimited. */
+#define GRPC_ARG_SERVER_MAX_INFLIGHT_CALLS "grpc.server_max_inflight_calls"
+/** Memory pressure of the server's resource quota (see
+    GRPC_ARG_RESOURCE_QUOTA), in percent, at or above which incoming calls are
+    rejected with RESOURCE_EXHAUSTED as soon as their stream is accepted. 0 (the
+    default) disables this, as does not setting a resource quota. */
+#define GRPC_ARG_SERVER_MEMORY_PRESSURE_REJECT_PERCENT \
+  "grpc.server_memory_pressure_reject_percent"
 /** If non-zero, expand wildcard addresses to a list of local addresses. */
 #define GRPC_ARG_EXPAND_WILDCARD_ADDRS "grpc.expand_wildcard_addrs"
 /** Service config data in JSON form.
@@ -350,6 +403,24 @@ typedef struct {
    issued by the tcp_write(). By default, this is set to 4. */
 #define GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS \
   "grpc.experimental.tcp_tx_zerocopy_max_simultaneous_sends"
+/* TCP RX Zerocopy enable state: zero is disabled, non-zero is enabled. When
+   enabled, large reads map the kernel's receive pages into read-only slices
+   instead of copying them (Linux 4.18+ TCP sockets only). By default, it is
+   disabled. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED \
+  "grpc.experimental.tcp_rx_zerocopy_enabled"
+/* TCP RX Zerocopy receive threshold: only zerocopy if at least this many bytes
+   are queued on the socket. By default, this is set to 64KB. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_RECV_BYTES_THRESHOLD \
+  "grpc.experimental.tcp_rx_zerocopy_recv_bytes_threshold"
+/* Idle mode for connections that mostly wait for incoming data: once a
+   connection has waited this many milliseconds without receiving anything, its
+   TCP endpoint releases its read buffers, to allocate them again when data
+   arrives. Zero releases them as soon as the connection starts waiting. When
+   set, the HTTP2 transport also releases its header parsing buffers whenever
+   it has no streams left. By default (-1), buffers are kept. */
+#define GRPC_ARG_IDLE_READ_BUFFER_RELEASE_MS \
+  "grpc.experimental.idle_read_buffer_release_ms"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_call_timeout_ms"
@@ -413,6 +484,16 @@ typedef struct {
 /** If set, uses a local subchannel pool within the channel. Otherwise, uses the
  * global subchannel pool. */
 #define GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL "grpc.use_local_subchannel_pool"
+/** Maximum number of connections a subchannel may open to its address.
+ * Above 1, the subchannel opens another connection whenever every one it
+ * has carries GRPC_ARG_SUBCHANNEL_MAX_CALLS_PER_CONNECTION calls, and closes
+ * the extra connections again as they go idle. Int valued, defaults to 1. */
+#define GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS "grpc.subchannel_max_connections"
+/** Number of concurrent calls on each connection of a subchannel above which
+ * it opens another one, when GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS allows it.
+ * Int valued, defaults to 100. */
+#define GRPC_ARG_SUBCHANNEL_MAX_CALLS_PER_CONNECTION \
+  "grpc.subchannel_max_calls_per_connection"
 /** gRPC Objective-C channel pooling domain string. */
 #define GRPC_ARG_CHANNEL_POOL_DOMAIN "grpc.channel_pooling_domain"
 /** gRPC Objective-C channel pooling id. */
@@ -758,8 +839,9 @@ typedef struct grpc_experimental_completion_queue_functor {
 
 /* The upgrade to version 2 is currently experimental. */
 
-#define GRPC_CQ_CURRENT_VERSION 2
+#define GRPC_CQ_CURRENT_VERSION 3
 #define GRPC_CQ_VERSION_MINIMUM_FOR_CALLBACKABLE 2
+#define GRPC_CQ_VERSION_MINIMUM_FOR_SHARDING 3
 typedef struct grpc_completion_queue_attributes {
   /** The version number of this structure. More fields might be added to this
      structure in future. */
@@ -777,6 +859,17 @@ typedef struct grpc_completion_queue_attributes {
   grpc_experimental_completion_queue_functor* cq_shutdown_cb;
 
   /* END OF VERSION 2 CQ ATTRIBUTES */
+
+  /* EXPERIMENTAL: START OF VERSION 3 CQ ATTRIBUTES */
+  /** Non-zero splits the events of a GRPC_CQ_NEXT completion queue across
+   * per-CPU shards, so that threads calling grpc_completion_queue_next on it
+   * contend less with each other. This relaxes ordering: events completed on
+   * the same CPU are still returned in order, but events completed on
+   * different CPUs may be returned in any order. Ignored by other completion
+   * types. Zero (the default) keeps a single FIFO queue. */
+  int cq_sharded;
+
+  /* END OF VERSION 3 CQ ATTRIBUTES */
 } grpc_completion_queue_attributes;
 
 /** The completion queue factory structure is opaque to the callers of grpc */
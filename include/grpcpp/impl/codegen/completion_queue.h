@@ -180,6 +180,23 @@ class CompletionQueue : private ::grpc::GrpcLibraryCodegen {
                                   GPR_CLOCK_REALTIME)) != SHUTDOWN);
   }
 
+  /// EXPERIMENTAL
+  /// Read up to \a max_events events from the queue, blocking until at least
+  /// one is available or the queue is fully drained and shut down. Draining
+  /// events in batches saves the per-call overhead of \a Next when many
+  /// events are pending.
+  ///
+  /// \param[out] tags Upon success, its first entries (as many as returned)
+  ///        point to the events' tags.
+  /// \param[out] oks Upon success, its first entries (as many as returned)
+  ///        hold the events' \a ok values. See documentation for
+  ///        CompletionQueue::Next for explanation of ok.
+  /// \param[in] max_events The size of \a tags and \a oks; must be at least 1.
+  ///
+  /// \return The number of events read, or 0 if the queue is fully drained
+  ///         and shut down.
+  size_t NextBatch(void** tags, bool* oks, size_t max_events);
+
   /// Read from the queue, blocking up to \a deadline (or the queue's shutdown).
   /// Both \a tag and \a ok are updated upon success (if an event is available
   /// within the \a deadline).  A \a tag points to an arbitrary location usually
@@ -312,6 +329,12 @@ class CompletionQueue : private ::grpc::GrpcLibraryCodegen {
 
   NextStatus AsyncNextInternal(void** tag, bool* ok, gpr_timespec deadline);
 
+  /// Batch version of \a AsyncNextInternal: on GOT_EVENT, the first
+  /// \a *num_events (at most \a max_events) entries of \a tags and \a oks
+  /// hold the events read.
+  NextStatus AsyncNextBatchInternal(void** tags, bool* oks, size_t max_events,
+                                    size_t* num_events, gpr_timespec deadline);
+
   /// Wraps \a grpc_completion_queue_pluck.
   /// \warning Must not be mixed with calls to \a Next.
   bool Pluck(::grpc::internal::CompletionQueueTag* tag) {
@@ -295,6 +295,15 @@ class ServerBuilder {
     AddExternalConnectionAcceptor(ExternalConnectionType type,
                                   std::shared_ptr<ServerCredentials> creds);
 
+    /// Enable thread-per-core mode: each accepted connection is handed to the
+    /// listening completion queue matching the core that received it (see
+    /// GRPC_ARG_SERVER_CPU_AFFINITY), so that its transport and handlers stay
+    /// on that core. A synchronous server creates one completion queue per
+    /// core and pins the threads serving it to that core, overriding
+    /// NUM_CQS. An asynchronous server gets the same affinity if it polls its
+    /// i-th completion queue only from core i.
+    ServerBuilder& SetThreadPerCore(bool enable);
+
    private:
     ServerBuilder* builder_;
   };
@@ -386,6 +395,7 @@ class ServerBuilder {
   std::vector<Port> ports_;
 
   SyncServerSettings sync_server_settings_;
+  bool thread_per_core_{false};
 
   /// List of completion queues added via \a AddCompletionQueue method.
   std::vector<grpc::ServerCompletionQueue*> cqs_;
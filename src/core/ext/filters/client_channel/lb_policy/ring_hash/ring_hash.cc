@@ -0,0 +1,801 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/** Ring Hash Policy.
+ *
+ * Sends each call to the address that owns its request hash on a consistent
+ * hashing ring (see RingHashRing), so that calls with the same key go to the
+ * same backend, and only the keys of an address move when it comes or goes.
+ * The request hash is that of the header named in the config, or of the
+ * kRequestRingHashAttribute call attribute; calls with neither go to a
+ * random point of the ring.
+ *
+ * If the address owning the hash is connecting, the pick is queued, to keep
+ * the affinity; if it failed, the call goes to the next READY address on the
+ * ring. Like round_robin, all the addresses are connected to up front. */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/murmur_hash.h"
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/sockaddr_utils.h"
+#include "src/core/lib/transport/connectivity_state.h"
+#include "src/core/lib/transport/error_utils.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_ring_hash_trace(false, "ring_hash_lb");
+
+const char* kRequestRingHashAttribute = "ring_hash_request_key";
+
+//
+// RingHashRing
+//
+
+namespace {
+
+bool EntryLess(const RingHashRing::Entry& a, const RingHashRing::Entry& b) {
+  return a.hash < b.hash || (a.hash == b.hash && a.index < b.index);
+}
+
+void AddPoints(const std::string& key, uint32_t index,
+               size_t points_per_address,
+               std::vector<RingHashRing::Entry>* entries) {
+  for (size_t i = 0; i < points_per_address; ++i) {
+    entries->push_back({gpr_murmur_hash3(key.data(), key.size(),
+                                         static_cast<uint32_t>(i)),
+                        index});
+  }
+}
+
+}  // namespace
+
+RingHashRing::RingHashRing(std::vector<std::string> keys, size_t min_ring_size,
+                           size_t max_ring_size, const RingHashRing* previous)
+    : keys_(std::move(keys)) {
+  const size_t num_addresses = keys_.size();
+  if (num_addresses == 0) return;
+  // Keep the previous number of points per address while the ring stays
+  // within bounds: changing it moves all the points.
+  if (previous != nullptr && previous->points_per_address_ > 0 &&
+      previous->points_per_address_ * num_addresses >= min_ring_size &&
+      previous->points_per_address_ * num_addresses <= max_ring_size) {
+    points_per_address_ = previous->points_per_address_;
+  } else {
+    points_per_address_ = (min_ring_size + num_addresses - 1) / num_addresses;
+    if (points_per_address_ * num_addresses > max_ring_size) {
+      points_per_address_ = std::max<size_t>(max_ring_size / num_addresses, 1);
+    }
+    previous = nullptr;
+  }
+  std::vector<Entry> kept;
+  std::vector<Entry> added;
+  if (previous != nullptr) {
+    // Carry over the points of the addresses still there, under their new
+    // index; they are already in order.
+    std::unordered_map<std::string, uint32_t> index_of;
+    for (size_t i = 0; i < num_addresses; ++i) {
+      index_of.emplace(keys_[i], static_cast<uint32_t>(i));
+    }
+    constexpr uint32_t kRemoved = UINT32_MAX;
+    std::vector<uint32_t> new_index(previous->keys_.size(), kRemoved);
+    std::vector<bool> has_points(num_addresses, false);
+    for (size_t i = 0; i < previous->keys_.size(); ++i) {
+      auto it = index_of.find(previous->keys_[i]);
+      if (it == index_of.end()) continue;
+      new_index[i] = it->second;
+      has_points[it->second] = true;
+    }
+    kept.reserve(previous->ring_.size());
+    for (const Entry& entry : previous->ring_) {
+      if (new_index[entry.index] != kRemoved) {
+        kept.push_back({entry.hash, new_index[entry.index]});
+      }
+    }
+    // Remapping indexes may break the order of points with equal hashes.
+    if (!std::is_sorted(kept.begin(), kept.end(), EntryLess)) {
+      std::sort(kept.begin(), kept.end(), EntryLess);
+    }
+    for (size_t i = 0; i < num_addresses; ++i) {
+      if (!has_points[i]) {
+        AddPoints(keys_[i], static_cast<uint32_t>(i), points_per_address_,
+                  &added);
+      }
+    }
+  } else {
+    added.reserve(points_per_address_ * num_addresses);
+    for (size_t i = 0; i < num_addresses; ++i) {
+      AddPoints(keys_[i], static_cast<uint32_t>(i), points_per_address_,
+                &added);
+    }
+  }
+  std::sort(added.begin(), added.end(), EntryLess);
+  ring_.resize(kept.size() + added.size());
+  std::merge(kept.begin(), kept.end(), added.begin(), added.end(),
+             ring_.begin(), EntryLess);
+}
+
+size_t RingHashRing::Find(uint32_t hash) const {
+  auto it = std::lower_bound(
+      ring_.begin(), ring_.end(), hash,
+      [](const Entry& entry, uint32_t hash) { return entry.hash < hash; });
+  if (it == ring_.end()) return 0;
+  return static_cast<size_t>(it - ring_.begin());
+}
+
+namespace {
+
+//
+// ring_hash LB policy
+//
+
+constexpr char kRingHash[] = "ring_hash_experimental";
+
+constexpr size_t kDefaultMinRingSize = 1024;
+constexpr size_t kMaxRingSize = 8 * 1024 * 1024;
+
+// State of the xorshift generator that places the calls without a key, per
+// thread so that picks need no lock. Zero until first used by the thread.
+GPR_TLS_DECL(g_random_hash_state);
+
+uint32_t RandomHash() {
+  uint32_t state = static_cast<uint32_t>(gpr_tls_get(&g_random_hash_state));
+  if (state == 0) {
+    // The address of the state differs between the threads that start at
+    // the same time.
+    state = static_cast<uint32_t>(gpr_now(GPR_CLOCK_PRECISE).tv_nsec) ^
+            static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&state));
+    if (state == 0) state = 1;
+  }
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  gpr_tls_set(&g_random_hash_state, static_cast<intptr_t>(state));
+  return state;
+}
+
+class RingHashLbConfig : public LoadBalancingPolicy::Config {
+ public:
+  RingHashLbConfig(size_t min_ring_size, size_t max_ring_size,
+                   std::string hash_header)
+      : min_ring_size_(min_ring_size),
+        max_ring_size_(max_ring_size),
+        hash_header_(std::move(hash_header)) {}
+
+  const char* name() const override { return kRingHash; }
+
+  size_t min_ring_size() const { return min_ring_size_; }
+  size_t max_ring_size() const { return max_ring_size_; }
+  // Header whose value is hashed, or empty to use kRequestRingHashAttribute
+  const std::string& hash_header() const { return hash_header_; }
+
+ private:
+  size_t min_ring_size_;
+  size_t max_ring_size_;
+  std::string hash_header_;
+};
+
+class RingHash : public LoadBalancingPolicy {
+ public:
+  explicit RingHash(Args args);
+
+  const char* name() const override { return kRingHash; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  ~RingHash() override;
+
+  // Forward declaration.
+  class RingHashSubchannelList;
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Keeps the key of the address on the ring.
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  class RingHashSubchannelData
+      : public SubchannelData<RingHashSubchannelList, RingHashSubchannelData> {
+   public:
+    RingHashSubchannelData(
+        SubchannelList<RingHashSubchannelList, RingHashSubchannelData>*
+            subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel)
+        : SubchannelData(subchannel_list, address, std::move(subchannel)),
+          key_(grpc_sockaddr_to_string(&address.address(), false)) {}
+
+    const std::string& key() const { return key_; }
+
+    // The state to pick by: TRANSIENT_FAILURE from a failure until the
+    // subchannel is READY again.
+    grpc_connectivity_state connectivity_state() const {
+      return seen_failure_since_ready_ ? GRPC_CHANNEL_TRANSIENT_FAILURE
+                                       : last_connectivity_state_;
+    }
+
+    // Performs connectivity state updates that need to be done both when we
+    // first start watching and when a watcher notification is received.
+    void UpdateConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+   private:
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        grpc_connectivity_state connectivity_state) override;
+
+    std::string key_;
+    grpc_connectivity_state last_connectivity_state_ = GRPC_CHANNEL_IDLE;
+    bool seen_failure_since_ready_ = false;
+  };
+
+  // A list of subchannels, and their ring.
+  class RingHashSubchannelList
+      : public SubchannelList<RingHashSubchannelList, RingHashSubchannelData> {
+   public:
+    RingHashSubchannelList(RingHash* policy, TraceFlag* tracer,
+                           ServerAddressList addresses,
+                           const grpc_channel_args& args,
+                           const RingHashSubchannelList* previous);
+
+    ~RingHashSubchannelList() override {
+      RingHash* p = static_cast<RingHash*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    RefCountedPtr<RingHashRing> ring() const { return ring_; }
+
+    // Starts watching the subchannels in this list.
+    void StartWatchingLocked();
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                                   grpc_connectivity_state new_state);
+
+    // If this subchannel list is the policy's current subchannel list,
+    // updates the policy's connectivity state based on the subchannel
+    // list's state counters.
+    void MaybeUpdateRingHashConnectivityStateLocked();
+
+    // Updates the policy's overall state based on the counters of
+    // subchannels in each state.
+    void UpdateRingHashStateFromSubchannelStateCountsLocked();
+
+   private:
+    RefCountedPtr<RingHashRing> ring_;
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+  };
+
+  // Picks never take a lock: the ring and the subchannel states it picks
+  // from are fixed when the picker is created.
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(RingHash* parent, RingHashSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    struct SubchannelEntry {
+      RefCountedPtr<SubchannelInterface> subchannel;
+      grpc_connectivity_state connectivity_state;
+    };
+
+    uint32_t RequestHash(const PickArgs& args) const;
+
+    // Using pointer value only, no ref held -- do not dereference!
+    RingHash* parent_;
+
+    RefCountedPtr<RingHashRing> ring_;
+    RefCountedPtr<RingHashLbConfig> config_;
+    // Indexed like the keys of the ring
+    absl::InlinedVector<SubchannelEntry, 10> subchannels_;
+    // Positions of the points of READY subchannels, in ring order, to fail
+    // over in O(log(ring)). Only filled if some subchannel failed.
+    std::vector<uint32_t> ready_points_;
+  };
+
+  void ShutdownLocked() override;
+
+  RefCountedPtr<RingHashLbConfig> config_;
+  /** list of subchannels */
+  OrphanablePtr<RingHashSubchannelList> subchannel_list_;
+  /** Latest version of the subchannel list.
+   * Subchannel connectivity callbacks will only promote updated subchannel
+   * lists if they equal \a latest_pending_subchannel_list. In other words,
+   * racing callbacks that reference outdated subchannel lists won't perform any
+   * update. */
+  OrphanablePtr<RingHashSubchannelList> latest_pending_subchannel_list_;
+  /** are we shutting down? */
+  bool shutdown_ = false;
+};
+
+//
+// RingHash::Picker
+//
+
+RingHash::Picker::Picker(RingHash* parent,
+                         RingHashSubchannelList* subchannel_list)
+    : parent_(parent),
+      ring_(subchannel_list->ring()),
+      config_(parent->config_) {
+  subchannels_.reserve(subchannel_list->num_subchannels());
+  bool failover = false;
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    RingHashSubchannelData* sd = subchannel_list->subchannel(i);
+    grpc_connectivity_state state = sd->connectivity_state();
+    subchannels_.push_back({sd->subchannel()->Ref(), state});
+    if (state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+        state == GRPC_CHANNEL_SHUTDOWN) {
+      failover = true;
+    }
+  }
+  if (failover) {
+    for (size_t i = 0; i < ring_->size(); ++i) {
+      if (subchannels_[ring_->entry(i).index].connectivity_state ==
+          GRPC_CHANNEL_READY) {
+        ready_points_.push_back(static_cast<uint32_t>(i));
+      }
+    }
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO,
+            "[RH %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " subchannels on a ring of %" PRIuPTR " points",
+            parent_, this, subchannel_list, subchannels_.size(),
+            ring_->size());
+  }
+}
+
+uint32_t RingHash::Picker::RequestHash(const PickArgs& args) const {
+  absl::string_view key;
+  if (!config_->hash_header().empty()) {
+    for (const auto& p : *args.initial_metadata) {
+      if (p.first == config_->hash_header()) {
+        key = p.second;
+        break;
+      }
+    }
+  } else {
+    key = args.call_state->ExperimentalGetCallAttribute(
+        kRequestRingHashAttribute);
+  }
+  if (key.data() == nullptr) {
+    // No key: any point of the ring will do.
+    return RandomHash();
+  }
+  return gpr_murmur_hash3(key.data(), key.size(), 0);
+}
+
+RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
+  PickResult result;
+  const size_t start = ring_->Find(RequestHash(args));
+  const SubchannelEntry& owner = subchannels_[ring_->entry(start).index];
+  switch (owner.connectivity_state) {
+    case GRPC_CHANNEL_READY:
+      result.type = PickResult::PICK_COMPLETE;
+      result.subchannel = owner.subchannel;
+      return result;
+    case GRPC_CHANNEL_IDLE:
+    case GRPC_CHANNEL_CONNECTING:
+      // Wait for the address that owns the key rather than send the call
+      // elsewhere.
+      result.type = PickResult::PICK_QUEUE;
+      return result;
+    default:
+      break;
+  }
+  // Fail over to the next READY address on the ring.
+  if (!ready_points_.empty()) {
+    auto it = std::upper_bound(ready_points_.begin(), ready_points_.end(),
+                               static_cast<uint32_t>(start));
+    if (it == ready_points_.end()) it = ready_points_.begin();
+    const SubchannelEntry& next = subchannels_[ring_->entry(*it).index];
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+      gpr_log(GPR_INFO,
+              "[RH %p picker %p] subchannel %p failed, picking %p after "
+              "%" PRIuPTR " points",
+              parent_, this, owner.subchannel.get(), next.subchannel.get(),
+              (*it + ring_->size() - start) % ring_->size());
+    }
+    result.type = PickResult::PICK_COMPLETE;
+    result.subchannel = next.subchannel;
+    return result;
+  }
+  result.type = PickResult::PICK_FAILED;
+  result.error =
+      grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                             "ring_hash: no READY subchannel on the ring"),
+                         GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+  return result;
+}
+
+//
+// RingHash
+//
+
+RingHash::RingHash(Args args) : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] Created", this);
+  }
+}
+
+RingHash::~RingHash() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] Destroying Ring Hash policy", this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void RingHash::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void RingHash::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+RingHash::RingHashSubchannelList::RingHashSubchannelList(
+    RingHash* policy, TraceFlag* tracer, ServerAddressList addresses,
+    const grpc_channel_args& args, const RingHashSubchannelList* previous)
+    : SubchannelList(policy, tracer, std::move(addresses),
+                     policy->channel_control_helper(), args) {
+  // Need to maintain a ref to the LB policy as long as we maintain
+  // any references to subchannels, since the subchannels'
+  // pollset_sets will include the LB policy's pollset_set.
+  policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+  // Addresses for which no subchannel could be created are not in the list,
+  // so the ring is built from the list rather than from the addresses.
+  std::vector<std::string> keys;
+  keys.reserve(num_subchannels());
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    keys.push_back(subchannel(i)->key());
+  }
+  ring_ = MakeRefCounted<RingHashRing>(
+      std::move(keys), policy->config_->min_ring_size(),
+      policy->config_->max_ring_size(),
+      previous != nullptr ? previous->ring_.get() : nullptr);
+}
+
+void RingHash::RingHashSubchannelList::StartWatchingLocked() {
+  if (num_subchannels() == 0) return;
+  // Check current state of each subchannel synchronously, since any
+  // subchannel already used by some other channel may have a non-IDLE
+  // state.
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    grpc_connectivity_state state =
+        subchannel(i)->CheckConnectivityStateLocked();
+    if (state != GRPC_CHANNEL_IDLE) {
+      subchannel(i)->UpdateConnectivityStateLocked(state);
+    }
+  }
+  // Start connectivity watch for each subchannel.
+  for (size_t i = 0; i < num_subchannels(); i++) {
+    if (subchannel(i)->subchannel() != nullptr) {
+      subchannel(i)->StartConnectivityWatchLocked();
+      subchannel(i)->subchannel()->AttemptToConnect();
+    }
+  }
+  // Now set the LB policy's state based on the subchannels' states.
+  UpdateRingHashStateFromSubchannelStateCountsLocked();
+}
+
+void RingHash::RingHashSubchannelList::UpdateStateCountersLocked(
+    grpc_connectivity_state old_state, grpc_connectivity_state new_state) {
+  GPR_ASSERT(old_state != GRPC_CHANNEL_SHUTDOWN);
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (old_state == GRPC_CHANNEL_READY) {
+    GPR_ASSERT(num_ready_ > 0);
+    --num_ready_;
+  } else if (old_state == GRPC_CHANNEL_CONNECTING) {
+    GPR_ASSERT(num_connecting_ > 0);
+    --num_connecting_;
+  } else if (old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    GPR_ASSERT(num_transient_failure_ > 0);
+    --num_transient_failure_;
+  }
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+// Sets the policy's connectivity state and generates a new picker based
+// on the current subchannel list. A new picker is made on every change, so
+// that queued picks are retried once the subchannel they wait for is READY.
+void RingHash::RingHashSubchannelList::
+    MaybeUpdateRingHashConnectivityStateLocked() {
+  RingHash* p = static_cast<RingHash*>(policy());
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  // Same rules as round_robin: READY if any subchannel is READY, else
+  // CONNECTING if any is CONNECTING, else TRANSIENT_FAILURE if all are.
+  if (num_ready_ > 0) {
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_READY, absl::Status(), absl::make_unique<Picker>(p, this));
+  } else if (num_connecting_ > 0) {
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    grpc_error* error =
+        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                               "connections to all backends failing"),
+                           GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, grpc_error_to_absl_status(error),
+        absl::make_unique<TransientFailurePicker>(error));
+  }
+}
+
+void RingHash::RingHashSubchannelList::
+    UpdateRingHashStateFromSubchannelStateCountsLocked() {
+  RingHash* p = static_cast<RingHash*>(policy());
+  if (num_ready_ > 0) {
+    if (p->subchannel_list_.get() != this) {
+      // Promote this list to p->subchannel_list_.
+      // This list must be p->latest_pending_subchannel_list_, because
+      // any previous update would have been shut down already and
+      // therefore we would not be receiving a notification for them.
+      GPR_ASSERT(p->latest_pending_subchannel_list_.get() == this);
+      GPR_ASSERT(!shutting_down());
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+        const size_t old_num_subchannels =
+            p->subchannel_list_ != nullptr
+                ? p->subchannel_list_->num_subchannels()
+                : 0;
+        gpr_log(GPR_INFO,
+                "[RH %p] phasing out subchannel list %p (size %" PRIuPTR
+                ") in favor of %p (size %" PRIuPTR ")",
+                p, p->subchannel_list_.get(), old_num_subchannels, this,
+                num_subchannels());
+      }
+      p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+    }
+  }
+  // Update the policy's connectivity state if needed.
+  MaybeUpdateRingHashConnectivityStateLocked();
+}
+
+void RingHash::RingHashSubchannelData::UpdateConnectivityStateLocked(
+    grpc_connectivity_state connectivity_state) {
+  RingHash* p = static_cast<RingHash*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[RH %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        ConnectivityStateName(last_connectivity_state_),
+        ConnectivityStateName(connectivity_state));
+  }
+  // Decide what state to report for aggregation purposes.
+  // If we haven't seen a failure since the last time we were in state
+  // READY, then we report the state change as-is.  However, once we do see
+  // a failure, we report TRANSIENT_FAILURE and do not report any subsequent
+  // state changes until we go back into state READY.
+  if (!seen_failure_since_ready_) {
+    if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      seen_failure_since_ready_ = true;
+    }
+    subchannel_list()->UpdateStateCountersLocked(last_connectivity_state_,
+                                                 connectivity_state);
+  } else {
+    if (connectivity_state == GRPC_CHANNEL_READY) {
+      seen_failure_since_ready_ = false;
+      subchannel_list()->UpdateStateCountersLocked(
+          GRPC_CHANNEL_TRANSIENT_FAILURE, connectivity_state);
+    }
+  }
+  // Record last seen connectivity state.
+  last_connectivity_state_ = connectivity_state;
+}
+
+void RingHash::RingHashSubchannelData::ProcessConnectivityChangeLocked(
+    grpc_connectivity_state connectivity_state) {
+  RingHash* p = static_cast<RingHash*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If the new state is TRANSIENT_FAILURE, re-resolve and attempt to
+  // reconnect. Only done once watching, for the same reason as in
+  // round_robin.
+  if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+      gpr_log(GPR_INFO,
+              "[RH %p] Subchannel %p has gone into TRANSIENT_FAILURE. "
+              "Requesting re-resolution",
+              p, subchannel());
+    }
+    p->channel_control_helper()->RequestReresolution();
+    subchannel()->AttemptToConnect();
+  }
+  // Update state counters.
+  UpdateConnectivityStateLocked(connectivity_state);
+  // Update overall state and renew notification.
+  subchannel_list()->UpdateRingHashStateFromSubchannelStateCountsLocked();
+}
+
+void RingHash::UpdateLocked(UpdateArgs args) {
+  config_ = std::move(args.config);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] received update with %" PRIuPTR " addresses",
+            this, args.addresses.size());
+  }
+  // The new ring reuses the points of the most recent one.
+  const RingHashSubchannelList* previous =
+      latest_pending_subchannel_list_ != nullptr
+          ? latest_pending_subchannel_list_.get()
+          : subchannel_list_.get();
+  auto subchannel_list = MakeOrphanable<RingHashSubchannelList>(
+      this, &grpc_lb_ring_hash_trace, std::move(args.addresses), *args.args,
+      previous);
+  // Replace latest_pending_subchannel_list_.
+  if (latest_pending_subchannel_list_ != nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+      gpr_log(GPR_INFO,
+              "[RH %p] Shutting down previous pending subchannel list %p", this,
+              latest_pending_subchannel_list_.get());
+    }
+  }
+  latest_pending_subchannel_list_ = std::move(subchannel_list);
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    // If the new list is empty, immediately promote the new list to the
+    // current list and transition to TRANSIENT_FAILURE.
+    grpc_error* error =
+        grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING("Empty update"),
+                           GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, grpc_error_to_absl_status(error),
+        absl::make_unique<TransientFailurePicker>(error));
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+  } else if (subchannel_list_ == nullptr) {
+    // If there is no current list, immediately promote the new list to
+    // the current list and start watching it.
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    subchannel_list_->StartWatchingLocked();
+  } else {
+    // Start watching the pending list.  It will get swapped into the
+    // current list when it reports READY.
+    latest_pending_subchannel_list_->StartWatchingLocked();
+  }
+}
+
+//
+// factory
+//
+
+// Parses a ring size field of the config into *size.
+void ParseRingSize(const Json::Object& json, const char* field, size_t* size,
+                   std::vector<grpc_error*>* error_list) {
+  auto it = json.find(field);
+  if (it == json.end()) return;
+  if (it->second.type() != Json::Type::NUMBER) {
+    error_list->push_back(GRPC_ERROR_CREATE_FROM_COPIED_STRING(
+        absl::StrCat("field:", field, " error:must be of type number")
+            .c_str()));
+    return;
+  }
+  int value = gpr_parse_nonnegative_int(it->second.string_value().c_str());
+  if (value <= 0 || static_cast<size_t>(value) > kMaxRingSize) {
+    error_list->push_back(GRPC_ERROR_CREATE_FROM_COPIED_STRING(
+        absl::StrCat("field:", field, " error:must be in [1, ", kMaxRingSize,
+                     "]")
+            .c_str()));
+    return;
+  }
+  *size = static_cast<size_t>(value);
+}
+
+class RingHashFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<RingHash>(std::move(args));
+  }
+
+  const char* name() const override { return kRingHash; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const Json& json, grpc_error** error) const override {
+    GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+    size_t min_ring_size = kDefaultMinRingSize;
+    size_t max_ring_size = kMaxRingSize;
+    std::string hash_header;
+    // ring_hash may be mentioned as a policy in the deprecated
+    // loadBalancingPolicy field, with no config.
+    if (json.type() == Json::Type::JSON_NULL) {
+      return MakeRefCounted<RingHashLbConfig>(min_ring_size, max_ring_size,
+                                              std::move(hash_header));
+    }
+    std::vector<grpc_error*> error_list;
+    ParseRingSize(json.object_value(), "minRingSize", &min_ring_size,
+                  &error_list);
+    ParseRingSize(json.object_value(), "maxRingSize", &max_ring_size,
+                  &error_list);
+    if (min_ring_size > max_ring_size) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:minRingSize error:greater than maxRingSize"));
+    }
+    auto it = json.object_value().find("hashHeader");
+    if (it != json.object_value().end()) {
+      if (it->second.type() != Json::Type::STRING) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:hashHeader error:must be of type string"));
+      } else if (it->second.string_value().empty()) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:hashHeader error:must not be empty"));
+      } else {
+        // Metadata keys are lowercase.
+        hash_header = absl::AsciiStrToLower(it->second.string_value());
+      }
+    }
+    if (!error_list.empty()) {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR("ring_hash_experimental LB policy "
+                                             "config",
+                                             &error_list);
+      return nullptr;
+    }
+    return MakeRefCounted<RingHashLbConfig>(min_ring_size, max_ring_size,
+                                            std::move(hash_header));
+  }
+};
+
+}  // namespace
+
+}  // namespace grpc_core
+
+void grpc_lb_policy_ring_hash_init() {
+  gpr_tls_init(&grpc_core::g_random_hash_state);
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          absl::make_unique<grpc_core::RingHashFactory>());
+}
+
+void grpc_lb_policy_ring_hash_shutdown() {
+  gpr_tls_destroy(&grpc_core::g_random_hash_state);
+}
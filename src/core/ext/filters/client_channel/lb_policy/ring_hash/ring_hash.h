@@ -0,0 +1,76 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_RING_HASH_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_RING_HASH_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "src/core/lib/gprpp/ref_counted.h"
+
+namespace grpc_core {
+
+// Call attribute holding the request key the ring_hash policy hashes, when
+// its config does not name a header to hash.
+extern const char* kRequestRingHashAttribute;
+
+// A consistent hashing ring, in the manner of ketama: each address owns
+// points_per_address() points, placed on a ring of 32-bit hashes by hashing
+// its key, and a request hash maps to the address owning the first point at
+// or after it. Immutable once built, so that pickers can share it.
+class RingHashRing : public RefCounted<RingHashRing> {
+ public:
+  struct Entry {
+    uint32_t hash;
+    // Index of the address in keys()
+    uint32_t index;
+  };
+
+  // Builds the ring of the addresses \a keys, with between \a min_ring_size
+  // and \a max_ring_size points (at least one per address). If \a previous
+  // is not null and has as many points per address as fit the new ring, its
+  // points are reused for the keys it has, so that only the points of new
+  // addresses are computed.
+  RingHashRing(std::vector<std::string> keys, size_t min_ring_size,
+               size_t max_ring_size, const RingHashRing* previous);
+
+  // Returns the position in the ring of the first point at or after \a hash,
+  // wrapping around. The ring must not be empty.
+  size_t Find(uint32_t hash) const;
+
+  const Entry& entry(size_t position) const { return ring_[position]; }
+  size_t size() const { return ring_.size(); }
+  size_t points_per_address() const { return points_per_address_; }
+  const std::vector<std::string>& keys() const { return keys_; }
+
+ private:
+  std::vector<std::string> keys_;
+  size_t points_per_address_ = 0;
+  // Sorted by hash, then index
+  std::vector<Entry> ring_;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_RING_HASH_H \
+        */
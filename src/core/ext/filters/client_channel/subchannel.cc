@@ -86,14 +86,16 @@ DebugOnlyTraceFlag grpc_trace_subchannel_refcount(false, "subchannel_refcount");
 
 ConnectedSubchannel::ConnectedSubchannel(
     grpc_channel_stack* channel_stack, const grpc_channel_args* args,
-    RefCountedPtr<channelz::SubchannelNode> channelz_subchannel)
+    RefCountedPtr<channelz::SubchannelNode> channelz_subchannel,
+    RefCountedPtr<SubchannelConnectionPool> pool)
     : RefCounted<ConnectedSubchannel>(
           GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel_refcount)
               ? "ConnectedSubchannel"
               : nullptr),
       channel_stack_(channel_stack),
       args_(grpc_channel_args_copy(args)),
-      channelz_subchannel_(std::move(channelz_subchannel)) {}
+      channelz_subchannel_(std::move(channelz_subchannel)),
+      pool_(std::move(pool)) {}
 
 ConnectedSubchannel::~ConnectedSubchannel() {
   grpc_channel_args_destroy(args_);
@@ -126,21 +128,148 @@ size_t ConnectedSubchannel::GetInitialCallSizeEstimate() const {
          channel_stack_->call_stack_size;
 }
 
+//
+// SubchannelConnectionPool
+//
+
+SubchannelConnectionPool::SubchannelConnectionPool(
+    Subchannel* subchannel, size_t max_connections,
+    size_t max_calls_per_connection)
+    : RefCounted<SubchannelConnectionPool>(
+          GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel_refcount)
+              ? "SubchannelConnectionPool"
+              : nullptr),
+      subchannel_(GRPC_SUBCHANNEL_WEAK_REF(subchannel, "connection_pool")),
+      max_connections_(max_connections),
+      max_calls_per_connection_(max_calls_per_connection) {}
+
+SubchannelConnectionPool::~SubchannelConnectionPool() {
+  GRPC_SUBCHANNEL_WEAK_UNREF(subchannel_, "connection_pool");
+}
+
+RefCountedPtr<ConnectedSubchannel> SubchannelConnectionPool::StartCall(
+    RefCountedPtr<ConnectedSubchannel> primary) {
+  bool grow = false;
+  {
+    MutexLock lock(&mu_);
+    size_t* least_calls = &primary_calls_;
+    Connection* least_loaded = nullptr;
+    for (Connection& connection : connections_) {
+      if (connection.calls < *least_calls) {
+        least_calls = &connection.calls;
+        least_loaded = &connection;
+      }
+    }
+    if (*least_calls >= max_calls_per_connection_ && !shutdown_ &&
+        !connecting_ && connections_.size() + 1 < max_connections_ &&
+        ExecCtx::Get()->Now() >= next_attempt_time_) {
+      connecting_ = true;
+      grow = true;
+    }
+    ++*least_calls;
+    if (least_loaded != nullptr) primary = least_loaded->connected_subchannel;
+  }
+  // The subchannel's lock is taken before ours, never after.
+  if (grow) subchannel_->StartPoolConnecting(Ref());
+  return primary;
+}
+
+void SubchannelConnectionPool::FinishCall(
+    const ConnectedSubchannel* connected_subchannel) {
+  RefCountedPtr<ConnectedSubchannel> idle;
+  {
+    MutexLock lock(&mu_);
+    if (connected_subchannel->pool() == this) {
+      --primary_calls_;
+      return;
+    }
+    auto it = std::find_if(connections_.begin(), connections_.end(),
+                           [connected_subchannel](const Connection& c) {
+                             return c.connected_subchannel.get() ==
+                                    connected_subchannel;
+                           });
+    // The connection may have been removed from the pool since.
+    if (it == connections_.end()) return;
+    if (--it->calls > 0) return;
+    // Close the connection if the remaining ones are at most half loaded,
+    // so that a load around the threshold does not keep reconnecting.
+    size_t other_calls = primary_calls_;
+    for (const Connection& connection : connections_) {
+      other_calls += connection.calls;
+    }
+    if (other_calls * 2 > connections_.size() * max_calls_per_connection_) {
+      return;
+    }
+    idle = std::move(it->connected_subchannel);
+    connections_.erase(it);
+  }
+  if (grpc_trace_subchannel.enabled()) {
+    gpr_log(GPR_INFO, "Connection pool %p: closing idle connection %p", this,
+            idle.get());
+  }
+}
+
+void SubchannelConnectionPool::ConnectionAttemptDone(
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel) {
+  MutexLock lock(&mu_);
+  connecting_ = false;
+  if (connected_subchannel == nullptr) {
+    next_attempt_time_ =
+        ExecCtx::Get()->Now() +
+        GRPC_SUBCHANNEL_INITIAL_CONNECT_BACKOFF_SECONDS * GPR_MS_PER_SEC;
+    return;
+  }
+  if (shutdown_) return;
+  connections_.push_back({std::move(connected_subchannel), 0});
+}
+
+void SubchannelConnectionPool::RemoveConnection(
+    const ConnectedSubchannel* connected_subchannel) {
+  // Released after the lock, as it may hold the last ref to the pool.
+  RefCountedPtr<ConnectedSubchannel> removed;
+  MutexLock lock(&mu_);
+  for (auto it = connections_.begin(); it != connections_.end(); ++it) {
+    if (it->connected_subchannel.get() == connected_subchannel) {
+      removed = std::move(it->connected_subchannel);
+      connections_.erase(it);
+      break;
+    }
+  }
+}
+
+void SubchannelConnectionPool::Shutdown() {
+  // Released after the lock, as they may hold the last ref to the pool.
+  std::vector<Connection> connections;
+  MutexLock lock(&mu_);
+  shutdown_ = true;
+  connections_.swap(connections);
+}
+
 //
 // SubchannelCall
 //
 
 RefCountedPtr<SubchannelCall> SubchannelCall::Create(Args args,
                                                      grpc_error** error) {
+  RefCountedPtr<SubchannelConnectionPool> pool;
+  if (args.connected_subchannel->pool() != nullptr) {
+    pool = args.connected_subchannel->pool()->Ref();
+    args.connected_subchannel =
+        pool->StartCall(std::move(args.connected_subchannel));
+  }
   const size_t allocation_size =
       args.connected_subchannel->GetInitialCallSizeEstimate();
   Arena* arena = args.arena;
-  return RefCountedPtr<SubchannelCall>(new (
-      arena->Alloc(allocation_size)) SubchannelCall(std::move(args), error));
+  return RefCountedPtr<SubchannelCall>(
+      new (arena->Alloc(allocation_size))
+          SubchannelCall(std::move(args), std::move(pool), error));
 }
 
-SubchannelCall::SubchannelCall(Args args, grpc_error** error)
+SubchannelCall::SubchannelCall(Args args,
+                               RefCountedPtr<SubchannelConnectionPool> pool,
+                               grpc_error** error)
     : connected_subchannel_(std::move(args.connected_subchannel)),
+      pool_(std::move(pool)),
       deadline_(args.deadline) {
   grpc_call_stack* callstk = SUBCHANNEL_CALL_TO_CALL_STACK(this);
   const grpc_call_element_args call_args = {
@@ -214,6 +343,9 @@ void SubchannelCall::Destroy(void* arg, grpc_error* /*error*/) {
   grpc_closure* after_call_stack_destroy = self->after_call_stack_destroy_;
   RefCountedPtr<ConnectedSubchannel> connected_subchannel =
       std::move(self->connected_subchannel_);
+  if (self->pool_ != nullptr) {
+    self->pool_->FinishCall(connected_subchannel.get());
+  }
   // Destroy the subchannel call.
   self->~SubchannelCall();
   // Destroy the call stack. This should be after destroying the subchannel
@@ -329,7 +461,7 @@ class Subchannel::ConnectedSubchannelStateWatcher
                     c->connected_subchannel_.get(), c,
                     ConnectivityStateName(new_state));
           }
-          c->connected_subchannel_.reset();
+          c->ResetConnectedSubchannelLocked();
           if (c->channelz_node() != nullptr) {
             c->channelz_node()->SetChildSocket(nullptr);
           }
@@ -360,6 +492,38 @@ class Subchannel::ConnectedSubchannelStateWatcher
   Subchannel* subchannel_;
 };
 
+//
+// Subchannel::PooledConnectionStateWatcher
+//
+
+// Removes a connection of a pool from it when the connection fails.
+class Subchannel::PooledConnectionStateWatcher
+    : public AsyncConnectivityStateWatcherInterface {
+ public:
+  PooledConnectionStateWatcher(RefCountedPtr<SubchannelConnectionPool> pool,
+                               const ConnectedSubchannel* connected_subchannel)
+      : pool_(std::move(pool)), connected_subchannel_(connected_subchannel) {}
+
+ private:
+  void OnConnectivityStateChange(grpc_connectivity_state new_state,
+                                 const absl::Status& /*status*/) override {
+    if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+        new_state == GRPC_CHANNEL_SHUTDOWN) {
+      if (grpc_trace_subchannel.enabled()) {
+        gpr_log(GPR_INFO,
+                "Connection %p of connection pool %p has gone into %s",
+                connected_subchannel_, pool_.get(),
+                ConnectivityStateName(new_state));
+      }
+      pool_->RemoveConnection(connected_subchannel_);
+    }
+  }
+
+  RefCountedPtr<SubchannelConnectionPool> pool_;
+  // Only compared against, as the pool may have released it.
+  const ConnectedSubchannel* connected_subchannel_;
+};
+
 // Asynchronously notifies the \a watcher of a change in the connectvity state
 // of \a subchannel to the current \a state. Deletes itself when done.
 class Subchannel::AsyncWatcherNotifierLocked {
@@ -676,6 +840,10 @@ Subchannel::Subchannel(SubchannelKey* key,
   if (new_args != nullptr) grpc_channel_args_destroy(new_args);
   GRPC_CLOSURE_INIT(&on_connecting_finished_, OnConnectingFinished, this,
                     grpc_schedule_on_exec_ctx);
+  max_connections_ = grpc_channel_args_find_integer(
+      args_, GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS, {1, 1, INT_MAX});
+  max_calls_per_connection_ = grpc_channel_args_find_integer(
+      args_, GRPC_ARG_SUBCHANNEL_MAX_CALLS_PER_CONNECTION, {100, 1, INT_MAX});
   const grpc_arg* arg = grpc_channel_args_find(args_, GRPC_ARG_ENABLE_CHANNELZ);
   const bool channelz_enabled =
       grpc_channel_arg_get_bool(arg, GRPC_ENABLE_CHANNELZ_DEFAULT);
@@ -983,6 +1151,25 @@ void Subchannel::MaybeStartConnectingLocked() {
     // Already connected: don't restart.
     return;
   }
+  if (connecting_pool_ != nullptr) {
+    // The connector is opening a connection for the pool of the connected
+    // subchannel we lost: rather than wait for it to finish (and throw the
+    // connection away), make it our connection attempt.
+    if (grpc_trace_subchannel.enabled()) {
+      gpr_log(GPR_INFO,
+              "Subchannel %p: taking over the connection attempt of pool %p",
+              this, connecting_pool_.get());
+    }
+    connecting_pool_->ConnectionAttemptDone(nullptr);
+    connecting_pool_.reset();
+    connecting_ = true;
+    GRPC_SUBCHANNEL_WEAK_REF(this, "connecting");
+    GRPC_SUBCHANNEL_WEAK_UNREF(this, "pool_connecting");
+    backoff_begun_ = true;
+    next_attempt_deadline_ = backoff_.NextAttemptTime();
+    SetConnectivityStateLocked(GRPC_CHANNEL_CONNECTING, absl::Status());
+    return;
+  }
   connecting_ = true;
   GRPC_SUBCHANNEL_WEAK_REF(this, "connecting");
   if (!backoff_begun_) {
@@ -1051,8 +1238,10 @@ void Subchannel::OnConnectingFinished(void* arg, grpc_error* error) {
   {
     MutexLock lock(&c->mu_);
     c->connecting_ = false;
-    if (c->connecting_result_.transport != nullptr &&
-        c->PublishTransportLocked()) {
+    if (c->connecting_pool_ != nullptr) {
+      c->OnPoolConnectingFinishedLocked(error);
+    } else if (c->connecting_result_.transport != nullptr &&
+               c->PublishTransportLocked()) {
       // Do nothing, transport was published.
     } else if (c->disconnected_) {
       GRPC_SUBCHANNEL_WEAK_UNREF(c, "connecting");
@@ -1077,8 +1266,8 @@ void ConnectionDestroy(void* arg, grpc_error* /*error*/) {
 
 }  // namespace
 
-bool Subchannel::PublishTransportLocked() {
-  // Construct channel stack.
+grpc_channel_stack* Subchannel::CreateChannelStackLocked(
+    RefCountedPtr<channelz::SocketNode>* socket) {
   grpc_channel_stack_builder* builder = grpc_channel_stack_builder_create();
   grpc_channel_stack_builder_set_channel_arguments(
       builder, connecting_result_.channel_args);
@@ -1086,7 +1275,7 @@ bool Subchannel::PublishTransportLocked() {
                                            connecting_result_.transport);
   if (!grpc_channel_init_create_stack(builder, GRPC_CLIENT_SUBCHANNEL)) {
     grpc_channel_stack_builder_destroy(builder);
-    return false;
+    return nullptr;
   }
   grpc_channel_stack* stk;
   grpc_error* error = grpc_channel_stack_builder_finish(
@@ -1097,19 +1286,31 @@ bool Subchannel::PublishTransportLocked() {
     gpr_log(GPR_ERROR, "error initializing subchannel stack: %s",
             grpc_error_string(error));
     GRPC_ERROR_UNREF(error);
-    return false;
+    return nullptr;
   }
-  RefCountedPtr<channelz::SocketNode> socket =
-      std::move(connecting_result_.socket_node);
+  *socket = std::move(connecting_result_.socket_node);
   connecting_result_.Reset();
+  return stk;
+}
+
+bool Subchannel::PublishTransportLocked() {
+  // Construct channel stack.
+  RefCountedPtr<channelz::SocketNode> socket;
+  grpc_channel_stack* stk = CreateChannelStackLocked(&socket);
+  if (stk == nullptr) return false;
   if (disconnected_) {
     grpc_channel_stack_destroy(stk);
     gpr_free(stk);
     return false;
   }
   // Publish.
+  RefCountedPtr<SubchannelConnectionPool> pool;
+  if (max_connections_ > 1) {
+    pool = MakeRefCounted<SubchannelConnectionPool>(this, max_connections_,
+                                                    max_calls_per_connection_);
+  }
   connected_subchannel_.reset(
-      new ConnectedSubchannel(stk, args_, channelz_node_));
+      new ConnectedSubchannel(stk, args_, channelz_node_, std::move(pool)));
   gpr_log(GPR_INFO, "New connected subchannel at %p for subchannel %p",
           connected_subchannel_.get(), this);
   if (channelz_node_ != nullptr) {
@@ -1123,6 +1324,83 @@ bool Subchannel::PublishTransportLocked() {
   return true;
 }
 
+void Subchannel::StartPoolConnecting(
+    RefCountedPtr<SubchannelConnectionPool> pool) {
+  {
+    MutexLock lock(&mu_);
+    // The connector is only free for the pool while the subchannel is
+    // connected.
+    if (!disconnected_ && !connecting_ && connecting_pool_ == nullptr &&
+        connected_subchannel_ != nullptr &&
+        connected_subchannel_->pool() == pool.get()) {
+      if (grpc_trace_subchannel.enabled()) {
+        gpr_log(GPR_INFO,
+                "Subchannel %p: opening another connection for pool %p", this,
+                pool.get());
+      }
+      connecting_pool_ = std::move(pool);
+      GRPC_SUBCHANNEL_WEAK_REF(this, "pool_connecting");
+      SubchannelConnector::Args args;
+      args.interested_parties = pollset_set_;
+      args.deadline = ExecCtx::Get()->Now() + min_connect_timeout_ms_;
+      args.channel_args = args_;
+      connector_->Connect(args, &connecting_result_, &on_connecting_finished_);
+      return;
+    }
+  }
+  pool->ConnectionAttemptDone(nullptr);
+}
+
+void Subchannel::OnPoolConnectingFinishedLocked(grpc_error* error) {
+  RefCountedPtr<SubchannelConnectionPool> pool = std::move(connecting_pool_);
+  RefCountedPtr<ConnectedSubchannel> connected_subchannel;
+  grpc_channel_stack* stk = nullptr;
+  // The channelz node of the subchannel only tracks the socket of its
+  // connected subchannel, not the ones of the pool.
+  RefCountedPtr<channelz::SocketNode> socket;
+  if (connecting_result_.transport != nullptr) {
+    stk = CreateChannelStackLocked(&socket);
+  } else if (grpc_trace_subchannel.enabled()) {
+    gpr_log(GPR_INFO, "Subchannel %p: pool connection failed: %s", this,
+            grpc_error_string(error));
+  }
+  if (stk != nullptr) {
+    // The pool no longer wants it if the subchannel lost the connection the
+    // pool belongs to in the meantime.
+    if (!disconnected_ && connected_subchannel_ != nullptr &&
+        connected_subchannel_->pool() == pool.get()) {
+      connected_subchannel =
+          MakeRefCounted<ConnectedSubchannel>(stk, args_, channelz_node_);
+    } else {
+      grpc_channel_stack_destroy(stk);
+      gpr_free(stk);
+    }
+  }
+  if (connected_subchannel != nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+      gpr_log(GPR_INFO, "New pooled connection at %p for subchannel %p",
+              connected_subchannel.get(), this);
+    }
+    ConnectedSubchannel* connection = connected_subchannel.get();
+    // Add to the pool before watching, so that a failure is seen after.
+    pool->ConnectionAttemptDone(std::move(connected_subchannel));
+    connection->StartWatch(pollset_set_,
+                           MakeOrphanable<PooledConnectionStateWatcher>(
+                               std::move(pool), connection));
+  } else {
+    pool->ConnectionAttemptDone(nullptr);
+  }
+  GRPC_SUBCHANNEL_WEAK_UNREF(this, "pool_connecting");
+}
+
+void Subchannel::ResetConnectedSubchannelLocked() {
+  if (connected_subchannel_ == nullptr) return;
+  if (connected_subchannel_->pool() != nullptr) {
+    connected_subchannel_->pool()->Shutdown();
+  }
+  connected_subchannel_.reset();
+}
+
 void Subchannel::Disconnect() {
   // The subchannel_pool is only used once here in this subchannel, so the
   // access can be outside of the lock.
@@ -1134,7 +1412,7 @@ void Subchannel::Disconnect() {
   GPR_ASSERT(!disconnected_);
   disconnected_ = true;
   connector_.reset();
-  connected_subchannel_.reset();
+  ResetConnectedSubchannelLocked();
   health_watcher_map_.ShutdownLocked();
 }
 
@@ -22,6 +22,7 @@
 #include <grpc/support/port_platform.h>
 
 #include <deque>
+#include <vector>
 
 #include "src/core/ext/filters/client_channel/client_channel_channelz.h"
 #include "src/core/ext/filters/client_channel/connector.h"
@@ -68,13 +69,16 @@
 
 namespace grpc_core {
 
+class Subchannel;
 class SubchannelCall;
+class SubchannelConnectionPool;
 
 class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
  public:
   ConnectedSubchannel(
       grpc_channel_stack* channel_stack, const grpc_channel_args* args,
-      RefCountedPtr<channelz::SubchannelNode> channelz_subchannel);
+      RefCountedPtr<channelz::SubchannelNode> channelz_subchannel,
+      RefCountedPtr<SubchannelConnectionPool> pool = nullptr);
   ~ConnectedSubchannel() override;
 
   void StartWatch(grpc_pollset_set* interested_parties,
@@ -87,6 +91,8 @@ class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
   channelz::SubchannelNode* channelz_subchannel() const {
     return channelz_subchannel_.get();
   }
+  // The other connections calls on this one are spread over, or null.
+  SubchannelConnectionPool* pool() const { return pool_.get(); }
 
   size_t GetInitialCallSizeEstimate() const;
 
@@ -96,6 +102,57 @@ class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
   // ref counted pointer to the channelz node in this connected subchannel's
   // owning subchannel.
   RefCountedPtr<channelz::SubchannelNode> channelz_subchannel_;
+  RefCountedPtr<SubchannelConnectionPool> pool_;
+};
+
+// The connections a subchannel opens to its address beyond the first one,
+// when GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS allows more than one. The pool is
+// owned by the first connection, which is the one the data plane sees: each
+// call made on it goes to whichever connection has the fewest calls. When
+// they all have max_calls_per_connection calls, the pool asks the subchannel
+// for another connection; an extra connection is closed once it is idle and
+// the others are at most half loaded.
+class SubchannelConnectionPool : public RefCounted<SubchannelConnectionPool> {
+ public:
+  SubchannelConnectionPool(Subchannel* subchannel, size_t max_connections,
+                           size_t max_calls_per_connection);
+  ~SubchannelConnectionPool() override;
+
+  // Returns the connection for a new call, \a primary (the connection that
+  // owns the pool) or one of the pool's, and counts the call on it.
+  RefCountedPtr<ConnectedSubchannel> StartCall(
+      RefCountedPtr<ConnectedSubchannel> primary);
+  // Uncounts a call started on \a connected_subchannel.
+  void FinishCall(const ConnectedSubchannel* connected_subchannel);
+
+  // Called by the subchannel when the connection attempt StartCall() asked
+  // for is done, with the new connection or null if it failed.
+  void ConnectionAttemptDone(
+      RefCountedPtr<ConnectedSubchannel> connected_subchannel);
+  // Called by the subchannel when a connection of the pool fails.
+  void RemoveConnection(const ConnectedSubchannel* connected_subchannel);
+  // Called by the subchannel when the primary connection goes away: closes
+  // the pool's connections and stops opening new ones.
+  void Shutdown();
+
+ private:
+  struct Connection {
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel;
+    size_t calls;
+  };
+
+  // Weak ref.
+  Subchannel* subchannel_;
+  const size_t max_connections_;
+  const size_t max_calls_per_connection_;
+  Mutex mu_;
+  size_t primary_calls_ = 0;
+  std::vector<Connection> connections_;
+  // A connection attempt is in progress.
+  bool connecting_ = false;
+  // No connection attempt before that time, after one failed.
+  grpc_millis next_attempt_time_ = 0;
+  bool shutdown_ = false;
 };
 
 // Implements the interface of RefCounted<>.
@@ -137,7 +194,8 @@ class SubchannelCall {
   template <typename T>
   friend class RefCountedPtr;
 
-  SubchannelCall(Args args, grpc_error** error);
+  SubchannelCall(Args args, RefCountedPtr<SubchannelConnectionPool> pool,
+                 grpc_error** error);
 
   // If channelz is enabled, intercepts recv_trailing so that we may check the
   // status and associate it to a subchannel.
@@ -153,6 +211,8 @@ class SubchannelCall {
   static void Destroy(void* arg, grpc_error* error);
 
   RefCountedPtr<ConnectedSubchannel> connected_subchannel_;
+  // The pool connected_subchannel_ was picked from, or null.
+  RefCountedPtr<SubchannelConnectionPool> pool_;
   grpc_closure* after_call_stack_destroy_ = nullptr;
   // State needed to support channelz interception of recv trailing metadata.
   grpc_closure recv_trailing_metadata_ready_;
@@ -354,7 +414,10 @@ class Subchannel {
     std::map<std::string, OrphanablePtr<HealthWatcher>> map_;
   };
 
+  friend class SubchannelConnectionPool;
+
   class ConnectedSubchannelStateWatcher;
+  class PooledConnectionStateWatcher;
 
   class AsyncWatcherNotifierLocked;
 
@@ -368,6 +431,14 @@ class Subchannel {
   void ContinueConnectingLocked();
   static void OnConnectingFinished(void* arg, grpc_error* error);
   bool PublishTransportLocked();
+  grpc_channel_stack* CreateChannelStackLocked(
+      RefCountedPtr<channelz::SocketNode>* socket);
+  // Opens another connection for \a pool, which must be the one of the
+  // current connected subchannel.
+  void StartPoolConnecting(RefCountedPtr<SubchannelConnectionPool> pool);
+  void OnPoolConnectingFinishedLocked(grpc_error* error);
+  // Drops the connected subchannel, along with the connections of its pool.
+  void ResetConnectedSubchannelLocked();
   void Disconnect();
 
   gpr_atm RefMutate(gpr_atm delta,
@@ -400,6 +471,12 @@ class Subchannel {
   RefCountedPtr<ConnectedSubchannel> connected_subchannel_;
   bool connecting_ = false;
   bool disconnected_ = false;
+  // Connection pool settings, see GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS.
+  size_t max_connections_ = 1;
+  size_t max_calls_per_connection_ = 100;
+  // The connector is opening a connection for this pool rather than the
+  // connected subchannel.
+  RefCountedPtr<SubchannelConnectionPool> connecting_pool_;
 
   // Connectivity state tracking.
   grpc_connectivity_state state_ = GRPC_CHANNEL_IDLE;
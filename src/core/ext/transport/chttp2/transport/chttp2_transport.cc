@@ -104,6 +104,8 @@ static void write_action_begin_locked(void* t, grpc_error* error);
 static void write_action(void* t, grpc_error* error);
 static void write_action_end(void* t, grpc_error* error);
 static void write_action_end_locked(void* t, grpc_error* error);
+static void write_coalescing_timer_expired(void* t, grpc_error* error);
+static void write_coalescing_timer_expired_locked(void* t, grpc_error* error);
 
 static void read_action(void* t, grpc_error* error);
 static void read_action_locked(void* t, grpc_error* error);
@@ -283,6 +285,33 @@ static bool read_channel_args(grpc_chttp2_transport* t,
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_HTTP2_BDP_PROBE)) {
       enable_bdp = grpc_channel_arg_get_bool(&channel_args->args[i], true);
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_FLOW_CONTROL_POLICY)) {
+      const char* policy = grpc_channel_arg_get_string(&channel_args->args[i]);
+      if (policy == nullptr || 0 == strcmp(policy, "pid")) {
+        t->flow_control_policy =
+            grpc_core::chttp2::TargetWindowPolicy::Type::kPid;
+      } else if (0 == strcmp(policy, "bbr")) {
+        t->flow_control_policy =
+            grpc_core::chttp2::TargetWindowPolicy::Type::kBbr;
+      } else {
+        gpr_log(GPR_ERROR, "%s: unknown flow control policy '%s', using pid",
+                GRPC_ARG_HTTP2_FLOW_CONTROL_POLICY, policy);
+      }
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_SCHEDULER)) {
+      const char* scheduler =
+          grpc_channel_arg_get_string(&channel_args->args[i]);
+      if (scheduler == nullptr || 0 == strcmp(scheduler, "fifo")) {
+        t->write_scheduler_type =
+            grpc_core::chttp2::WriteScheduler::Type::kFifo;
+      } else if (0 == strcmp(scheduler, "wfq")) {
+        t->write_scheduler_type =
+            grpc_core::chttp2::WriteScheduler::Type::kWeightedFair;
+      } else {
+        gpr_log(GPR_ERROR, "%s: unknown write scheduler '%s', using fifo",
+                GRPC_ARG_HTTP2_WRITE_SCHEDULER, scheduler);
+      }
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_KEEPALIVE_TIME_MS)) {
       const int value = grpc_channel_arg_get_integer(
@@ -312,6 +341,20 @@ static bool read_channel_args(grpc_chttp2_transport* t,
                strcmp(channel_args->args[i].key, GRPC_ARG_ENABLE_CHANNELZ)) {
       channelz_enabled = grpc_channel_arg_get_bool(
           &channel_args->args[i], GRPC_ENABLE_CHANNELZ_DEFAULT);
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_IDLE_READ_BUFFER_RELEASE_MS)) {
+      t->release_idle_buffers =
+          grpc_channel_arg_get_integer(&channel_args->args[i],
+                                       {-1, -1, INT_MAX}) >= 0;
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_MS)) {
+      t->write_coalescing_delay = grpc_channel_arg_get_integer(
+          &channel_args->args[i], {0, 0, INT_MAX});
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES)) {
+      t->write_coalescing_bytes =
+          static_cast<uint32_t>(grpc_channel_arg_get_integer(
+              &channel_args->args[i], {65536, 0, INT_MAX}));
     } else {
       static const struct {
         const char* channel_arg_name;
@@ -479,12 +522,14 @@ grpc_chttp2_transport::grpc_chttp2_transport(
   }
 
   if (g_flow_control_enabled) {
-    flow_control.Init<grpc_core::chttp2::TransportFlowControl>(this,
-                                                               enable_bdp);
+    flow_control.Init<grpc_core::chttp2::TransportFlowControl>(
+        this, enable_bdp, flow_control_policy);
   } else {
     flow_control.Init<grpc_core::chttp2::TransportFlowControlDisabled>(this);
     enable_bdp = false;
   }
+  write_scheduler =
+      grpc_core::chttp2::WriteScheduler::Create(write_scheduler_type);
 
   // No pings allowed before receiving a header or data frame.
   ping_state.pings_before_data_required = 0;
@@ -533,6 +578,10 @@ static void close_transport_locked(grpc_chttp2_transport* t,
                                  GRPC_STATUS_UNAVAILABLE);
     }
     if (t->write_state != GRPC_CHTTP2_WRITE_STATE_IDLE) {
+      // Don't hold a coalesced write back: the close waits for it.
+      if (t->write_coalescing_pending) {
+        grpc_timer_cancel(&t->write_coalescing_timer);
+      }
       if (t->close_transport_on_writes_finished == nullptr) {
         t->close_transport_on_writes_finished =
             GRPC_ERROR_CREATE_FROM_STATIC_STRING(
@@ -862,16 +911,59 @@ static void inc_initiate_write_reason(
   }
 }
 
+// Can a write initiated for this reason wait for write coalescing? Only writes
+// carrying application data may be delayed: control frames (pings, settings,
+// window updates, resets) are latency sensitive for the peer.
+static bool write_may_be_coalesced(grpc_chttp2_initiate_write_reason reason) {
+  switch (reason) {
+    case GRPC_CHTTP2_INITIATE_WRITE_START_NEW_STREAM:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_MESSAGE:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_INITIAL_METADATA:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_TRAILING_METADATA:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static bool write_coalescing_budget_left(
+    grpc_chttp2_transport* t, grpc_chttp2_initiate_write_reason reason) {
+  return t->write_coalescing_delay > 0 && write_may_be_coalesced(reason) &&
+         t->bytes_in_next_write < t->write_coalescing_bytes;
+}
+
 void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
                                 grpc_chttp2_initiate_write_reason reason) {
   GPR_TIMER_SCOPE("grpc_chttp2_initiate_write", 0);
 
+  t->write_requests_in_next_write++;
+  if (t->write_coalescing_pending &&
+      !write_coalescing_budget_left(t, reason)) {
+    // Start the delayed write now: cancelling the timer runs its callback.
+    grpc_timer_cancel(&t->write_coalescing_timer);
+  }
+
   switch (t->write_state) {
     case GRPC_CHTTP2_WRITE_STATE_IDLE:
       inc_initiate_write_reason(reason);
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING,
                       grpc_chttp2_initiate_write_reason_string(reason));
       GRPC_CHTTP2_REF_TRANSPORT(t, "writing");
+      if (write_coalescing_budget_left(t, reason)) {
+        // Give other streams (and later ops on this one) the latency budget
+        // to add their frames to this write before it is gathered. The write
+        // stays in the WRITING state meanwhile, so nothing else starts it.
+        GRPC_STATS_INC_HTTP2_WRITES_COALESCED();
+        t->write_coalescing_pending = true;
+        GRPC_CLOSURE_INIT(&t->write_coalescing_timer_expired,
+                          write_coalescing_timer_expired, t,
+                          grpc_schedule_on_exec_ctx);
+        grpc_timer_init(
+            &t->write_coalescing_timer,
+            grpc_core::ExecCtx::Get()->Now() + t->write_coalescing_delay,
+            &t->write_coalescing_timer_expired);
+        break;
+      }
       // Note that the 'write_action_begin_locked' closure is being scheduled
       // on the 'finally_scheduler' of t->combiner. This means that
       // 'write_action_begin_locked' is called only *after* all the other
@@ -918,6 +1010,24 @@ static const char* begin_writing_desc(bool partial) {
   }
 }
 
+static void write_coalescing_timer_expired(void* gt, grpc_error* error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
+  t->combiner->Run(
+      GRPC_CLOSURE_INIT(&t->write_coalescing_timer_expired_locked,
+                        write_coalescing_timer_expired_locked, t, nullptr),
+      GRPC_ERROR_REF(error));
+}
+
+// Runs the write delayed by grpc_chttp2_initiate_write, whether the latency
+// budget ran out or the timer was cancelled to start the write early.
+static void write_coalescing_timer_expired_locked(void* gt,
+                                                  grpc_error* /*error*/) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
+  GPR_ASSERT(t->write_coalescing_pending);
+  t->write_coalescing_pending = false;
+  write_action_begin_locked(t, GRPC_ERROR_NONE);
+}
+
 static void write_action_begin_locked(void* gt, grpc_error* /*error_ignored*/) {
   GPR_TIMER_SCOPE("write_action_begin_locked", 0);
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
@@ -932,6 +1042,11 @@ static void write_action_begin_locked(void* gt, grpc_error* /*error_ignored*/) {
     if (r.partial) {
       GRPC_STATS_INC_HTTP2_PARTIAL_WRITES();
     }
+    GRPC_STATS_INC_HTTP2_WRITE_BATCH_SIZE(t->outbuf.length);
+    GRPC_STATS_INC_HTTP2_WRITE_REQUESTS_PER_WRITE(
+        t->write_requests_in_next_write);
+    t->write_requests_in_next_write = 0;
+    t->bytes_in_next_write = 0;
     set_write_state(t,
                     r.partial ? GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE
                               : GRPC_CHTTP2_WRITE_STATE_WRITING,
@@ -951,6 +1066,8 @@ static void write_action_begin_locked(void* gt, grpc_error* /*error_ignored*/) {
       continue_read_action_locked(t);
     }
   } else {
+    t->write_requests_in_next_write = 0;
+    t->bytes_in_next_write = 0;
     GRPC_STATS_INC_HTTP2_SPURIOUS_WRITES_BEGUN();
     set_write_state(t, GRPC_CHTTP2_WRITE_STATE_IDLE, "begin writing nothing");
     GRPC_CHTTP2_UNREF_TRANSPORT(t, "writing");
@@ -1227,6 +1344,34 @@ static bool contains_non_ok_status(grpc_metadata_batch* batch) {
   return false;
 }
 
+/* Takes the weight of the stream for the weighted fair write scheduler out of
+   its initial metadata, whichever scheduler the transport uses: it is meant
+   for this transport only, not for the peer */
+static uint32_t take_write_weight(grpc_metadata_batch* batch) {
+  uint32_t weight = 1;
+  grpc_linked_mdelem* l = batch->list.head;
+  while (l != nullptr) {
+    grpc_linked_mdelem* next = l->next;
+    if (grpc_slice_str_cmp(GRPC_MDKEY(l->md), GRPC_HTTP2_WRITE_WEIGHT_MD_KEY) ==
+        0) {
+      const grpc_slice& value = GRPC_MDVALUE(l->md);
+      uint32_t parsed;
+      if (gpr_parse_bytes_to_uint32(
+              reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(value)),
+              GRPC_SLICE_LENGTH(value), &parsed) &&
+          parsed > 0) {
+        weight = parsed;
+        if (weight > grpc_core::chttp2::WriteScheduler::kMaxWeight) {
+          weight = grpc_core::chttp2::WriteScheduler::kMaxWeight;
+        }
+      }
+      grpc_metadata_batch_remove(batch, l);
+    }
+    l = next;
+  }
+  return weight;
+}
+
 static void maybe_become_writable_due_to_send_msg(grpc_chttp2_transport* t,
                                                   grpc_chttp2_stream* s) {
   if (s->id != 0 && (!s->write_buffering ||
@@ -1397,6 +1542,7 @@ static void perform_stream_op_locked(void* stream_op,
     s->send_initial_metadata_finished = add_closure_barrier(on_complete);
     s->send_initial_metadata =
         op_payload->send_initial_metadata.send_initial_metadata;
+    s->write_weight = take_write_weight(s->send_initial_metadata);
     if (t->is_client) {
       s->deadline = GPR_MIN(s->deadline, s->send_initial_metadata->deadline);
     }
@@ -1445,6 +1591,7 @@ static void perform_stream_op_locked(void* stream_op,
   if (op->send_message) {
     GRPC_STATS_INC_HTTP2_OP_SEND_MESSAGE();
     t->num_messages_in_next_write++;
+    t->bytes_in_next_write += op->payload->send_message.send_message->length();
     GRPC_STATS_INC_HTTP2_SEND_MESSAGE_SIZE(
         op->payload->send_message.send_message->length());
     on_complete->next_data.scratch |= CLOSURE_BARRIER_MAY_COVER_WRITE;
@@ -2532,6 +2679,11 @@ static void read_action_locked(void* tp, grpc_error* error) {
     }
   }
   grpc_slice_buffer_reset_and_unref_internal(&t->read_buffer);
+  if (keep_reading && t->release_idle_buffers &&
+      grpc_chttp2_stream_map_size(&t->stream_map) == 0 &&
+      grpc_chttp2_hpack_parser_release_buffers(&t->hpack_parser) > 0) {
+    GRPC_STATS_INC_HTTP2_IDLE_PARSER_BUFFERS_RELEASED();
+  }
 
   if (keep_reading) {
     if (t->num_pending_induced_frames >= DEFAULT_MAX_PENDING_INDUCED_FRAMES) {
@@ -27,6 +27,7 @@
 
 #include <string>
 
+#include "absl/memory/memory.h"
 #include "absl/strings/str_format.h"
 
 #include <grpc/support/alloc.h>
@@ -175,19 +176,13 @@ TransportFlowControlDisabled::TransportFlowControlDisabled(
 }
 
 TransportFlowControl::TransportFlowControl(const grpc_chttp2_transport* t,
-                                           bool enable_bdp_probe)
+                                           bool enable_bdp_probe,
+                                           TargetWindowPolicy::Type policy_type)
     : t_(t),
       enable_bdp_probe_(enable_bdp_probe),
       bdp_estimator_(t->peer_string.c_str()),
-      pid_controller_(grpc_core::PidController::Args()
-                          .set_gain_p(4)
-                          .set_gain_i(8)
-                          .set_gain_d(0)
-                          .set_initial_control_value(TargetLogBdp())
-                          .set_min_control_value(-1)
-                          .set_max_control_value(25)
-                          .set_integral_range(10)),
-      last_pid_update_(grpc_core::ExecCtx::Get()->Now()) {}
+      target_window_policy_(TargetWindowPolicy::Create(
+          policy_type, bdp_estimator_, MemoryPressure())) {}
 
 uint32_t TransportFlowControl::MaybeSendUpdate(bool writing_anyway) {
   FlowControlTrace trace("t updt sent", this, nullptr);
@@ -305,10 +300,8 @@ void StreamFlowControl::IncomingByteStreamUpdate(size_t max_size_hint,
 }
 
 // Take in a target and modifies it based on the memory pressure of the system
-static double AdjustForMemoryPressure(grpc_resource_quota* quota,
-                                      double target) {
+static double AdjustForMemoryPressure(double memory_pressure, double target) {
   // do not increase window under heavy memory pressure.
-  double memory_pressure = grpc_resource_quota_get_memory_pressure(quota);
   static const double kLowMemPressure = 0.1;
   static const double kZeroTarget = 22;
   static const double kHighMemPressure = 0.8;
@@ -323,20 +316,86 @@ static double AdjustForMemoryPressure(grpc_resource_quota* quota,
   return target;
 }
 
-double TransportFlowControl::TargetLogBdp() {
-  return AdjustForMemoryPressure(
-      grpc_resource_user_quota(grpc_endpoint_get_resource_user(t_->ep)),
-      1 + log2(bdp_estimator_.EstimateBdp()));
+// Bounds of the log2 of the target window, whichever policy computes it
+static const double kMinTargetLogBdp = -1;
+static const double kMaxTargetLogBdp = 25;
+
+std::unique_ptr<TargetWindowPolicy> TargetWindowPolicy::Create(
+    Type type, const BdpEstimator& estimator, double memory_pressure) {
+  switch (type) {
+    case Type::kBbr:
+      return absl::make_unique<BbrTargetWindowPolicy>();
+    case Type::kPid:
+      break;
+  }
+  return absl::make_unique<PidTargetWindowPolicy>(estimator, memory_pressure);
+}
+
+static double PidTargetLogBdp(const BdpEstimator& estimator,
+                              double memory_pressure) {
+  return AdjustForMemoryPressure(memory_pressure,
+                                 1 + log2(estimator.EstimateBdp()));
 }
 
-double TransportFlowControl::SmoothLogBdp(double value) {
+PidTargetWindowPolicy::PidTargetWindowPolicy(const BdpEstimator& estimator,
+                                             double memory_pressure)
+    : pid_controller_(grpc_core::PidController::Args()
+                          .set_gain_p(4)
+                          .set_gain_i(8)
+                          .set_gain_d(0)
+                          .set_initial_control_value(
+                              PidTargetLogBdp(estimator, memory_pressure))
+                          .set_min_control_value(kMinTargetLogBdp)
+                          .set_max_control_value(kMaxTargetLogBdp)
+                          .set_integral_range(10)),
+      last_pid_update_(grpc_core::ExecCtx::Get()->Now()) {}
+
+double PidTargetWindowPolicy::TargetInitialWindow(const BdpEstimator& estimator,
+                                                  double memory_pressure) {
   grpc_millis now = grpc_core::ExecCtx::Get()->Now();
-  double bdp_error = value - pid_controller_.last_control_value();
+  double bdp_error = PidTargetLogBdp(estimator, memory_pressure) -
+                     pid_controller_.last_control_value();
   const double dt = static_cast<double>(now - last_pid_update_) * 1e-3;
   last_pid_update_ = now;
   // Limit dt to 100ms
   const double kMaxDt = 0.1;
-  return pid_controller_.Update(bdp_error, dt > kMaxDt ? kMaxDt : dt);
+  return pow(2, pid_controller_.Update(bdp_error, dt > kMaxDt ? kMaxDt : dt));
+}
+
+BbrTargetWindowPolicy::BbrTargetWindowPolicy()
+    : bottleneck_estimator_(grpc_core::BottleneckEstimator::Args()
+                                .set_bandwidth_window_rounds(10)
+                                .set_min_rtt_window(10000)) {}
+
+double BbrTargetWindowPolicy::TargetInitialWindow(const BdpEstimator& estimator,
+                                                  double memory_pressure) {
+  // Twice the path's BDP: keeps it full while window updates are in flight,
+  // and lets delivery double every round while the window is what limits it.
+  static const double kBdpGain = 2;
+  if (estimator.completed_pings() != sampled_pings_) {
+    sampled_pings_ = estimator.completed_pings();
+    bottleneck_estimator_.AddSample(estimator.last_ping_bytes(),
+                                    estimator.last_ping_rtt(),
+                                    grpc_core::ExecCtx::Get()->Now());
+  }
+  double bdp = bottleneck_estimator_.EstimateBdp();
+  // Until a ping has measured some delivery, start where the estimator does
+  if (bdp <= 0) bdp = static_cast<double>(estimator.EstimateBdp());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_flowctl_trace)) {
+    gpr_log(GPR_INFO, "bbr: bw=%lfMbs min_rtt=%lfms bdp=%lf mem_pressure=%lf",
+            bottleneck_estimator_.max_bandwidth() / 125000.0,
+            bottleneck_estimator_.min_rtt() * 1e3, bdp, memory_pressure);
+  }
+  // A bandwidth or RTT outlier must not blow the window up past what the PID
+  // policy would ever ask for
+  return pow(2, GPR_CLAMP(AdjustForMemoryPressure(memory_pressure,
+                                                  log2(kBdpGain * bdp)),
+                          kMinTargetLogBdp, kMaxTargetLogBdp));
+}
+
+double TransportFlowControl::MemoryPressure() const {
+  return grpc_resource_quota_get_memory_pressure(
+      grpc_resource_user_quota(grpc_endpoint_get_resource_user(t_->ep)));
 }
 
 FlowControlAction::Urgency TransportFlowControl::DeltaUrgency(
@@ -358,7 +417,8 @@ FlowControlAction TransportFlowControl::PeriodicUpdate() {
     // target might change based on how much memory pressure we are under
     // TODO(ncteisen): experiment with setting target to be huge under low
     // memory pressure.
-    double target = pow(2, SmoothLogBdp(TargetLogBdp()));
+    double target = target_window_policy_->TargetInitialWindow(
+        bdp_estimator_, MemoryPressure());
     if (g_test_only_transport_target_window_estimates_mocker != nullptr) {
       // Hook for simulating unusual flow control situations in tests.
       target = g_test_only_transport_target_window_estimates_mocker
@@ -23,10 +23,13 @@
 
 #include <stdint.h>
 
+#include <memory>
+
 #include "src/core/ext/transport/chttp2/transport/http2_settings.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/transport/bdp_estimator.h"
+#include "src/core/lib/transport/bottleneck_estimator.h"
 #include "src/core/lib/transport/pid_controller.h"
 
 struct grpc_chttp2_transport;
@@ -216,11 +219,74 @@ class TransportFlowControlDisabled final : public TransportFlowControlBase {
   void RecvUpdate(uint32_t /* size */) override {}
 };
 
+// Decides the initial window size a transport asks its peer for, from what
+// its BdpEstimator has measured. Consulted on every PeriodicUpdate() of a
+// TransportFlowControl that probes BDP.
+class TargetWindowPolicy {
+ public:
+  // Policies selectable with GRPC_ARG_HTTP2_FLOW_CONTROL_POLICY
+  enum class Type { kPid, kBbr };
+
+  virtual ~TargetWindowPolicy() {}
+
+  static std::unique_ptr<TargetWindowPolicy> Create(
+      Type type, const BdpEstimator& estimator, double memory_pressure);
+
+  // Returns the initial window size to target, in bytes. \a memory_pressure
+  // is that of the transport's resource quota, in [0, 1].
+  virtual double TargetInitialWindow(const BdpEstimator& estimator,
+                                     double memory_pressure) = 0;
+
+  virtual const char* name() const = 0;
+};
+
+// Smooths the estimator's own BDP estimate with a PID controller, in log
+// space.
+class PidTargetWindowPolicy final : public TargetWindowPolicy {
+ public:
+  PidTargetWindowPolicy(const BdpEstimator& estimator, double memory_pressure);
+
+  double TargetInitialWindow(const BdpEstimator& estimator,
+                             double memory_pressure) override;
+
+  const char* name() const override { return "pid"; }
+
+ private:
+  grpc_core::PidController pid_controller_;
+  grpc_millis last_pid_update_ = 0;
+};
+
+// Models the path from the estimator's pings: each completed ping is a
+// delivery sample, from which a BottleneckEstimator tracks the bottleneck
+// bandwidth and the minimum round-trip time. The target is a multiple of
+// their product, so that it keeps growing while the window is what limits
+// delivery, and settles once the path is.
+class BbrTargetWindowPolicy final : public TargetWindowPolicy {
+ public:
+  BbrTargetWindowPolicy();
+
+  double TargetInitialWindow(const BdpEstimator& estimator,
+                             double memory_pressure) override;
+
+  const char* name() const override { return "bbr"; }
+
+  const grpc_core::BottleneckEstimator& bottleneck_estimator() const {
+    return bottleneck_estimator_;
+  }
+
+ private:
+  grpc_core::BottleneckEstimator bottleneck_estimator_;
+  // Pings of the estimator already added as samples
+  int64_t sampled_pings_ = 0;
+};
+
 // Implementation of flow control that abides to HTTP/2 spec and attempts
 // to be as performant as possible.
 class TransportFlowControl final : public TransportFlowControlBase {
  public:
-  TransportFlowControl(const grpc_chttp2_transport* t, bool enable_bdp_probe);
+  TransportFlowControl(const grpc_chttp2_transport* t, bool enable_bdp_probe,
+                       TargetWindowPolicy::Type policy_type =
+                           TargetWindowPolicy::Type::kPid);
   ~TransportFlowControl() override {}
 
   bool flow_control_enabled() const override { return true; }
@@ -290,14 +356,17 @@ class TransportFlowControl final : public TransportFlowControlBase {
 
   BdpEstimator* bdp_estimator() override { return &bdp_estimator_; }
 
+  const TargetWindowPolicy* target_window_policy() const {
+    return target_window_policy_.get();
+  }
+
   void TestOnlyForceHugeWindow() override {
     announced_window_ = 1024 * 1024 * 1024;
     remote_window_ = 1024 * 1024 * 1024;
   }
 
  private:
-  double TargetLogBdp();
-  double SmoothLogBdp(double value);
+  double MemoryPressure() const;
   FlowControlAction::Urgency DeltaUrgency(int64_t value,
                                           grpc_chttp2_setting_id setting_id);
 
@@ -327,9 +396,8 @@ class TransportFlowControl final : public TransportFlowControlBase {
   /* bdp estimation */
   grpc_core::BdpEstimator bdp_estimator_;
 
-  /* pid controller */
-  grpc_core::PidController pid_controller_;
-  grpc_millis last_pid_update_ = 0;
+  /* sizes the target window from the bdp estimation */
+  std::unique_ptr<TargetWindowPolicy> target_window_policy_;
 };
 
 // Fat interface with all methods a stream flow control implementation needs
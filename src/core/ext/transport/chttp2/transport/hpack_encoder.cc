@@ -43,27 +43,8 @@
 #include "src/core/lib/transport/timeout_encoding.h"
 
 namespace {
-/* (Maybe-cuckoo) hpack encoder hash table implementation.
-
-   This hashtable implementation is a subset of a proper cuckoo hash; while we
-   have fallback cells that a value can be hashed to if the first cell is full,
-   we do not attempt to iteratively rearrange entries into backup cells to get
-   things to fit. Instead, if both a cell and the backup cell for a value are
-   occupied, the older existing entry is evicted.
-
-   Note that we can disable backup-cell picking by setting
-   GRPC_HPACK_ENCODER_USE_CUCKOO_HASH to 0. In that case, we simply evict an
-   existing entry rather than try to use a backup. Hence, "maybe-cuckoo."
-   TODO(arjunroy): Add unit tests for hashtable implementation. */
-#define GRPC_HPACK_ENCODER_USE_CUCKOO_HASH 1
 #define HASH_FRAGMENT_MASK (GRPC_CHTTP2_HPACKC_NUM_VALUES - 1)
 #define HASH_FRAGMENT_1(x) ((x)&HASH_FRAGMENT_MASK)
-#define HASH_FRAGMENT_2(x) \
-  (((x) >> GRPC_CHTTP2_HPACKC_NUM_VALUES_BITS) & HASH_FRAGMENT_MASK)
-#define HASH_FRAGMENT_3(x) \
-  (((x) >> (GRPC_CHTTP2_HPACKC_NUM_VALUES_BITS * 2)) & HASH_FRAGMENT_MASK)
-#define HASH_FRAGMENT_4(x) \
-  (((x) >> (GRPC_CHTTP2_HPACKC_NUM_VALUES_BITS * 3)) & HASH_FRAGMENT_MASK)
 
 /* don't consider adding anything bigger than this to the hpack table */
 constexpr size_t kMaxDecoderSpaceUsage = 512;
@@ -74,154 +55,8 @@ constexpr uint8_t kMaxFilterValue = 255;
    it to the table */
 #define ONE_ON_ADD_PROBABILITY (GRPC_CHTTP2_HPACKC_NUM_VALUES >> 1)
 /* The hpack index we encode over the wire. Meaningful to the hpack encoder and
-   parser on the remote end as well as HTTP2. *Not* the same as
-   HpackEncoderSlotHash, which is only meaningful to the hpack encoder
-   implementation (HpackEncoderSlotHash is used for the hashtable implementation
-   when mapping from metadata to HpackEncoderIndex. */
+   parser on the remote end as well as HTTP2. */
 typedef uint32_t HpackEncoderIndex;
-/* Internal-table bookkeeping (*not* the hpack index). */
-typedef uint32_t HpackEncoderSlotHash;
-
-struct SliceRefComparator {
-  typedef grpc_slice_refcount* Type;
-  static grpc_slice_refcount* Null() { return nullptr; }
-  static bool IsNull(const grpc_slice_refcount* sref) {
-    return sref == nullptr;
-  }
-  static bool Equals(const grpc_slice_refcount* s1,
-                     const grpc_slice_refcount* s2) {
-    return s1 == s2;
-  }
-  static void Ref(grpc_slice_refcount* sref) {
-    GPR_DEBUG_ASSERT(sref != nullptr);
-    sref->Ref();
-  }
-  static void Unref(grpc_slice_refcount* sref) {
-    GPR_DEBUG_ASSERT(sref != nullptr);
-    sref->Unref();
-  }
-};
-
-struct MetadataComparator {
-  typedef grpc_mdelem Type;
-  static const grpc_mdelem Null() { return {0}; }
-  static bool IsNull(const grpc_mdelem md) { return md.payload == 0; }
-  static bool Equals(const grpc_mdelem md1, const grpc_mdelem md2) {
-    return md1.payload == md2.payload;
-  }
-  static void Ref(grpc_mdelem md) {
-    GPR_DEBUG_ASSERT(md.payload != 0);
-    GRPC_MDELEM_REF(md);
-  }
-  static void Unref(grpc_mdelem md) {
-    GPR_DEBUG_ASSERT(md.payload != 0);
-    GRPC_MDELEM_UNREF(md);
-  }
-};
-
-/* Index table management */
-template <typename Hashtable>
-static HpackEncoderIndex HpackIndex(const Hashtable* hashtable,
-                                    HpackEncoderSlotHash hash_index) {
-  return hashtable[hash_index].index;
-}
-
-template <typename ValueType, typename Hashtable>
-static const ValueType& GetEntry(const Hashtable* hashtable,
-                                 HpackEncoderSlotHash hash_index) {
-  return hashtable[hash_index].value;
-}
-
-template <typename Cmp, typename Hashtable>
-static bool TableEmptyAt(const Hashtable* hashtable,
-                         HpackEncoderSlotHash hash_index) {
-  return Cmp::Equals(hashtable[hash_index].value, Cmp::Null());
-}
-
-template <typename Cmp, typename Hashtable, typename ValueType>
-static bool Matches(const Hashtable* hashtable, const ValueType& value,
-                    HpackEncoderSlotHash hash_index) {
-  return Cmp::Equals(value, hashtable[hash_index].value);
-}
-
-template <typename Hashtable>
-static void UpdateIndex(Hashtable* hashtable, HpackEncoderSlotHash hash_index,
-                        HpackEncoderIndex hpack_index) {
-  hashtable[hash_index].index = hpack_index;
-}
-
-template <typename Hashtable, typename ValueType>
-static void SetIndex(Hashtable* hashtable, HpackEncoderSlotHash hash_index,
-                     const ValueType& value, HpackEncoderIndex hpack_index) {
-  hashtable[hash_index].value = value;
-  UpdateIndex(hashtable, hash_index, hpack_index);
-}
-
-template <typename Cmp, typename Hashtable, typename ValueType>
-static bool GetMatchingIndex(Hashtable* hashtable, const ValueType& value,
-                             uint32_t value_hash, HpackEncoderIndex* index) {
-  const HpackEncoderSlotHash cuckoo_first = HASH_FRAGMENT_2(value_hash);
-  if (Matches<Cmp>(hashtable, value, cuckoo_first)) {
-    *index = HpackIndex(hashtable, cuckoo_first);
-    return true;
-  }
-#if GRPC_HPACK_ENCODER_USE_CUCKOO_HASH
-  const HpackEncoderSlotHash cuckoo_second = HASH_FRAGMENT_3(value_hash);
-
-  if (Matches<Cmp>(hashtable, value, cuckoo_second)) {
-    *index = HpackIndex(hashtable, cuckoo_second);
-    return true;
-  }
-#endif
-  return false;
-}
-
-template <typename Cmp, typename Hashtable, typename ValueType>
-static ValueType ReplaceOlderIndex(Hashtable* hashtable, const ValueType& value,
-                                   HpackEncoderSlotHash hash_index_a,
-                                   HpackEncoderSlotHash hash_index_b,
-                                   HpackEncoderIndex new_index) {
-  const HpackEncoderIndex hpack_idx_a = hashtable[hash_index_a].index;
-  const HpackEncoderIndex hpack_idx_b = hashtable[hash_index_b].index;
-  const HpackEncoderSlotHash id =
-      hpack_idx_a < hpack_idx_b ? hash_index_a : hash_index_b;
-  ValueType old = GetEntry<typename Cmp::Type>(hashtable, id);
-  SetIndex(hashtable, id, value, new_index);
-  return old;
-}
-
-template <typename Cmp, typename Hashtable, typename ValueType>
-static void UpdateAddOrEvict(Hashtable hashtable, const ValueType& value,
-                             uint32_t value_hash, HpackEncoderIndex new_index) {
-  const HpackEncoderSlotHash cuckoo_first = HASH_FRAGMENT_2(value_hash);
-  if (Matches<Cmp>(hashtable, value, cuckoo_first)) {
-    UpdateIndex(hashtable, cuckoo_first, new_index);
-    return;
-  }
-  if (TableEmptyAt<Cmp>(hashtable, cuckoo_first)) {
-    Cmp::Ref(value);
-    SetIndex(hashtable, cuckoo_first, value, new_index);
-    return;
-  }
-#if GRPC_HPACK_ENCODER_USE_CUCKOO_HASH
-  const HpackEncoderSlotHash cuckoo_second = HASH_FRAGMENT_3(value_hash);
-  if (Matches<Cmp>(hashtable, value, cuckoo_second)) {
-    UpdateIndex(hashtable, cuckoo_second, new_index);
-    return;
-  }
-  Cmp::Ref(value);
-  if (TableEmptyAt<Cmp>(hashtable, cuckoo_second)) {
-    SetIndex(hashtable, cuckoo_second, value, new_index);
-    return;
-  }
-  Cmp::Unref(ReplaceOlderIndex<Cmp>(hashtable, value, cuckoo_first,
-                                    cuckoo_second, new_index));
-#else
-  ValueType old = GetEntry<typename Cmp::Type>(hashtable, cuckoo_first);
-  SetIndex(hashtable, cuckoo_first, value, new_index);
-  Cmp::Unref(old);
-#endif
-}
 
 /* halve all counts because an element reached max */
 static void HalveFilter(uint8_t /*idx*/, uint32_t* sum, uint8_t* elems) {
@@ -257,6 +92,128 @@ static bool CanAddToHashtable(grpc_chttp2_hpack_compressor* hpack_compressor,
       hpack_compressor->filter_elems_sum / ONE_ON_ADD_PROBABILITY;
   return can_add;
 }
+
+/* Dynamic table index management.
+
+   elem_index and key_index are linear probing hash tables over the entries of
+   the decoder's dynamic table, keyed by the hash of the (static or interned)
+   element or key. A value present in several entries maps to the newest one.
+   Entries are evicted oldest first, so once the entry a slot maps to is
+   evicted, no entry holding that value remains and the slot is cleared
+   (shifting later slots of the probe sequence back, so that no tombstones are
+   needed). */
+struct ElemIndex {
+  typedef grpc_mdelem Type;
+  static grpc_chttp2_hpack_compressor_slot* Slots(
+      grpc_chttp2_hpack_compressor* c) {
+    return c->elem_index;
+  }
+  static bool Indexed(const grpc_chttp2_hpack_compressor_entry& e) {
+    return e.elem.payload != 0;
+  }
+  static grpc_mdelem Value(const grpc_chttp2_hpack_compressor_entry& e) {
+    return e.elem;
+  }
+  static bool Holds(const grpc_chttp2_hpack_compressor_entry& e,
+                    grpc_mdelem elem) {
+    return e.elem.payload == elem.payload;
+  }
+  static uint32_t Hash(const grpc_chttp2_hpack_compressor_entry& e) {
+    return e.elem_hash;
+  }
+};
+
+struct KeyIndex {
+  typedef grpc_slice_refcount* Type;
+  static grpc_chttp2_hpack_compressor_slot* Slots(
+      grpc_chttp2_hpack_compressor* c) {
+    return c->key_index;
+  }
+  static bool Indexed(const grpc_chttp2_hpack_compressor_entry& e) {
+    return e.key != nullptr;
+  }
+  static grpc_slice_refcount* Value(
+      const grpc_chttp2_hpack_compressor_entry& e) {
+    return e.key;
+  }
+  static bool Holds(const grpc_chttp2_hpack_compressor_entry& e,
+                    grpc_slice_refcount* key) {
+    return e.key == key;
+  }
+  static uint32_t Hash(const grpc_chttp2_hpack_compressor_entry& e) {
+    return e.key_hash;
+  }
+};
+
+static grpc_chttp2_hpack_compressor_entry* EntryAt(
+    grpc_chttp2_hpack_compressor* c, HpackEncoderIndex index) {
+  return &c->table_entries[index % c->cap_table_elems];
+}
+
+/* Returns the hpack index of the newest entry holding value, or 0 if there is
+   none */
+template <typename Index>
+static HpackEncoderIndex IndexLookup(grpc_chttp2_hpack_compressor* c,
+                                     typename Index::Type value,
+                                     uint32_t hash) {
+  const grpc_chttp2_hpack_compressor_slot* slots = Index::Slots(c);
+  const uint32_t mask = c->index_cap - 1;
+  for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+    const grpc_chttp2_hpack_compressor_slot& slot = slots[i];
+    if (slot.index == 0) return 0;
+    if (slot.hash == hash && Index::Holds(*EntryAt(c, slot.index), value)) {
+      return slot.index;
+    }
+  }
+}
+
+/* Maps the value of the entry at index to that entry, the newest one */
+template <typename Index>
+static void IndexInsert(grpc_chttp2_hpack_compressor* c,
+                        HpackEncoderIndex index) {
+  const grpc_chttp2_hpack_compressor_entry& entry = *EntryAt(c, index);
+  if (!Index::Indexed(entry)) return;
+  grpc_chttp2_hpack_compressor_slot* slots = Index::Slots(c);
+  const uint32_t hash = Index::Hash(entry);
+  const uint32_t mask = c->index_cap - 1;
+  for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+    grpc_chttp2_hpack_compressor_slot& slot = slots[i];
+    if (slot.index == 0 ||
+        (slot.hash == hash &&
+         Index::Holds(*EntryAt(c, slot.index), Index::Value(entry)))) {
+      slot.hash = hash;
+      slot.index = index;
+      return;
+    }
+  }
+}
+
+/* Clears the slot mapping to the entry at index, if any */
+template <typename Index>
+static void IndexErase(grpc_chttp2_hpack_compressor* c,
+                       HpackEncoderIndex index) {
+  const grpc_chttp2_hpack_compressor_entry& entry = *EntryAt(c, index);
+  if (!Index::Indexed(entry)) return;
+  grpc_chttp2_hpack_compressor_slot* slots = Index::Slots(c);
+  const uint32_t mask = c->index_cap - 1;
+  uint32_t hole = Index::Hash(entry) & mask;
+  while (slots[hole].index != index) {
+    if (slots[hole].index == 0) return;
+    hole = (hole + 1) & mask;
+  }
+  for (uint32_t i = (hole + 1) & mask; slots[i].index != 0;
+       i = (i + 1) & mask) {
+    /* move slot i into the hole unless its probe sequence starts after the
+       hole */
+    const uint32_t home = slots[i].hash & mask;
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      slots[hole] = slots[i];
+      hole = i;
+    }
+  }
+  slots[hole].index = 0;
+}
+
 } /* namespace */
 
 struct framer_state {
@@ -389,13 +346,21 @@ static uint8_t* add_tiny_header_data(framer_state* st, size_t len) {
 static void evict_entry(grpc_chttp2_hpack_compressor* c) {
   c->tail_remote_index++;
   GPR_ASSERT(c->tail_remote_index > 0);
-  GPR_ASSERT(c->table_size >=
-             c->table_elem_size[c->tail_remote_index % c->cap_table_elems]);
+  grpc_chttp2_hpack_compressor_entry* entry =
+      EntryAt(c, c->tail_remote_index);
+  GPR_ASSERT(c->table_size >= entry->size);
   GPR_ASSERT(c->table_elems > 0);
-  c->table_size = static_cast<uint16_t>(
-      c->table_size -
-      c->table_elem_size[c->tail_remote_index % c->cap_table_elems]);
+  c->table_size = static_cast<uint16_t>(c->table_size - entry->size);
   c->table_elems--;
+  IndexErase<ElemIndex>(c, c->tail_remote_index);
+  IndexErase<KeyIndex>(c, c->tail_remote_index);
+  if (entry->elem.payload != 0) {
+    GRPC_MDELEM_UNREF(entry->elem);
+  }
+  if (entry->key != nullptr) {
+    entry->key->Unref();
+  }
+  *entry = grpc_chttp2_hpack_compressor_entry();
 }
 
 // Reserve space in table for the new element, evict entries if needed.
@@ -421,8 +386,7 @@ static uint32_t prepare_space_for_new_elem(grpc_chttp2_hpack_compressor* c,
     evict_entry(c);
   }
   GPR_ASSERT(c->table_elems < c->max_table_size);
-  c->table_elem_size[new_index % c->cap_table_elems] =
-      static_cast<uint16_t>(elem_size);
+  EntryAt(c, new_index)->size = static_cast<uint16_t>(elem_size);
   c->table_size = static_cast<uint16_t>(c->table_size + elem_size);
   c->table_elems++;
 
@@ -434,8 +398,11 @@ static uint32_t prepare_space_for_new_elem(grpc_chttp2_hpack_compressor* c,
 static void AddKeyWithIndex(grpc_chttp2_hpack_compressor* c,
                             grpc_slice_refcount* key_ref, uint32_t new_index,
                             uint32_t key_hash) {
-  UpdateAddOrEvict<SliceRefComparator>(c->key_table.entries, key_ref, key_hash,
-                                       new_index);
+  grpc_chttp2_hpack_compressor_entry* entry = EntryAt(c, new_index);
+  key_ref->Ref();
+  entry->key = key_ref;
+  entry->key_hash = key_hash;
+  IndexInsert<KeyIndex>(c, new_index);
 }
 
 /* add an element to the decoder table */
@@ -443,8 +410,10 @@ static void AddElemWithIndex(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
                              uint32_t new_index, uint32_t elem_hash,
                              uint32_t key_hash) {
   GPR_DEBUG_ASSERT(GRPC_MDELEM_IS_INTERNED(elem));
-  UpdateAddOrEvict<MetadataComparator>(c->elem_table.entries, elem, elem_hash,
-                                       new_index);
+  grpc_chttp2_hpack_compressor_entry* entry = EntryAt(c, new_index);
+  entry->elem = GRPC_MDELEM_REF(elem);
+  entry->elem_hash = elem_hash;
+  IndexInsert<ElemIndex>(c, new_index);
   AddKeyWithIndex(c, GRPC_MDKEY(elem).refcount, new_index, key_hash);
 }
 
@@ -650,14 +619,14 @@ static EmitIndexedStatus maybe_emit_indexed(grpc_chttp2_hpack_compressor* c,
   /* Update filter to see if we can perhaps add this elem. */
   const uint32_t popularity_hash = UpdateHashtablePopularity(c, elem_hash);
   /* is this elem currently in the decoders table? */
-  HpackEncoderIndex indices_key;
-  if (GetMatchingIndex<MetadataComparator>(c->elem_table.entries, elem,
-                                           elem_hash, &indices_key) &&
-      indices_key > c->tail_remote_index) {
+  const HpackEncoderIndex indices_key =
+      IndexLookup<ElemIndex>(c, elem, elem_hash);
+  if (indices_key != 0) {
+    GPR_DEBUG_ASSERT(indices_key > c->tail_remote_index);
     emit_indexed(c, dynidx(c, indices_key), st);
     return EmitIndexedStatus(elem_hash, true, false);
   }
-  /* Didn't hit either cuckoo index, so no emit. */
+  /* Not in the table, so no emit. */
   return EmitIndexedStatus(elem_hash, false,
                            CanAddToHashtable(c, popularity_hash));
 }
@@ -719,10 +688,10 @@ static void hpack_enc(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
   const uint32_t elem_hash = ret.elem_hash;
   /* no hits for the elem... maybe there's a key? */
   const uint32_t key_hash = elem_key.refcount->Hash(elem_key);
-  HpackEncoderIndex indices_key;
-  if (GetMatchingIndex<SliceRefComparator>(
-          c->key_table.entries, elem_key.refcount, key_hash, &indices_key) &&
-      indices_key > c->tail_remote_index) {
+  const HpackEncoderIndex indices_key =
+      IndexLookup<KeyIndex>(c, elem_key.refcount, key_hash);
+  if (indices_key != 0) {
+    GPR_DEBUG_ASSERT(indices_key > c->tail_remote_index);
     emit_maybe_add(c, elem, st, indices_key, should_add_elem,
                    decoder_space_usage, elem_hash, key_hash);
     return;
@@ -758,26 +727,46 @@ static void deadline_enc(grpc_chttp2_hpack_compressor* c, grpc_millis deadline,
 
 static uint32_t elems_for_bytes(uint32_t bytes) { return (bytes + 31) / 32; }
 
+/* (re)allocate the indices for the current table capacity and fill them in */
+static void rebuild_indices(grpc_chttp2_hpack_compressor* c) {
+  uint32_t index_cap = 1;
+  while (index_cap < 2 * c->cap_table_elems) {
+    index_cap *= 2;
+  }
+  const size_t alloc_size = sizeof(*c->elem_index) * index_cap;
+  gpr_free(c->elem_index);
+  gpr_free(c->key_index);
+  c->index_cap = index_cap;
+  c->elem_index =
+      static_cast<grpc_chttp2_hpack_compressor_slot*>(gpr_zalloc(alloc_size));
+  c->key_index =
+      static_cast<grpc_chttp2_hpack_compressor_slot*>(gpr_zalloc(alloc_size));
+  /* oldest first, so that values map to their newest entries */
+  for (uint32_t i = 0; i < c->table_elems; i++) {
+    const HpackEncoderIndex index = c->tail_remote_index + i + 1;
+    IndexInsert<ElemIndex>(c, index);
+    IndexInsert<KeyIndex>(c, index);
+  }
+}
+
 void grpc_chttp2_hpack_compressor_init(grpc_chttp2_hpack_compressor* c) {
   memset(c, 0, sizeof(*c));
   c->max_table_size = GRPC_CHTTP2_HPACKC_INITIAL_TABLE_SIZE;
   c->cap_table_elems = elems_for_bytes(c->max_table_size);
   c->max_table_elems = c->cap_table_elems;
   c->max_usable_size = GRPC_CHTTP2_HPACKC_INITIAL_TABLE_SIZE;
-  const size_t alloc_size = sizeof(*c->table_elem_size) * c->cap_table_elems;
-  c->table_elem_size = static_cast<uint16_t*>(gpr_malloc(alloc_size));
-  memset(c->table_elem_size, 0, alloc_size);
+  c->table_entries = static_cast<grpc_chttp2_hpack_compressor_entry*>(
+      gpr_zalloc(sizeof(*c->table_entries) * c->cap_table_elems));
+  rebuild_indices(c);
 }
 
 void grpc_chttp2_hpack_compressor_destroy(grpc_chttp2_hpack_compressor* c) {
-  for (int i = 0; i < GRPC_CHTTP2_HPACKC_NUM_VALUES; i++) {
-    auto* const key = GetEntry<grpc_slice_refcount*>(c->key_table.entries, i);
-    if (key != nullptr) {
-      key->Unref();
-    }
-    GRPC_MDELEM_UNREF(GetEntry<grpc_mdelem>(c->elem_table.entries, i));
+  while (c->table_elems > 0) {
+    evict_entry(c);
   }
-  gpr_free(c->table_elem_size);
+  gpr_free(c->table_entries);
+  gpr_free(c->elem_index);
+  gpr_free(c->key_index);
 }
 
 void grpc_chttp2_hpack_compressor_set_max_usable_size(
@@ -788,22 +777,22 @@ void grpc_chttp2_hpack_compressor_set_max_usable_size(
 }
 
 static void rebuild_elems(grpc_chttp2_hpack_compressor* c, uint32_t new_cap) {
-  uint16_t* table_elem_size =
-      static_cast<uint16_t*>(gpr_malloc(sizeof(*table_elem_size) * new_cap));
+  grpc_chttp2_hpack_compressor_entry* table_entries =
+      static_cast<grpc_chttp2_hpack_compressor_entry*>(
+          gpr_zalloc(sizeof(*table_entries) * new_cap));
   uint32_t i;
 
-  memset(table_elem_size, 0, sizeof(*table_elem_size) * new_cap);
   GPR_ASSERT(c->table_elems <= new_cap);
 
   for (i = 0; i < c->table_elems; i++) {
     uint32_t ofs = c->tail_remote_index + i + 1;
-    table_elem_size[ofs % new_cap] =
-        c->table_elem_size[ofs % c->cap_table_elems];
+    table_entries[ofs % new_cap] = c->table_entries[ofs % c->cap_table_elems];
   }
 
   c->cap_table_elems = new_cap;
-  gpr_free(c->table_elem_size);
-  c->table_elem_size = table_elem_size;
+  gpr_free(c->table_entries);
+  c->table_entries = table_entries;
+  rebuild_indices(c);
 }
 
 void grpc_chttp2_hpack_compressor_set_max_table_size(
@@ -839,9 +828,9 @@ void grpc_chttp2_encode_header(grpc_chttp2_hpack_compressor* c,
                                grpc_slice_buffer* outbuf) {
   /* grpc_chttp2_encode_header is called by FlushInitial/TrailingMetadata in
      writing.cc. Specifically, on streams returned by NextStream(), which
-     returns streams from the list GRPC_CHTTP2_LIST_WRITABLE. The only way to be
-     added to the list is via  grpc_chttp2_list_add_writable_stream(), which
-     validates that stream_id is not 0. So, this can be a debug assert. */
+     returns streams from the lists GRPC_CHTTP2_LIST_WRITABLE(_PRIORITY). The
+     only way to be added to them is via grpc_chttp2_list_add_writable_stream(),
+     which validates that stream_id is not 0. So, this can be a debug assert. */
   GPR_DEBUG_ASSERT(options->stream_id != 0);
   framer_state st;
 #ifndef NDEBUG
@@ -28,7 +28,7 @@
 #include "src/core/lib/transport/metadata_batch.h"
 #include "src/core/lib/transport/transport.h"
 
-// This should be <= 8. We use 6 to save space.
+// Size of the popularity filter. This should be <= 8. We use 6 to save space.
 #define GRPC_CHTTP2_HPACKC_NUM_VALUES_BITS 6
 #define GRPC_CHTTP2_HPACKC_NUM_VALUES (1 << GRPC_CHTTP2_HPACKC_NUM_VALUES_BITS)
 /* initial table size, per spec */
@@ -38,6 +38,26 @@
 
 extern grpc_core::TraceFlag grpc_http_trace;
 
+/* an entry of the decoder's dynamic table, as tracked by the encoder */
+struct grpc_chttp2_hpack_compressor_entry {
+  /* the element, or null if the entry was only added to index its key */
+  grpc_mdelem elem;
+  /* the key's refcount: the key is static or interned, so the refcount is
+     enough to establish its identity */
+  grpc_slice_refcount* key;
+  uint32_t elem_hash;
+  uint32_t key_hash;
+  /* size of the entry in the decoder's table */
+  uint16_t size;
+};
+
+/* a slot of an open addressing index over the dynamic table entries */
+struct grpc_chttp2_hpack_compressor_slot {
+  uint32_t hash;
+  /* hpack index of the entry, or 0 if the slot is empty */
+  uint32_t index;
+};
+
 struct grpc_chttp2_hpack_compressor {
   uint32_t max_table_size;
   uint32_t max_table_elems;
@@ -49,7 +69,9 @@ struct grpc_chttp2_hpack_compressor {
   uint32_t tail_remote_index;
   uint32_t table_size;
   uint32_t table_elems;
-  uint16_t* table_elem_size;
+  /* the entries of the decoder's dynamic table: a ring buffer of
+     cap_table_elems entries, indexed by hpack index modulo its size */
+  grpc_chttp2_hpack_compressor_entry* table_entries;
   /** if non-zero, advertise to the decoder that we'll start using a table
       of this size */
   uint8_t advertise_table_size_change;
@@ -62,25 +84,13 @@ struct grpc_chttp2_hpack_compressor {
   uint32_t filter_elems_sum;
   uint8_t filter_elems[GRPC_CHTTP2_HPACKC_NUM_VALUES];
 
-  /* entry tables for keys & elems: these tables track values that have been
-     seen and *may* be in the decompressor table */
-  struct {
-    struct {
-      grpc_mdelem value;
-      uint32_t index;
-    } entries[GRPC_CHTTP2_HPACKC_NUM_VALUES];
-  } elem_table; /* Metadata table management */
-  struct {
-    struct {
-      /* Only store the slice refcount - we do not need the byte buffer or
-         length of the slice since we only need to store a mapping between the
-         identity of the slice and the corresponding HPACK index. Since the
-         slice *must* be static or interned, the refcount is sufficient to
-         establish identity. */
-      grpc_slice_refcount* value;
-      uint32_t index;
-    } entries[GRPC_CHTTP2_HPACKC_NUM_VALUES];
-  } key_table; /* Key table management */
+  /* linear probing hash tables mapping every element (resp. key) present in
+     the decoder's dynamic table to the hpack index of its newest entry. Both
+     have index_cap slots, a power of two at least twice cap_table_elems, so
+     they never fill up. */
+  uint32_t index_cap;
+  grpc_chttp2_hpack_compressor_slot* elem_index;
+  grpc_chttp2_hpack_compressor_slot* key_index;
 };
 
 void grpc_chttp2_hpack_compressor_init(grpc_chttp2_hpack_compressor* c);
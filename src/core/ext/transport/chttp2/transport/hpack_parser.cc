@@ -30,6 +30,7 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
 
 #include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/lib/debug/stats.h"
@@ -1417,32 +1418,58 @@ static grpc_error* finish_str(grpc_chttp2_hpack_parser* p, const uint8_t* cur,
   return GRPC_ERROR_NONE;
 }
 
-/* decode a nibble from a huffman encoded stream */
-static grpc_error* huff_nibble(grpc_chttp2_hpack_parser* p, uint8_t nibble) {
-  int16_t emit = emit_sub_tbl[16 * emit_tbl[p->huff_state] + nibble];
-  int16_t next = next_sub_tbl[16 * next_tbl[p->huff_state] + nibble];
-  if (emit != -1) {
-    if (emit >= 0 && emit < 256) {
-      uint8_t c = static_cast<uint8_t>(emit);
-      grpc_error* err = append_string(p, &c, (&c) + 1);
-      if (err != GRPC_ERROR_NONE) return err;
-    } else {
-      assert(emit == 256);
+/* nibble-at-a-time huffman decoding table, fusing the four nibble tables
+   above into a single lookup: indexed by 16 * state + input nibble, each entry
+   packs the next state (bits 0-7), the byte emitted (bits 8-15) and whether
+   there is one (bit 16). The end of stream symbol emits nothing. At 16KB, the
+   table stays in L1 cache, where a byte-indexed one would take 256KB. */
+static uint32_t huff_nibble_tbl[256 * 16];
+static gpr_once huff_nibble_tbl_once = GPR_ONCE_INIT;
+
+static void huff_nibble_tbl_init(void) {
+  for (int state = 0; state < 256; state++) {
+    for (int nibble = 0; nibble < 16; nibble++) {
+      int16_t emit = emit_sub_tbl[16 * emit_tbl[state] + nibble];
+      int16_t next = next_sub_tbl[16 * next_tbl[state] + nibble];
+      uint32_t entry = static_cast<uint32_t>(next);
+      if (emit >= 0 && emit < 256) {
+        entry |= (static_cast<uint32_t>(emit) << 8) | (1u << 16);
+      } else {
+        assert(emit == -1 || emit == 256);
+      }
+      huff_nibble_tbl[16 * state + nibble] = entry;
     }
   }
-  p->huff_state = next;
-  return GRPC_ERROR_NONE;
 }
 
-/* decode full bytes from a huffman encoded stream */
+/* decode full bytes from a huffman encoded stream: bytes are decoded into a
+   local buffer in chunks so that append_string is called once per chunk rather
+   than once per symbol */
 static grpc_error* add_huff_bytes(grpc_chttp2_hpack_parser* p,
                                   const uint8_t* cur, const uint8_t* end) {
-  for (; cur != end; ++cur) {
-    grpc_error* err = huff_nibble(p, *cur >> 4);
-    if (err != GRPC_ERROR_NONE) return parse_error(p, cur, end, err);
-    err = huff_nibble(p, *cur & 0xf);
+  static const size_t kChunkSize = 64;
+  /* at most two symbols end in one byte, since the shortest code is five bits
+     long */
+  uint8_t decoded[2 * kChunkSize];
+  uint32_t state = static_cast<uint32_t>(p->huff_state);
+  while (cur != end) {
+    const uint8_t* chunk_end =
+        cur + GPR_MIN(kChunkSize, static_cast<size_t>(end - cur));
+    uint8_t* out = decoded;
+    for (; cur != chunk_end; ++cur) {
+      uint32_t entry = huff_nibble_tbl[16 * state + (*cur >> 4)];
+      *out = static_cast<uint8_t>(entry >> 8);
+      out += entry >> 16;
+      state = entry & 0xff;
+      entry = huff_nibble_tbl[16 * state + (*cur & 0xf)];
+      *out = static_cast<uint8_t>(entry >> 8);
+      out += entry >> 16;
+      state = entry & 0xff;
+    }
+    grpc_error* err = append_string(p, decoded, out);
     if (err != GRPC_ERROR_NONE) return parse_error(p, cur, end, err);
   }
+  p->huff_state = static_cast<int16_t>(state);
   return GRPC_ERROR_NONE;
 }
 
@@ -1604,6 +1631,7 @@ static grpc_error* on_header_uninitialized(void* /*user_data*/,
 /* PUBLIC INTERFACE */
 
 void grpc_chttp2_hpack_parser_init(grpc_chttp2_hpack_parser* p) {
+  gpr_once_init(&huff_nibble_tbl_once, huff_nibble_tbl_init);
   p->on_header = on_header_uninitialized;
   p->on_header_user_data = nullptr;
   p->state = parse_begin;
@@ -1645,6 +1673,20 @@ void grpc_chttp2_hpack_parser_destroy(grpc_chttp2_hpack_parser* p) {
   gpr_free(p->value.data.copied.str);
 }
 
+size_t grpc_chttp2_hpack_parser_release_buffers(grpc_chttp2_hpack_parser* p) {
+  if (p->state != parse_begin) return 0;
+  size_t released = p->key.data.copied.capacity + p->value.data.copied.capacity;
+  gpr_free(p->key.data.copied.str);
+  p->key.data.copied.str = nullptr;
+  p->key.data.copied.capacity = 0;
+  p->key.data.copied.length = 0;
+  gpr_free(p->value.data.copied.str);
+  p->value.data.copied.str = nullptr;
+  p->value.data.copied.capacity = 0;
+  p->value.data.copied.length = 0;
+  return released;
+}
+
 grpc_error* grpc_chttp2_hpack_parser_parse(grpc_chttp2_hpack_parser* p,
                                            const grpc_slice& slice) {
 /* max number of bytes to parse at a time... limits call stack depth on
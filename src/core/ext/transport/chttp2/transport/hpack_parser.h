@@ -103,6 +103,11 @@ void grpc_chttp2_hpack_parser_destroy(grpc_chttp2_hpack_parser* p);
 
 void grpc_chttp2_hpack_parser_set_has_priority(grpc_chttp2_hpack_parser* p);
 
+/* Frees the buffers used to decode header strings, unless a header field is
+   being parsed. They grow to the largest header string seen, and are allocated
+   again as needed. Returns the number of bytes freed. */
+size_t grpc_chttp2_hpack_parser_release_buffers(grpc_chttp2_hpack_parser* p);
+
 grpc_error* grpc_chttp2_hpack_parser_parse(grpc_chttp2_hpack_parser* p,
                                            const grpc_slice& slice);
 
@@ -36,6 +36,7 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/ext/transport/chttp2/transport/incoming_metadata.h"
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
+#include "src/core/ext/transport/chttp2/transport/write_scheduler.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/compression/stream_compression.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
@@ -52,9 +53,11 @@ class ContextList;
 /* streams are kept in various linked lists depending on what things need to
    happen to them... this enum labels each list */
 typedef enum {
-  /* If a stream is in the following two lists, an explicit ref is associated
+  /* If a stream is in the following three lists, an explicit ref is associated
      with the stream */
   GRPC_CHTTP2_LIST_WRITABLE,
+  /** writable streams that the write scheduler serves first */
+  GRPC_CHTTP2_LIST_WRITABLE_PRIORITY,
   GRPC_CHTTP2_LIST_WRITING,
   /* No additional ref is taken for the following refs. Make sure to remove the
      stream from these lists when the stream is removed. */
@@ -323,10 +326,23 @@ struct grpc_chttp2_transport {
   grpc_closure write_action;
   grpc_closure write_action_end_locked;
 
+  /** write coalescing: is a write waiting on write_coalescing_timer? */
+  bool write_coalescing_pending = false;
+  grpc_timer write_coalescing_timer;
+  grpc_closure write_coalescing_timer_expired;
+  grpc_closure write_coalescing_timer_expired_locked;
+  /** message bytes queued since the last write began */
+  size_t bytes_in_next_write = 0;
+  /** number of writes initiated since the last write began */
+  uint32_t write_requests_in_next_write = 0;
+
   grpc_closure read_action_locked;
 
   /** incoming read bytes */
   grpc_slice_buffer read_buffer;
+  /** release the header parsing buffers whenever the transport has no streams
+      left after a read (GRPC_ARG_IDLE_READ_BUFFER_RELEASE_MS) */
+  bool release_idle_buffers = false;
 
   /** address to place a newly accepted stream - set and unset by
       grpc_chttp2_parsing_accept_stream; used by init_stream to
@@ -354,6 +370,11 @@ struct grpc_chttp2_transport {
   /** how much data are we willing to buffer when the WRITE_BUFFER_HINT is set?
    */
   uint32_t write_buffer_size = grpc_core::chttp2::kDefaultWindow;
+  /** how long application writes may be delayed to coalesce them with later
+      writes (0 disables write coalescing) */
+  grpc_millis write_coalescing_delay = 0;
+  /** queued message bytes at which a delayed write is started early */
+  uint32_t write_coalescing_bytes = 65536;
 
   /** Set to a grpc_error object if a goaway frame is received. By default, set
    * to GRPC_ERROR_NONE */
@@ -409,6 +430,13 @@ struct grpc_chttp2_transport {
       grpc_core::chttp2::TransportFlowControl,
       grpc_core::chttp2::TransportFlowControlDisabled>
       flow_control;
+  /** how flow_control sizes its target window from the bdp estimate */
+  grpc_core::chttp2::TargetWindowPolicy::Type flow_control_policy =
+      grpc_core::chttp2::TargetWindowPolicy::Type::kPid;
+  /** how writable streams share the connection */
+  grpc_core::chttp2::WriteScheduler::Type write_scheduler_type =
+      grpc_core::chttp2::WriteScheduler::Type::kFifo;
+  std::unique_ptr<grpc_core::chttp2::WriteScheduler> write_scheduler;
   /** initial window change. This is tracked as we parse settings frames from
    * the remote peer. If there is a positive delta, then we will make all
    * streams readable since they may have become unstalled */
@@ -574,6 +602,11 @@ struct grpc_chttp2_stream {
   /** Are we buffering writes on this stream? If yes, we won't become writable
       until there's enough queued up in the flow_controlled_buffer */
   bool write_buffering = false;
+  /** Weight of the stream under the weighted fair write scheduler */
+  uint32_t write_weight = 1;
+  /** Bytes of data the stream may carry over to its next turn at writing,
+      under the weighted fair write scheduler */
+  int64_t write_deficit = 0;
 
   /* have we sent or received the EOS bit? */
   bool eos_received = false;
@@ -702,9 +735,11 @@ void grpc_chttp2_end_write(grpc_chttp2_transport* t, grpc_error* error);
 grpc_error* grpc_chttp2_perform_read(grpc_chttp2_transport* t,
                                      const grpc_slice& slice);
 
+/** Add a stream to the writable list the write scheduler picks for it:
+    returns false if it was already writable */
 bool grpc_chttp2_list_add_writable_stream(grpc_chttp2_transport* t,
                                           grpc_chttp2_stream* s);
-/** Get a writable stream
+/** Get a writable stream, from the priority list first
     returns non-zero if there was a stream available */
 bool grpc_chttp2_list_pop_writable_stream(grpc_chttp2_transport* t,
                                           grpc_chttp2_stream** s);
@@ -27,6 +27,8 @@ static const char* stream_list_id_string(grpc_chttp2_stream_list_id id) {
   switch (id) {
     case GRPC_CHTTP2_LIST_WRITABLE:
       return "writable";
+    case GRPC_CHTTP2_LIST_WRITABLE_PRIORITY:
+      return "writable_priority";
     case GRPC_CHTTP2_LIST_WRITING:
       return "writing";
     case GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT:
@@ -141,17 +143,28 @@ static bool stream_list_add(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
 bool grpc_chttp2_list_add_writable_stream(grpc_chttp2_transport* t,
                                           grpc_chttp2_stream* s) {
   GPR_ASSERT(s->id != 0);
-  return stream_list_add(t, s, GRPC_CHTTP2_LIST_WRITABLE);
+  /* a stream waits for its turn on at most one of the writable lists */
+  if (s->included[GRPC_CHTTP2_LIST_WRITABLE_PRIORITY] ||
+      s->included[GRPC_CHTTP2_LIST_WRITABLE]) {
+    return false;
+  }
+  stream_list_add_tail(t, s,
+                       t->write_scheduler->IsPriority(s)
+                           ? GRPC_CHTTP2_LIST_WRITABLE_PRIORITY
+                           : GRPC_CHTTP2_LIST_WRITABLE);
+  return true;
 }
 
 bool grpc_chttp2_list_pop_writable_stream(grpc_chttp2_transport* t,
                                           grpc_chttp2_stream** s) {
-  return stream_list_pop(t, s, GRPC_CHTTP2_LIST_WRITABLE);
+  return stream_list_pop(t, s, GRPC_CHTTP2_LIST_WRITABLE_PRIORITY) ||
+         stream_list_pop(t, s, GRPC_CHTTP2_LIST_WRITABLE);
 }
 
 bool grpc_chttp2_list_remove_writable_stream(grpc_chttp2_transport* t,
                                              grpc_chttp2_stream* s) {
-  return stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_WRITABLE);
+  return stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_WRITABLE_PRIORITY) ||
+         stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_WRITABLE);
 }
 
 bool grpc_chttp2_list_add_writing_stream(grpc_chttp2_transport* t,
@@ -25,153 +25,283 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gpr/useful.h"
+
+static grpc_chttp2_stream_map_entry* ring_slot(grpc_chttp2_stream_map* map,
+                                               uint64_t index) {
+  return &map->ring[index & (map->capacity - 1)];
+}
+
+static bool in_window(const grpc_chttp2_stream_map* map, uint64_t index) {
+  return index >= map->base && index < map->base + map->capacity;
+}
+
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity) {
   GPR_DEBUG_ASSERT(initial_capacity > 1);
-  map->keys =
-      static_cast<uint32_t*>(gpr_malloc(sizeof(uint32_t) * initial_capacity));
-  map->values =
-      static_cast<void**>(gpr_malloc(sizeof(void*) * initial_capacity));
-  map->count = 0;
-  map->free = 0;
-  map->capacity = initial_capacity;
+  size_t capacity = 1;
+  while (capacity < initial_capacity) capacity <<= 1;
+  map->ring = static_cast<grpc_chttp2_stream_map_entry*>(
+      gpr_zalloc(sizeof(grpc_chttp2_stream_map_entry) * capacity));
+  map->capacity = capacity;
+  map->base = 0;
+  map->ring_count = 0;
+  map->overflow = nullptr;
+  map->overflow_begin = 0;
+  map->overflow_count = 0;
+  map->overflow_capacity = 0;
+  map->last_key = 0;
 }
 
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
-  gpr_free(map->keys);
-  gpr_free(map->values);
+  gpr_free(map->ring);
+  gpr_free(map->overflow);
 }
 
-static size_t compact(uint32_t* keys, void** values, size_t count) {
-  size_t i, out;
+static grpc_chttp2_stream_map_entry* overflow_entries(
+    grpc_chttp2_stream_map* map) {
+  return map->overflow + map->overflow_begin;
+}
 
-  for (i = 0, out = 0; i < count; i++) {
-    if (values[i]) {
-      keys[out] = keys[i];
-      values[out] = values[i];
-      out++;
+/* index of the first overflow entry with a key not less than key */
+static size_t overflow_lower_bound(grpc_chttp2_stream_map* map, uint64_t key) {
+  grpc_chttp2_stream_map_entry* entries = overflow_entries(map);
+  size_t min_idx = 0;
+  size_t max_idx = map->overflow_count;
+  while (min_idx < max_idx) {
+    /* find the midpoint, avoiding overflow */
+    size_t mid_idx = min_idx + ((max_idx - min_idx) / 2);
+    if (entries[mid_idx].key < key) {
+      min_idx = mid_idx + 1;
+    } else {
+      max_idx = mid_idx;
     }
   }
+  return min_idx;
+}
 
-  return out;
+static void overflow_insert(grpc_chttp2_stream_map* map, uint32_t key,
+                            void* value) {
+  if (map->overflow_begin + map->overflow_count == map->overflow_capacity) {
+    if (map->overflow_begin > map->overflow_capacity / 4) {
+      /* reuse the room left at the front by deletions */
+      memmove(map->overflow, overflow_entries(map),
+              map->overflow_count * sizeof(grpc_chttp2_stream_map_entry));
+      map->overflow_begin = 0;
+    } else {
+      map->overflow_capacity = GPR_MAX(8, 2 * map->overflow_capacity);
+      map->overflow = static_cast<grpc_chttp2_stream_map_entry*>(gpr_realloc(
+          map->overflow,
+          map->overflow_capacity * sizeof(grpc_chttp2_stream_map_entry)));
+    }
+  }
+  grpc_chttp2_stream_map_entry* entries = overflow_entries(map);
+  size_t idx = overflow_lower_bound(map, key);
+  memmove(&entries[idx + 1], &entries[idx],
+          (map->overflow_count - idx) * sizeof(grpc_chttp2_stream_map_entry));
+  entries[idx].key = key;
+  entries[idx].value = value;
+  map->overflow_count++;
 }
 
-void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
-                                void* value) {
-  size_t count = map->count;
-  size_t capacity = map->capacity;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
+/* remove an overflow entry, moving whichever side of it is shorter: streams
+   tend to be deleted oldest first */
+static void overflow_remove(grpc_chttp2_stream_map* map, size_t idx) {
+  grpc_chttp2_stream_map_entry* entries = overflow_entries(map);
+  if (idx < map->overflow_count / 2) {
+    memmove(&entries[1], &entries[0],
+            idx * sizeof(grpc_chttp2_stream_map_entry));
+    map->overflow_begin++;
+  } else {
+    memmove(&entries[idx], &entries[idx + 1],
+            (map->overflow_count - idx - 1) *
+                sizeof(grpc_chttp2_stream_map_entry));
+  }
+  map->overflow_count--;
+  if (map->overflow_count == 0) {
+    map->overflow_begin = 0;
+  }
+}
 
-  // The first assertion ensures that the table is monotonically increasing.
-  GPR_ASSERT(count == 0 || keys[count - 1] < key);
-  GPR_DEBUG_ASSERT(value);
-  // Asserting that the key is not already in the map can be a debug assertion.
-  // Why: we're already checking that the map elements are monotonically
-  // increasing. If we re-add a key, i.e. if the key is already present, then
-  // either it is the most recently added key in the map (in which case the
-  // first assertion fails due to key == last_key) or there is a more recently
-  // added (larger) key at the end of the map: in which case the first assertion
-  // still fails due to key < last_key.
-  GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
+/* place an entry whose index is in the window: in its ring slot if free, else
+   (another key with the same index is live) in the overflow */
+static void place(grpc_chttp2_stream_map* map, uint32_t key, void* value) {
+  grpc_chttp2_stream_map_entry* slot = ring_slot(map, key >> 1);
+  if (slot->value == nullptr) {
+    slot->key = key;
+    slot->value = value;
+    map->ring_count++;
+  } else {
+    overflow_insert(map, key, value);
+  }
+}
 
-  if (count == capacity) {
-    if (map->free > capacity / 4) {
-      count = compact(keys, values, count);
-      map->free = 0;
+/* double the ring, keeping the base of its window; overflow entries that the
+   larger window covers move back to the ring */
+static void grow(grpc_chttp2_stream_map* map) {
+  grpc_chttp2_stream_map_entry* old_ring = map->ring;
+  size_t old_capacity = map->capacity;
+  map->capacity = 2 * old_capacity;
+  map->ring = static_cast<grpc_chttp2_stream_map_entry*>(
+      gpr_zalloc(sizeof(grpc_chttp2_stream_map_entry) * map->capacity));
+  for (size_t i = 0; i < old_capacity; i++) {
+    if (old_ring[i].value != nullptr) {
+      *ring_slot(map, old_ring[i].key >> 1) = old_ring[i];
+    }
+  }
+  gpr_free(old_ring);
+  grpc_chttp2_stream_map_entry* entries = overflow_entries(map);
+  size_t out = 0;
+  for (size_t i = 0; i < map->overflow_count; i++) {
+    grpc_chttp2_stream_map_entry* slot = ring_slot(map, entries[i].key >> 1);
+    if (in_window(map, entries[i].key >> 1) && slot->value == nullptr) {
+      *slot = entries[i];
+      map->ring_count++;
     } else {
-      /* resize when less than 25% of the table is free, because compaction
-         won't help much */
-      map->capacity = capacity = 2 * capacity;
-      map->keys = keys = static_cast<uint32_t*>(
-          gpr_realloc(keys, capacity * sizeof(uint32_t)));
-      map->values = values =
-          static_cast<void**>(gpr_realloc(values, capacity * sizeof(void*)));
+      entries[out++] = entries[i];
     }
   }
-
-  keys[count] = key;
-  values[count] = value;
-  map->count = count + 1;
+  map->overflow_count = out;
+  if (map->overflow_count == 0) {
+    map->overflow_begin = 0;
+  }
 }
 
-template <bool strict_find>
-static void** find(grpc_chttp2_stream_map* map, uint32_t key) {
-  size_t min_idx = 0;
-  size_t max_idx = map->count;
-  size_t mid_idx;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
-  uint32_t mid_key;
-
-  GPR_DEBUG_ASSERT(!strict_find || max_idx > 0);
-  if (!strict_find && max_idx == 0) return nullptr;
+/* move the window forward to start at new_base: the entries it leaves behind
+   go to the overflow */
+static void slide(grpc_chttp2_stream_map* map, uint64_t new_base) {
+  uint64_t end = GPR_MIN(new_base, map->base + map->capacity);
+  for (uint64_t index = map->base; index < end && map->ring_count > 0;
+       index++) {
+    grpc_chttp2_stream_map_entry* slot = ring_slot(map, index);
+    if (slot->value != nullptr) {
+      overflow_insert(map, slot->key, slot->value);
+      slot->value = nullptr;
+      map->ring_count--;
+    }
+  }
+  map->base = new_base;
+}
 
-  while (min_idx < max_idx) {
-    /* find the midpoint, avoiding overflow */
-    mid_idx = min_idx + ((max_idx - min_idx) / 2);
-    mid_key = keys[mid_idx];
+void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
+                                void* value) {
+  // The first assertion ensures that the table is monotonically increasing.
+  GPR_ASSERT(grpc_chttp2_stream_map_size(map) == 0 || map->last_key < key);
+  GPR_DEBUG_ASSERT(value);
+  // Asserting that the key is not already in the map can be a debug assertion:
+  // re-adding a key would already fail the first one.
+  GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
 
-    if (mid_key < key) {
-      min_idx = mid_idx + 1;
-    } else if (mid_key > key) {
-      max_idx = mid_idx;
-    } else /* mid_key == key */
-    {
-      return &values[mid_idx];
+  const uint64_t index = key >> 1;
+  if (map->ring_count == 0) {
+    map->base = index;
+  }
+  while (index >= map->base + map->capacity) {
+    /* grow rather than slide if that keeps many live entries in the ring */
+    if (map->ring_count >= map->capacity / 2 &&
+        index < map->base + 2 * map->capacity) {
+      grow(map);
+    } else {
+      slide(map, index - map->capacity + 1);
     }
   }
-
-  GPR_DEBUG_ASSERT(!strict_find);
-  return nullptr;
+  place(map, key, value);
+  map->last_key = key;
 }
 
 void* grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<true>(map, key);
-  GPR_DEBUG_ASSERT(pvalue != nullptr);
-  void* out = *pvalue;
-  GPR_DEBUG_ASSERT(out != nullptr);
-  *pvalue = nullptr;
-  map->free++;
-  /* recognize complete emptyness and ensure we can skip
-     defragmentation later */
-  if (map->free == map->count) {
-    map->free = map->count = 0;
+  void* out = nullptr;
+  const uint64_t index = key >> 1;
+  grpc_chttp2_stream_map_entry* slot = ring_slot(map, index);
+  if (in_window(map, index) && slot->value != nullptr && slot->key == key) {
+    out = slot->value;
+    slot->value = nullptr;
+    map->ring_count--;
+  } else {
+    grpc_chttp2_stream_map_entry* entries = overflow_entries(map);
+    size_t idx = overflow_lower_bound(map, key);
+    if (idx < map->overflow_count && entries[idx].key == key) {
+      out = entries[idx].value;
+      overflow_remove(map, idx);
+    }
   }
+  GPR_DEBUG_ASSERT(out != nullptr);
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
   return out;
 }
 
 void* grpc_chttp2_stream_map_find(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<false>(map, key);
-  return pvalue != nullptr ? *pvalue : nullptr;
+  const uint64_t index = key >> 1;
+  if (in_window(map, index)) {
+    grpc_chttp2_stream_map_entry* slot = ring_slot(map, index);
+    if (slot->value != nullptr && slot->key == key) return slot->value;
+  }
+  if (map->overflow_count > 0) {
+    grpc_chttp2_stream_map_entry* entries = overflow_entries(map);
+    size_t idx = overflow_lower_bound(map, key);
+    if (idx < map->overflow_count && entries[idx].key == key) {
+      return entries[idx].value;
+    }
+  }
+  return nullptr;
 }
 
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map) {
-  return map->count - map->free;
+  return map->ring_count + map->overflow_count;
 }
 
 void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map) {
-  if (map->count == map->free) {
+  size_t count = grpc_chttp2_stream_map_size(map);
+  if (count == 0) {
     return nullptr;
   }
-  if (map->free != 0) {
-    map->count = compact(map->keys, map->values, map->count);
-    map->free = 0;
-    GPR_ASSERT(map->count > 0);
+  size_t r = static_cast<size_t>(rand()) % count;
+  if (r < map->overflow_count) {
+    return overflow_entries(map)[r].value;
+  }
+  /* the ring has holes: take the first entry from a random slot on */
+  for (size_t i = 0; i < map->capacity; i++) {
+    grpc_chttp2_stream_map_entry* slot = &map->ring[(r + i) % map->capacity];
+    if (slot->value != nullptr) return slot->value;
+  }
+  GPR_UNREACHABLE_CODE(return nullptr);
+}
+
+/* call f on the overflow entries with keys in [*next, end), moving *next past
+   them; looked up one by one, as f may delete entries */
+static void for_each_overflow(grpc_chttp2_stream_map* map, uint64_t* next,
+                              uint64_t end,
+                              void (*f)(void* user_data, uint32_t key,
+                                        void* value),
+                              void* user_data) {
+  while (map->overflow_count > 0) {
+    size_t idx = overflow_lower_bound(map, *next);
+    if (idx == map->overflow_count || overflow_entries(map)[idx].key >= end) {
+      return;
+    }
+    grpc_chttp2_stream_map_entry entry = overflow_entries(map)[idx];
+    *next = static_cast<uint64_t>(entry.key) + 1;
+    f(user_data, entry.key, entry.value);
   }
-  return map->values[(static_cast<size_t>(rand())) % map->count];
 }
 
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
                                      void* user_data) {
-  size_t i;
-
-  for (i = 0; i < map->count; i++) {
-    if (map->values[i]) {
-      f(user_data, map->keys[i], map->values[i]);
+  uint64_t next = 0;
+  const uint64_t end = map->base + map->capacity;
+  /* ring slots are in key order from the base of the window on */
+  for (uint64_t index = map->base; index < end && map->ring_count > 0;
+       index++) {
+    grpc_chttp2_stream_map_entry* slot = ring_slot(map, index);
+    if (slot->value == nullptr) continue;
+    const uint32_t key = slot->key;
+    for_each_overflow(map, &next, key, f, user_data);
+    if (slot->value != nullptr && slot->key == key) {
+      next = static_cast<uint64_t>(key) + 1;
+      f(user_data, key, slot->value);
     }
   }
+  for_each_overflow(map, &next, UINT64_MAX, f, user_data);
 }
@@ -22,19 +22,38 @@
 #include <grpc/support/port_platform.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 /* Data structure to map a uint32_t to a data object (represented by a void*)
 
-   Represented as a sorted array of keys, and a corresponding array of values.
-   Lookups are performed with binary search.
    Adds are restricted to strictly higher keys than previously seen (this is
-   guaranteed by http2). */
+   guaranteed by http2), and the keys of one peer's streams all have the same
+   parity. Entries are therefore kept in a direct-mapped ring indexed by
+   (key >> 1) modulo its (power of two) capacity, which covers the window
+   [base, base + capacity) of indices: lookups and deletions are O(1), and
+   deletions leave nothing behind to compact.
+   Adding a key past the window slides it forward. Streams that the window
+   leaves behind (long lived ones), and keys that share an index with a live
+   one, are kept in a small overflow array sorted by key, and searched with
+   binary search. The ring doubles instead of sliding when at least half of it
+   is live. */
+struct grpc_chttp2_stream_map_entry {
+  uint32_t key;
+  void* value;
+};
+
 struct grpc_chttp2_stream_map {
-  uint32_t* keys;
-  void** values;
-  size_t count;
-  size_t free;
+  grpc_chttp2_stream_map_entry* ring;
   size_t capacity;
+  /* index (key >> 1) of the first slot of the window */
+  uint64_t base;
+  size_t ring_count;
+  /* the overflow entries are overflow[overflow_begin, +overflow_count) */
+  grpc_chttp2_stream_map_entry* overflow;
+  size_t overflow_begin;
+  size_t overflow_count;
+  size_t overflow_capacity;
+  uint32_t last_key;
 };
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity);
@@ -58,7 +77,8 @@ void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map);
 /* How many (populated) entries are in the stream map? */
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map);
 
-/* Callback on each stream */
+/* Callback on each stream, in increasing key order. The callback may delete
+   entries, but not add them */
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
@@ -0,0 +1,77 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chttp2/transport/write_scheduler.h"
+
+#include "absl/memory/memory.h"
+
+#include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/lib/gpr/useful.h"
+
+namespace grpc_core {
+namespace chttp2 {
+
+constexpr uint32_t WriteScheduler::kMaxWeight;
+constexpr int64_t WeightedFairWriteScheduler::kQuantum;
+constexpr int64_t WeightedFairWriteScheduler::kPriorityBytes;
+
+std::unique_ptr<WriteScheduler> WriteScheduler::Create(Type type) {
+  switch (type) {
+    case Type::kWeightedFair:
+      return absl::make_unique<WeightedFairWriteScheduler>();
+    case Type::kFifo:
+      break;
+  }
+  return absl::make_unique<FifoWriteScheduler>();
+}
+
+bool WeightedFairWriteScheduler::IsPriority(const grpc_chttp2_stream* s) {
+  /* a message still being fetched is not known to be small */
+  if (s->fetching_send_message != nullptr) return false;
+  int64_t pending = s->flow_controlled_buffer.length;
+  if (s->stream_compression_method !=
+      GRPC_STREAM_COMPRESSION_IDENTITY_COMPRESS) {
+    pending += s->compressed_data_buffer.length;
+  }
+  return pending <= kPriorityBytes;
+}
+
+int64_t WeightedFairWriteScheduler::BeginTurn(grpc_chttp2_stream* s) {
+  /* a stream that got to the priority list with a small message only gets
+     to write that much before it goes to the back of the regular list */
+  if (IsPriority(s)) return kPriorityBytes;
+  s->write_deficit += kQuantum * s->write_weight;
+  return s->write_deficit;
+}
+
+void WeightedFairWriteScheduler::EndTurn(grpc_chttp2_stream* s, int64_t sent,
+                                         bool more) {
+  if (!more) {
+    s->write_deficit = 0;
+    return;
+  }
+  /* what flow control kept the stream from writing carries over, but not
+     more than a turn's worth, so that it doesn't burst once unstalled */
+  s->write_deficit = GPR_CLAMP(s->write_deficit - sent, int64_t(0),
+                               kQuantum * s->write_weight);
+}
+
+}  // namespace chttp2
+}  // namespace grpc_core
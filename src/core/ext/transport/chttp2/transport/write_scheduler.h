@@ -0,0 +1,103 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_WRITE_SCHEDULER_H
+#define GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_WRITE_SCHEDULER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <memory>
+
+struct grpc_chttp2_stream;
+
+namespace grpc_core {
+namespace chttp2 {
+
+// Decides how the streams of a transport that have data to write share the
+// connection. Writable streams wait in two lists: the priority one, which is
+// always served first, and the regular one. Each time a stream reaches the
+// head of its list it gets a turn, in which it may write up to the budget the
+// scheduler gives it; if it has data left after its turn, it goes to the back
+// of a list again.
+class WriteScheduler {
+ public:
+  // Schedulers selectable with GRPC_ARG_HTTP2_WRITE_SCHEDULER
+  enum class Type { kFifo, kWeightedFair };
+
+  // Largest stream weight, as set by GRPC_HTTP2_WRITE_WEIGHT_MD_KEY
+  static constexpr uint32_t kMaxWeight = 256;
+
+  virtual ~WriteScheduler() {}
+
+  static std::unique_ptr<WriteScheduler> Create(Type type);
+
+  // Returns true if \a s, which has just become writable, goes to the
+  // priority list
+  virtual bool IsPriority(const grpc_chttp2_stream* s) = 0;
+
+  // Starts a turn of \a s: returns how many bytes of data it may write in it
+  virtual int64_t BeginTurn(grpc_chttp2_stream* s) = 0;
+
+  // Ends the turn of \a s, in which it wrote \a sent bytes of data. \a more is
+  // true if it still has data to write.
+  virtual void EndTurn(grpc_chttp2_stream* s, int64_t sent, bool more) = 0;
+
+  virtual const char* name() const = 0;
+};
+
+// Streams write in the order they became writable, each as much as flow
+// control allows in a turn.
+class FifoWriteScheduler final : public WriteScheduler {
+ public:
+  bool IsPriority(const grpc_chttp2_stream* /*s*/) override { return false; }
+
+  int64_t BeginTurn(grpc_chttp2_stream* /*s*/) override { return INT64_MAX; }
+
+  void EndTurn(grpc_chttp2_stream* /*s*/, int64_t /*sent*/,
+               bool /*more*/) override {}
+
+  const char* name() const override { return "fifo"; }
+};
+
+// Weighted fair queuing, as deficit round robin over bytes: each turn adds
+// kQuantum times the weight of the stream to its deficit, and the stream may
+// write that much, keeping what it does not use (up to one quantum) for its
+// next turn. Streams with no more than one small message to send are in the
+// priority list, so that unary calls are not held up behind bulk streams.
+class WeightedFairWriteScheduler final : public WriteScheduler {
+ public:
+  // Bytes of data a stream of weight 1 may write per round
+  static constexpr int64_t kQuantum = 16384;
+  // Streams with at most that much data left to send are prioritized
+  static constexpr int64_t kPriorityBytes = 16384;
+
+  bool IsPriority(const grpc_chttp2_stream* s) override;
+
+  int64_t BeginTurn(grpc_chttp2_stream* s) override;
+
+  void EndTurn(grpc_chttp2_stream* s, int64_t sent, bool more) override;
+
+  const char* name() const override { return "wfq"; }
+};
+
+}  // namespace chttp2
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_WRITE_SCHEDULER_H */
@@ -332,11 +332,20 @@ class DataSendContext {
   uint32_t max_outgoing() const {
     return static_cast<uint32_t> GPR_MIN(
         t_->settings[GRPC_PEER_SETTINGS][GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],
-        GPR_MIN(stream_remote_window(), t_->flow_control->remote_window()));
+        GPR_MIN(GPR_MIN(stream_remote_window(),
+                        t_->flow_control->remote_window()),
+                turn_budget_ - turn_sent_));
   }
 
   bool AnyOutgoing() const { return max_outgoing() > 0; }
 
+  // Limits what is sent from now on to the stream's turn at writing
+  void BeginTurn() { turn_budget_ = t_->write_scheduler->BeginTurn(s_); }
+
+  void EndTurn(bool more) {
+    t_->write_scheduler->EndTurn(s_, turn_sent_, more);
+  }
+
   void FlushUncompressedBytes() {
     uint32_t send_bytes = static_cast<uint32_t> GPR_MIN(
         max_outgoing(), s_->flow_controlled_buffer.length);
@@ -348,6 +357,7 @@ class DataSendContext {
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
     s_->flow_control->SentData(send_bytes);
     s_->sending_bytes += send_bytes;
+    turn_sent_ += send_bytes;
   }
 
   void FlushCompressedBytes() {
@@ -382,6 +392,7 @@ class DataSendContext {
     grpc_chttp2_encode_data(s_->id, &s_->compressed_data_buffer, send_bytes,
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
     s_->flow_control->SentData(send_bytes);
+    turn_sent_ += send_bytes;
     if (s_->compressed_data_buffer.length == 0) {
       s_->sending_bytes += s_->uncompressed_data_size;
     }
@@ -422,6 +433,8 @@ class DataSendContext {
   grpc_chttp2_stream* s_;
   const size_t sending_bytes_before_;
   bool is_last_frame_ = false;
+  int64_t turn_budget_ = INT64_MAX;
+  int64_t turn_sent_ = 0;
 };
 
 class StreamWriteContext {
@@ -517,6 +530,7 @@ class StreamWriteContext {
       return;  // early out: nothing to do
     }
 
+    data_send_context.BeginTurn();
     if (s_->stream_compression_method ==
         GRPC_STREAM_COMPRESSION_IDENTITY_COMPRESS) {
       while (s_->flow_controlled_buffer.length > 0 &&
@@ -540,10 +554,11 @@ class StreamWriteContext {
     }
     data_send_context.CallCallbacks();
     stream_became_writable_ = true;
-    if (s_->flow_controlled_buffer.length > 0 ||
-        compressed_data_buffer_len() > 0) {
+    const bool more = s_->flow_controlled_buffer.length > 0 ||
+                      compressed_data_buffer_len() > 0;
+    data_send_context.EndTurn(more);
+    if (more && grpc_chttp2_list_add_writable_stream(t_, s_)) {
       GRPC_CHTTP2_STREAM_REF(s_, "chttp2_writing:fork");
-      grpc_chttp2_list_add_writable_stream(t_, s_);
     }
     write_context_->IncMessageWrites();
   }
@@ -29,6 +29,7 @@
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/serializer_profiler.h"
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -268,3 +269,7 @@ char* grpc_channelz_get_socket(intptr_t socket_id) {
   };
   return gpr_strdup(json.Dump().c_str());
 }
+
+char* grpc_channelz_get_serializer_profile(void) {
+  return gpr_strdup(grpc_core::RenderSerializerProfiles().Dump().c_str());
+}
@@ -41,6 +41,7 @@ typedef enum {
   GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_FD,
   GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_CV,
   GRPC_STATS_COUNTER_POLLSET_KICK_OWN_THREAD,
+  GRPC_STATS_COUNTER_POLLSET_KICK_SPINNING,
   GRPC_STATS_COUNTER_SYSCALL_EPOLL_CTL,
   GRPC_STATS_COUNTER_POLLSET_FD_CACHE_HITS,
   GRPC_STATS_COUNTER_HISTOGRAM_SLOW_LOOKUPS,
@@ -48,6 +49,8 @@ typedef enum {
   GRPC_STATS_COUNTER_SYSCALL_READ,
   GRPC_STATS_COUNTER_TCP_BACKUP_POLLERS_CREATED,
   GRPC_STATS_COUNTER_TCP_BACKUP_POLLER_POLLS,
+  GRPC_STATS_COUNTER_TCP_IDLE_READ_BUFFERS_RELEASED,
+  GRPC_STATS_COUNTER_TCP_IDLE_READ_BUFFERS_REALLOCATED,
   GRPC_STATS_COUNTER_HTTP2_OP_BATCHES,
   GRPC_STATS_COUNTER_HTTP2_OP_CANCEL,
   GRPC_STATS_COUNTER_HTTP2_OP_SEND_INITIAL_METADATA,
@@ -62,6 +65,7 @@ typedef enum {
   GRPC_STATS_COUNTER_HTTP2_WRITES_OFFLOADED,
   GRPC_STATS_COUNTER_HTTP2_WRITES_CONTINUED,
   GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES,
+  GRPC_STATS_COUNTER_HTTP2_WRITES_COALESCED,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_START_NEW_STREAM,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_SEND_MESSAGE,
@@ -84,6 +88,7 @@ typedef enum {
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_PING_RESPONSE,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_FORCE_RST_STREAM,
   GRPC_STATS_COUNTER_HTTP2_SPURIOUS_WRITES_BEGUN,
+  GRPC_STATS_COUNTER_HTTP2_IDLE_PARSER_BUFFERS_RELEASED,
   GRPC_STATS_COUNTER_HPACK_RECV_INDEXED,
   GRPC_STATS_COUNTER_HPACK_RECV_LITHDR_INCIDX,
   GRPC_STATS_COUNTER_HPACK_RECV_LITHDR_INCIDX_V,
@@ -132,6 +137,8 @@ extern const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT];
 typedef enum {
   GRPC_STATS_HISTOGRAM_CALL_INITIAL_SIZE,
   GRPC_STATS_HISTOGRAM_POLL_EVENTS_RETURNED,
+  GRPC_STATS_HISTOGRAM_POLLSET_SPIN_TIME,
+  GRPC_STATS_HISTOGRAM_POLLSET_WAKEUP_LATENCY,
   GRPC_STATS_HISTOGRAM_TCP_WRITE_SIZE,
   GRPC_STATS_HISTOGRAM_TCP_WRITE_IOV_SIZE,
   GRPC_STATS_HISTOGRAM_TCP_READ_SIZE,
@@ -142,6 +149,14 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_BATCH_SIZE,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_REQUESTS_PER_WRITE,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DEPTH,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_TIME,
+  GRPC_STATS_HISTOGRAM_COMBINER_EXEC_TIME,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_TIME,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_EXEC_TIME,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
   GRPC_STATS_HISTOGRAM_COUNT
 } grpc_stats_histograms;
@@ -152,29 +167,49 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_CALL_INITIAL_SIZE_BUCKETS = 64,
   GRPC_STATS_HISTOGRAM_POLL_EVENTS_RETURNED_FIRST_SLOT = 64,
   GRPC_STATS_HISTOGRAM_POLL_EVENTS_RETURNED_BUCKETS = 128,
-  GRPC_STATS_HISTOGRAM_TCP_WRITE_SIZE_FIRST_SLOT = 192,
+  GRPC_STATS_HISTOGRAM_POLLSET_SPIN_TIME_FIRST_SLOT = 192,
+  GRPC_STATS_HISTOGRAM_POLLSET_SPIN_TIME_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_POLLSET_WAKEUP_LATENCY_FIRST_SLOT = 256,
+  GRPC_STATS_HISTOGRAM_POLLSET_WAKEUP_LATENCY_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_TCP_WRITE_SIZE_FIRST_SLOT = 320,
   GRPC_STATS_HISTOGRAM_TCP_WRITE_SIZE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_TCP_WRITE_IOV_SIZE_FIRST_SLOT = 256,
+  GRPC_STATS_HISTOGRAM_TCP_WRITE_IOV_SIZE_FIRST_SLOT = 384,
   GRPC_STATS_HISTOGRAM_TCP_WRITE_IOV_SIZE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_TCP_READ_SIZE_FIRST_SLOT = 320,
+  GRPC_STATS_HISTOGRAM_TCP_READ_SIZE_FIRST_SLOT = 448,
   GRPC_STATS_HISTOGRAM_TCP_READ_SIZE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_FIRST_SLOT = 384,
+  GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_FIRST_SLOT = 512,
   GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_IOV_SIZE_FIRST_SLOT = 448,
+  GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_IOV_SIZE_FIRST_SLOT = 576,
   GRPC_STATS_HISTOGRAM_TCP_READ_OFFER_IOV_SIZE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_SIZE_FIRST_SLOT = 512,
+  GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_SIZE_FIRST_SLOT = 640,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_SIZE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_HTTP2_SEND_INITIAL_METADATA_PER_WRITE_FIRST_SLOT = 576,
+  GRPC_STATS_HISTOGRAM_HTTP2_SEND_INITIAL_METADATA_PER_WRITE_FIRST_SLOT = 704,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_INITIAL_METADATA_PER_WRITE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_PER_WRITE_FIRST_SLOT = 640,
+  GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_PER_WRITE_FIRST_SLOT = 768,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_PER_WRITE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE_FIRST_SLOT = 704,
+  GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE_FIRST_SLOT = 832,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_FIRST_SLOT = 768,
+  GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_FIRST_SLOT = 896,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 832,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_BATCH_SIZE_FIRST_SLOT = 960,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_BATCH_SIZE_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_REQUESTS_PER_WRITE_FIRST_SLOT = 1024,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_REQUESTS_PER_WRITE_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DEPTH_FIRST_SLOT = 1088,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DEPTH_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_TIME_FIRST_SLOT = 1152,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_TIME_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_COMBINER_EXEC_TIME_FIRST_SLOT = 1216,
+  GRPC_STATS_HISTOGRAM_COMBINER_EXEC_TIME_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH_FIRST_SLOT = 1280,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_TIME_FIRST_SLOT = 1344,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_TIME_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_EXEC_TIME_FIRST_SLOT = 1408,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_EXEC_TIME_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 1472,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_BUCKETS = 8,
-  GRPC_STATS_HISTOGRAM_BUCKETS = 840
+  GRPC_STATS_HISTOGRAM_BUCKETS = 1480
 } grpc_stats_histogram_constants;
 #if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED() \
@@ -205,6 +240,8 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_CV)
 #define GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK_OWN_THREAD)
+#define GRPC_STATS_INC_POLLSET_KICK_SPINNING() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK_SPINNING)
 #define GRPC_STATS_INC_SYSCALL_EPOLL_CTL() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SYSCALL_EPOLL_CTL)
 #define GRPC_STATS_INC_POLLSET_FD_CACHE_HITS() \
@@ -219,6 +256,10 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BACKUP_POLLERS_CREATED)
 #define GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BACKUP_POLLER_POLLS)
+#define GRPC_STATS_INC_TCP_IDLE_READ_BUFFERS_RELEASED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_IDLE_READ_BUFFERS_RELEASED)
+#define GRPC_STATS_INC_TCP_IDLE_READ_BUFFERS_REALLOCATED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_IDLE_READ_BUFFERS_REALLOCATED)
 #define GRPC_STATS_INC_HTTP2_OP_BATCHES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_OP_BATCHES)
 #define GRPC_STATS_INC_HTTP2_OP_CANCEL() \
@@ -247,6 +288,8 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_CONTINUED)
 #define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES)
+#define GRPC_STATS_INC_HTTP2_WRITES_COALESCED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_COALESCED)
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE() \
   GRPC_STATS_INC_COUNTER(                                          \
       GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE)
@@ -312,6 +355,8 @@ typedef enum {
       GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_FORCE_RST_STREAM)
 #define GRPC_STATS_INC_HTTP2_SPURIOUS_WRITES_BEGUN() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_SPURIOUS_WRITES_BEGUN)
+#define GRPC_STATS_INC_HTTP2_IDLE_PARSER_BUFFERS_RELEASED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_IDLE_PARSER_BUFFERS_RELEASED)
 #define GRPC_STATS_INC_HPACK_RECV_INDEXED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_RECV_INDEXED)
 #define GRPC_STATS_INC_HPACK_RECV_LITHDR_INCIDX() \
@@ -401,6 +446,12 @@ void grpc_stats_inc_call_initial_size(int value);
 #define GRPC_STATS_INC_POLL_EVENTS_RETURNED(value) \
   grpc_stats_inc_poll_events_returned((int)(value))
 void grpc_stats_inc_poll_events_returned(int value);
+#define GRPC_STATS_INC_POLLSET_SPIN_TIME(value) \
+  grpc_stats_inc_pollset_spin_time((int)(value))
+void grpc_stats_inc_pollset_spin_time(int value);
+#define GRPC_STATS_INC_POLLSET_WAKEUP_LATENCY(value) \
+  grpc_stats_inc_pollset_wakeup_latency((int)(value))
+void grpc_stats_inc_pollset_wakeup_latency(int value);
 #define GRPC_STATS_INC_TCP_WRITE_SIZE(value) \
   grpc_stats_inc_tcp_write_size((int)(value))
 void grpc_stats_inc_tcp_write_size(int value);
@@ -431,6 +482,30 @@ void grpc_stats_inc_http2_send_trailing_metadata_per_write(int value);
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value) \
   grpc_stats_inc_http2_send_flowctl_per_write((int)(value))
 void grpc_stats_inc_http2_send_flowctl_per_write(int value);
+#define GRPC_STATS_INC_HTTP2_WRITE_BATCH_SIZE(value) \
+  grpc_stats_inc_http2_write_batch_size((int)(value))
+void grpc_stats_inc_http2_write_batch_size(int value);
+#define GRPC_STATS_INC_HTTP2_WRITE_REQUESTS_PER_WRITE(value) \
+  grpc_stats_inc_http2_write_requests_per_write((int)(value))
+void grpc_stats_inc_http2_write_requests_per_write(int value);
+#define GRPC_STATS_INC_COMBINER_QUEUE_DEPTH(value) \
+  grpc_stats_inc_combiner_queue_depth((int)(value))
+void grpc_stats_inc_combiner_queue_depth(int value);
+#define GRPC_STATS_INC_COMBINER_QUEUE_TIME(value) \
+  grpc_stats_inc_combiner_queue_time((int)(value))
+void grpc_stats_inc_combiner_queue_time(int value);
+#define GRPC_STATS_INC_COMBINER_EXEC_TIME(value) \
+  grpc_stats_inc_combiner_exec_time((int)(value))
+void grpc_stats_inc_combiner_exec_time(int value);
+#define GRPC_STATS_INC_WORK_SERIALIZER_QUEUE_DEPTH(value) \
+  grpc_stats_inc_work_serializer_queue_depth((int)(value))
+void grpc_stats_inc_work_serializer_queue_depth(int value);
+#define GRPC_STATS_INC_WORK_SERIALIZER_QUEUE_TIME(value) \
+  grpc_stats_inc_work_serializer_queue_time((int)(value))
+void grpc_stats_inc_work_serializer_queue_time(int value);
+#define GRPC_STATS_INC_WORK_SERIALIZER_EXEC_TIME(value) \
+  grpc_stats_inc_work_serializer_exec_time((int)(value))
+void grpc_stats_inc_work_serializer_exec_time(int value);
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value) \
   grpc_stats_inc_server_cqs_checked((int)(value))
 void grpc_stats_inc_server_cqs_checked(int value);
@@ -449,6 +524,7 @@ void grpc_stats_inc_server_cqs_checked(int value);
 #define GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD()
 #define GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV()
 #define GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD()
+#define GRPC_STATS_INC_POLLSET_KICK_SPINNING()
 #define GRPC_STATS_INC_SYSCALL_EPOLL_CTL()
 #define GRPC_STATS_INC_POLLSET_FD_CACHE_HITS()
 #define GRPC_STATS_INC_HISTOGRAM_SLOW_LOOKUPS()
@@ -456,6 +532,8 @@ void grpc_stats_inc_server_cqs_checked(int value);
 #define GRPC_STATS_INC_SYSCALL_READ()
 #define GRPC_STATS_INC_TCP_BACKUP_POLLERS_CREATED()
 #define GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS()
+#define GRPC_STATS_INC_TCP_IDLE_READ_BUFFERS_RELEASED()
+#define GRPC_STATS_INC_TCP_IDLE_READ_BUFFERS_REALLOCATED()
 #define GRPC_STATS_INC_HTTP2_OP_BATCHES()
 #define GRPC_STATS_INC_HTTP2_OP_CANCEL()
 #define GRPC_STATS_INC_HTTP2_OP_SEND_INITIAL_METADATA()
@@ -470,6 +548,7 @@ void grpc_stats_inc_server_cqs_checked(int value);
 #define GRPC_STATS_INC_HTTP2_WRITES_OFFLOADED()
 #define GRPC_STATS_INC_HTTP2_WRITES_CONTINUED()
 #define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES()
+#define GRPC_STATS_INC_HTTP2_WRITES_COALESCED()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_START_NEW_STREAM()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_SEND_MESSAGE()
@@ -492,6 +571,7 @@ void grpc_stats_inc_server_cqs_checked(int value);
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_PING_RESPONSE()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_FORCE_RST_STREAM()
 #define GRPC_STATS_INC_HTTP2_SPURIOUS_WRITES_BEGUN()
+#define GRPC_STATS_INC_HTTP2_IDLE_PARSER_BUFFERS_RELEASED()
 #define GRPC_STATS_INC_HPACK_RECV_INDEXED()
 #define GRPC_STATS_INC_HPACK_RECV_LITHDR_INCIDX()
 #define GRPC_STATS_INC_HPACK_RECV_LITHDR_INCIDX_V()
@@ -535,6 +615,8 @@ void grpc_stats_inc_server_cqs_checked(int value);
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES()
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(value)
 #define GRPC_STATS_INC_POLL_EVENTS_RETURNED(value)
+#define GRPC_STATS_INC_POLLSET_SPIN_TIME(value)
+#define GRPC_STATS_INC_POLLSET_WAKEUP_LATENCY(value)
 #define GRPC_STATS_INC_TCP_WRITE_SIZE(value)
 #define GRPC_STATS_INC_TCP_WRITE_IOV_SIZE(value)
 #define GRPC_STATS_INC_TCP_READ_SIZE(value)
@@ -545,11 +627,19 @@ void grpc_stats_inc_server_cqs_checked(int value);
 #define GRPC_STATS_INC_HTTP2_SEND_MESSAGE_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_TRAILING_METADATA_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value)
+#define GRPC_STATS_INC_HTTP2_WRITE_BATCH_SIZE(value)
+#define GRPC_STATS_INC_HTTP2_WRITE_REQUESTS_PER_WRITE(value)
+#define GRPC_STATS_INC_COMBINER_QUEUE_DEPTH(value)
+#define GRPC_STATS_INC_COMBINER_QUEUE_TIME(value)
+#define GRPC_STATS_INC_COMBINER_EXEC_TIME(value)
+#define GRPC_STATS_INC_WORK_SERIALIZER_QUEUE_DEPTH(value)
+#define GRPC_STATS_INC_WORK_SERIALIZER_QUEUE_TIME(value)
+#define GRPC_STATS_INC_WORK_SERIALIZER_EXEC_TIME(value)
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value)
 #endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
-extern const int grpc_stats_histo_buckets[13];
-extern const int grpc_stats_histo_start[13];
-extern const int* const grpc_stats_histo_bucket_boundaries[13];
-extern void (*const grpc_stats_inc_histogram[13])(int x);
+extern const int grpc_stats_histo_buckets[23];
+extern const int grpc_stats_histo_start[23];
+extern const int* const grpc_stats_histo_bucket_boundaries[23];
+extern void (*const grpc_stats_inc_histogram[23])(int x);
 
 #endif /* GRPC_CORE_LIB_DEBUG_STATS_DATA_H */
@@ -25,25 +25,118 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
 #include "src/core/lib/gpr/alloc.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
 
 namespace {
 
-void* ArenaStorage(size_t initial_size) {
+// Arena memory (an arena with its initial zone, or an additional zone) is
+// handed out in these block sizes, so that blocks freed by destroyed arenas
+// can be reused by new ones. Calls of a channel request about the same initial
+// size (see grpc_channel_get_call_size_estimate()), so they keep hitting the
+// same class. Classes grow by at most 1.5x to bound the wasted tail; larger
+// blocks are not pooled.
+constexpr size_t kBlockSizeClasses[] = {1024,  1536,  2048,  3072,  4096,
+                                        6144,  8192,  12288, 16384, 24576,
+                                        32768, 49152, 65536};
+constexpr int kNumBlockSizeClasses = GPR_ARRAY_SIZE(kBlockSizeClasses);
+constexpr size_t kMaxShards = 16;
+// Upper bound on the bytes of free blocks that a shard keeps.
+constexpr size_t kMaxCachedBytesPerShard = 1024 * 1024;
+constexpr size_t kBlockAlignment = (GPR_CACHELINE_SIZE > GPR_MAX_ALIGNMENT &&
+                                    GPR_CACHELINE_SIZE % GPR_MAX_ALIGNMENT == 0)
+                                       ? GPR_CACHELINE_SIZE
+                                       : GPR_MAX_ALIGNMENT;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+// Free blocks are cached per CPU: the thread that destroys a call usually
+// creates the next one, and gets a block that is still in its cache.
+struct alignas(GPR_CACHELINE_SIZE) Shard {
+  gpr_mu mu;
+  FreeBlock* free_blocks[kNumBlockSizeClasses];
+  size_t cached_bytes;
+};
+
+gpr_once g_once = GPR_ONCE_INIT;
+Shard g_shards[kMaxShards];
+size_t g_num_shards;
+
+void InitShards() {
+  g_num_shards = GPR_CLAMP(gpr_cpu_num_cores(), 1, kMaxShards);
+  for (size_t i = 0; i < g_num_shards; i++) {
+    gpr_mu_init(&g_shards[i].mu);
+    for (int c = 0; c < kNumBlockSizeClasses; c++) {
+      g_shards[i].free_blocks[c] = nullptr;
+    }
+    g_shards[i].cached_bytes = 0;
+  }
+}
+
+Shard* CurrentShard() {
+  gpr_once_init(&g_once, InitShards);
+  return &g_shards[gpr_cpu_current_cpu() % g_num_shards];
+}
+
+// Returns a block of at least \a *size bytes, and updates \a *size to the
+// usable size of the block. Sets \a *size_class to the class to pass to
+// FreeArenaBlock().
+void* AllocArenaBlock(size_t* size, int* size_class) {
+  int c = 0;
+  while (c < kNumBlockSizeClasses && kBlockSizeClasses[c] < *size) c++;
+  if (c == kNumBlockSizeClasses) {
+    *size_class = -1;
+    return gpr_malloc_aligned(*size, kBlockAlignment);
+  }
+  *size_class = c;
+  *size = kBlockSizeClasses[c];
+  Shard* shard = CurrentShard();
+  gpr_mu_lock(&shard->mu);
+  FreeBlock* block = shard->free_blocks[c];
+  if (block != nullptr) {
+    shard->free_blocks[c] = block->next;
+    shard->cached_bytes -= kBlockSizeClasses[c];
+  }
+  gpr_mu_unlock(&shard->mu);
+  if (block == nullptr) {
+    return gpr_malloc_aligned(kBlockSizeClasses[c], kBlockAlignment);
+  }
+  return block;
+}
+
+void FreeArenaBlock(void* block, int size_class) {
+  if (size_class >= 0) {
+    Shard* shard = CurrentShard();
+    gpr_mu_lock(&shard->mu);
+    if (shard->cached_bytes + kBlockSizeClasses[size_class] <=
+        kMaxCachedBytesPerShard) {
+      FreeBlock* free_block = static_cast<FreeBlock*>(block);
+      free_block->next = shard->free_blocks[size_class];
+      shard->free_blocks[size_class] = free_block;
+      shard->cached_bytes += kBlockSizeClasses[size_class];
+      block = nullptr;
+    }
+    gpr_mu_unlock(&shard->mu);
+  }
+  if (block != nullptr) gpr_free_aligned(block);
+}
+
+// Allocates the memory of an arena whose initial zone holds at least
+// \a *initial_size bytes, and updates \a *initial_size to what it can hold.
+void* ArenaStorage(size_t* initial_size, int* size_class) {
   static constexpr size_t base_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(grpc_core::Arena));
-  initial_size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
-  size_t alloc_size = base_size + initial_size;
-  static constexpr size_t alignment =
-      (GPR_CACHELINE_SIZE > GPR_MAX_ALIGNMENT &&
-       GPR_CACHELINE_SIZE % GPR_MAX_ALIGNMENT == 0)
-          ? GPR_CACHELINE_SIZE
-          : GPR_MAX_ALIGNMENT;
-  return gpr_malloc_aligned(alloc_size, alignment);
+  size_t alloc_size = base_size + GPR_ROUND_UP_TO_ALIGNMENT_SIZE(*initial_size);
+  void* storage = AllocArenaBlock(&alloc_size, size_class);
+  *initial_size = alloc_size - base_size;
+  return storage;
 }
 
 }  // namespace
@@ -54,33 +147,60 @@ Arena::~Arena() {
   Zone* z = last_zone_;
   while (z) {
     Zone* prev_z = z->prev;
+    const int size_class = z->size_class;
     z->~Zone();
-    gpr_free_aligned(z);
+    FreeArenaBlock(z, size_class);
     z = prev_z;
   }
 }
 
 Arena* Arena::Create(size_t initial_size) {
-  return new (ArenaStorage(initial_size)) Arena(initial_size);
+  int size_class;
+  void* storage = ArenaStorage(&initial_size, &size_class);
+  return new (storage) Arena(initial_size, size_class);
 }
 
 std::pair<Arena*, void*> Arena::CreateWithAlloc(size_t initial_size,
                                                 size_t alloc_size) {
   static constexpr size_t base_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
-  auto* new_arena =
-      new (ArenaStorage(initial_size)) Arena(initial_size, alloc_size);
+  int size_class;
+  void* storage = ArenaStorage(&initial_size, &size_class);
+  auto* new_arena = new (storage) Arena(initial_size, size_class, alloc_size);
   void* first_alloc = reinterpret_cast<char*>(new_arena) + base_size;
   return std::make_pair(new_arena, first_alloc);
 }
 
 size_t Arena::Destroy() {
   size_t size = total_used_.Load(MemoryOrder::RELAXED);
+  const int size_class = size_class_;
   this->~Arena();
-  gpr_free_aligned(this);
+  FreeArenaBlock(this, size_class);
   return size;
 }
 
+void Arena::ReleaseCachedBlocks() {
+  gpr_once_init(&g_once, InitShards);
+  for (size_t i = 0; i < g_num_shards; i++) {
+    Shard* shard = &g_shards[i];
+    FreeBlock* free_blocks[kNumBlockSizeClasses];
+    gpr_mu_lock(&shard->mu);
+    for (int c = 0; c < kNumBlockSizeClasses; c++) {
+      free_blocks[c] = shard->free_blocks[c];
+      shard->free_blocks[c] = nullptr;
+    }
+    shard->cached_bytes = 0;
+    gpr_mu_unlock(&shard->mu);
+    for (int c = 0; c < kNumBlockSizeClasses; c++) {
+      while (free_blocks[c] != nullptr) {
+        FreeBlock* next = free_blocks[c]->next;
+        gpr_free_aligned(free_blocks[c]);
+        free_blocks[c] = next;
+      }
+    }
+  }
+}
+
 void* Arena::AllocZone(size_t size) {
   // If the allocation isn't able to end in the initial zone, create a new
   // zone for this allocation, and any unused space in the initial zone is
@@ -90,7 +210,9 @@ void* Arena::AllocZone(size_t size) {
   static constexpr size_t zone_base_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Zone));
   size_t alloc_size = zone_base_size + size;
-  Zone* z = new (gpr_malloc_aligned(alloc_size, GPR_MAX_ALIGNMENT)) Zone();
+  int size_class;
+  Zone* z = new (AllocArenaBlock(&alloc_size, &size_class)) Zone();
+  z->size_class = size_class;
   {
     gpr_spinlock_lock(&arena_growth_spinlock_);
     z->prev = last_zone_;
@@ -54,6 +54,11 @@ class Arena {
 
   // Destroy an arena, returning the total number of bytes allocated.
   size_t Destroy();
+
+  // Frees the memory blocks that destroyed arenas left cached for reuse.
+  // Called under memory pressure and at shutdown; blocks freed afterwards are
+  // cached again.
+  static void ReleaseCachedBlocks();
   // Allocate \a size bytes from the arena.
   void* Alloc(size_t size) {
     static constexpr size_t base_size =
@@ -81,6 +86,8 @@ class Arena {
  private:
   struct Zone {
     Zone* prev;
+    // Block size class of the zone's memory, or -1 if it was not pooled.
+    int size_class;
   };
 
   // Initialize an arena.
@@ -90,14 +97,18 @@ class Arena {
   //   memory than the arena contains in zone 0, subsequent zones are allocated
   //   on demand and maintained in a tail-linked list.
   //
+  //   size_class: The block size class the arena's own memory came from, or
+  //   -1 if it was allocated directly.
+  //
   //   initial_alloc: Optionally, construct the arena as though a call to
   //   Alloc() had already been made for initial_alloc bytes. This provides a
   //   quick optimization (avoiding an atomic fetch-add) for the common case
   //   where we wish to create an arena and then perform an immediate
   //   allocation.
-  explicit Arena(size_t initial_size, size_t initial_alloc = 0)
+  Arena(size_t initial_size, int size_class, size_t initial_alloc = 0)
       : total_used_(GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_alloc)),
-        initial_zone_size_(initial_size) {}
+        initial_zone_size_(initial_size),
+        size_class_(size_class) {}
 
   ~Arena();
 
@@ -107,6 +118,7 @@ class Arena {
   // hysteresis.
   Atomic<size_t> total_used_;
   const size_t initial_zone_size_;
+  const int size_class_;
   gpr_spinlock arena_growth_spinlock_ = GPR_SPINLOCK_STATIC_INITIALIZER;
   // If the initial arena allocation wasn't enough, we allocate additional zones
   // in a reverse linked list. Each additional zone consists of (1) a pointer to
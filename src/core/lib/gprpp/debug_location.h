@@ -21,15 +21,22 @@
 
 namespace grpc_core {
 
-// Used for tracking file and line where a call is made for debug builds.
-// No-op for non-debug builds.
+// Used for tracking file and line where a call is made for debug builds, and
+// for builds profiling combiners and work serializers, which attribute time to
+// the locations work was created at (see GRPC_SERIALIZER_PROFILING in
+// src/core/lib/iomgr/serializer_profiler.h).
+// No-op for other builds.
 // Callers can use the DEBUG_LOCATION macro in either case.
-#ifndef NDEBUG
+#if !defined(NDEBUG) || defined(GRPC_SERIALIZER_PROFILING)
+#define GRPC_DEBUG_LOCATION_ENABLED
 // TODO(roth): See if there's a way to automatically populate this,
 // similarly to how absl::SourceLocation::current() works, so that
 // callers don't need to explicitly pass DEBUG_LOCATION anywhere.
 class DebugLocation {
  public:
+  // An unknown location, for NDEBUG builds profiling serializers, whose
+  // callers only have a location in debug builds.
+  DebugLocation() : file_(nullptr), line_(-1) {}
   DebugLocation(const char* file, int line) : file_(file), line_(line) {}
   const char* file() const { return file_; }
   int line() const { return line_; }
@@ -152,6 +152,10 @@ class Thread {
     }
   }
 
+  /// Pins the calling thread to CPU core \a core, modulo the number of cores.
+  /// Returns false if the platform does not support it or the call failed.
+  static bool PinCurrentToCore(int core);
+
  private:
   Thread(const Thread&) = delete;
   Thread& operator=(const Thread&) = delete;
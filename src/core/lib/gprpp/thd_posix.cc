@@ -25,6 +25,7 @@
 #include "src/core/lib/gprpp/thd.h"
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/thd_id.h>
@@ -33,6 +34,10 @@
 #include <string.h>
 #include <unistd.h>
 
+#ifdef GPR_LINUX
+#include <sched.h>
+#endif
+
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/fork.h"
 #include "src/core/lib/gprpp/memory.h"
@@ -196,6 +201,18 @@ Thread::Thread(const char* thd_name, void (*thd_body)(void* arg), void* arg,
     *success = outcome;
   }
 }
+
+bool Thread::PinCurrentToCore(int core) {
+#ifdef GPR_LINUX
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(core % gpr_cpu_num_cores(), &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  (void)core;
+  return false;
+#endif
+}
 }  // namespace grpc_core
 
 // The following is in the external namespace as it is exposed as C89 API
@@ -25,6 +25,7 @@
 #include "src/core/lib/gprpp/thd.h"
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/thd_id.h>
 #include <string.h>
@@ -169,6 +170,14 @@ Thread::Thread(const char* thd_name, void (*thd_body)(void* arg), void* arg,
   }
 }
 
+bool Thread::PinCurrentToCore(int core) {
+  const unsigned bits = sizeof(DWORD_PTR) * 8;
+  const unsigned cpu = static_cast<unsigned>(core) % gpr_cpu_num_cores();
+  if (cpu >= bits) return false;
+  return SetThreadAffinityMask(GetCurrentThread(),
+                               static_cast<DWORD_PTR>(1) << cpu) != 0;
+}
+
 }  // namespace grpc_core
 
 gpr_thd_id gpr_thd_currentid(void) {
@@ -145,12 +145,46 @@ void CallCombiner::Start(grpc_closure* closure, grpc_error* error,
   }
 }
 
+void CallCombiner::StartWhileHolding(grpc_closure* closure, grpc_error* error,
+                                     DEBUG_ARGS const char* reason) {
+  GPR_TIMER_SCOPE("CallCombiner::StartWhileHolding", 0);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
+    gpr_log(GPR_INFO,
+            "==> CallCombiner::StartWhileHolding() [%p] closure=%p "
+            "[" DEBUG_FMT_STR "%s] error=%s",
+            this, closure DEBUG_FMT_ARGS, reason, grpc_error_string(error));
+  }
+  GPR_DEBUG_ASSERT(gpr_atm_no_barrier_load(&size_) > 0);
+  GRPC_STATS_INC_CALL_COMBINER_LOCKS_SCHEDULED_ITEMS();
+  closure->error_data.error = error;
+  closure->next_data.next = nullptr;
+  if (held_tail_ == nullptr) {
+    held_head_ = closure;
+  } else {
+    held_tail_->next_data.next = closure;
+  }
+  held_tail_ = closure;
+}
+
 void CallCombiner::Stop(DEBUG_ARGS const char* reason) {
   GPR_TIMER_SCOPE("CallCombiner::Stop", 0);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
     gpr_log(GPR_INFO, "==> CallCombiner::Stop() [%p] [" DEBUG_FMT_STR "%s]",
             this DEBUG_FMT_ARGS, reason);
   }
+  if (held_head_ != nullptr) {
+    // Hand the call combiner to the next closure started by its holders,
+    // leaving size_ alone.
+    grpc_closure* closure = held_head_;
+    held_head_ = closure->next_data.next;
+    if (held_head_ == nullptr) held_tail_ = nullptr;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
+      gpr_log(GPR_INFO, "  EXECUTING HELD CLOSURE: closure=%p error=%s",
+              closure, grpc_error_string(closure->error_data.error));
+    }
+    ScheduleClosure(closure, closure->error_data.error);
+    return;
+  }
   size_t prev_size =
       static_cast<size_t>(gpr_atm_full_fetch_add(&size_, (gpr_atm)-1));
   if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
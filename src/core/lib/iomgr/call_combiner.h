@@ -42,6 +42,12 @@
 // chain) to explicitly indicate (by calling GRPC_CALL_COMBINER_STOP())
 // when it is done with the action that was kicked off by the original
 // callback.
+//
+// Code that already holds the call combiner can queue closures with
+// GRPC_CALL_COMBINER_START_WHILE_HOLDING() instead: those are handed the
+// call combiner directly when it is yielded, without the atomic operations
+// that GRPC_CALL_COMBINER_START() and GRPC_CALL_COMBINER_STOP() otherwise
+// need to synchronize with other threads.
 
 namespace grpc_core {
 
@@ -57,9 +63,17 @@ class CallCombiner {
   (call_combiner)->Start((closure), (error), __FILE__, __LINE__, (reason))
 #define GRPC_CALL_COMBINER_STOP(call_combiner, reason) \
   (call_combiner)->Stop(__FILE__, __LINE__, (reason))
+#define GRPC_CALL_COMBINER_START_WHILE_HOLDING(call_combiner, closure, error, \
+                                               reason)                        \
+  (call_combiner)                                                             \
+      ->StartWhileHolding((closure), (error), __FILE__, __LINE__, (reason))
   /// Starts processing \a closure.
   void Start(grpc_closure* closure, grpc_error* error, const char* file,
              int line, const char* reason);
+  /// Starts processing \a closure once the caller, which must hold the call
+  /// combiner, yields it.
+  void StartWhileHolding(grpc_closure* closure, grpc_error* error,
+                         const char* file, int line, const char* reason);
   /// Yields the call combiner to the next closure in the queue, if any.
   void Stop(const char* file, int line, const char* reason);
 #else
@@ -67,8 +81,15 @@ class CallCombiner {
   (call_combiner)->Start((closure), (error), (reason))
 #define GRPC_CALL_COMBINER_STOP(call_combiner, reason) \
   (call_combiner)->Stop((reason))
+#define GRPC_CALL_COMBINER_START_WHILE_HOLDING(call_combiner, closure, error, \
+                                               reason)                        \
+  (call_combiner)->StartWhileHolding((closure), (error), (reason))
   /// Starts processing \a closure.
   void Start(grpc_closure* closure, grpc_error* error, const char* reason);
+  /// Starts processing \a closure once the caller, which must hold the call
+  /// combiner, yields it.
+  void StartWhileHolding(grpc_closure* closure, grpc_error* error,
+                         const char* reason);
   /// Yields the call combiner to the next closure in the queue, if any.
   void Stop(const char* reason);
 #endif
@@ -111,6 +132,11 @@ class CallCombiner {
 
   gpr_atm size_ = 0;  // size_t, num closures in queue or currently executing
   MultiProducerSingleConsumerQueue queue_;
+  // Closures started while holding the call combiner, in order. Only
+  // accessed by the holder; they run before anything in queue_, with the
+  // holder's entry in size_ passed from one to the next.
+  grpc_closure* held_head_ = nullptr;
+  grpc_closure* held_tail_ = nullptr;
   // Either 0 (if not cancelled and no cancellation closure set),
   // a grpc_closure* (if the lowest bit is 0),
   // or a grpc_error* (if the lowest bit is 1).
@@ -168,8 +194,8 @@ class CallCombinerClosureList {
     }
     for (size_t i = 1; i < closures_.size(); ++i) {
       auto& closure = closures_[i];
-      GRPC_CALL_COMBINER_START(call_combiner, closure.closure, closure.error,
-                               closure.reason);
+      GRPC_CALL_COMBINER_START_WHILE_HOLDING(call_combiner, closure.closure,
+                                             closure.error, closure.reason);
     }
     if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
       gpr_log(GPR_INFO,
@@ -188,8 +214,8 @@ class CallCombinerClosureList {
   void RunClosuresWithoutYielding(CallCombiner* call_combiner) {
     for (size_t i = 0; i < closures_.size(); ++i) {
       auto& closure = closures_[i];
-      GRPC_CALL_COMBINER_START(call_combiner, closure.closure, closure.error,
-                               closure.reason);
+      GRPC_CALL_COMBINER_START_WHILE_HOLDING(call_combiner, closure.closure,
+                                             closure.error, closure.reason);
     }
     closures_.clear();
   }
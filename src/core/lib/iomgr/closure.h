@@ -27,6 +27,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/gprpp/mpscq.h"
@@ -81,14 +82,22 @@ struct grpc_closure {
 #ifndef NDEBUG
   bool scheduled;
   bool run;  // true = run, false = scheduled
-  const char* file_created;
-  int line_created;
   const char* file_initiated;
   int line_initiated;
 #endif
+// Where the closure was created. Also tracked by profiling builds, which key
+// the time spent in combiners by it.
+#ifdef GRPC_DEBUG_LOCATION_ENABLED
+  const char* file_created;
+  int line_created;
+#endif
+#ifdef GRPC_SERIALIZER_PROFILING
+  /** When the closure was queued on a combiner */
+  gpr_cycle_counter combiner_enqueue_time;
+#endif
 };
 
-#ifndef NDEBUG
+#ifdef GRPC_DEBUG_LOCATION_ENABLED
 inline grpc_closure* grpc_closure_init(const char* file, int line,
                                        grpc_closure* closure,
                                        grpc_iomgr_cb_func cb, void* cb_arg) {
@@ -104,6 +113,8 @@ inline grpc_closure* grpc_closure_init(grpc_closure* closure,
   closure->file_initiated = nullptr;
   closure->line_initiated = 0;
   closure->run = false;
+#endif
+#ifdef GRPC_DEBUG_LOCATION_ENABLED
   closure->file_created = file;
   closure->line_created = line;
 #endif
@@ -111,7 +122,7 @@ inline grpc_closure* grpc_closure_init(grpc_closure* closure,
 }
 
 /** Initializes \a closure with \a cb and \a cb_arg. Returns \a closure. */
-#ifndef NDEBUG
+#ifdef GRPC_DEBUG_LOCATION_ENABLED
 #define GRPC_CLOSURE_INIT(closure, cb, cb_arg, scheduler) \
   grpc_closure_init(__FILE__, __LINE__, closure, cb, cb_arg)
 #else
@@ -136,7 +147,7 @@ inline void closure_wrapper(void* arg, grpc_error* error) {
 
 }  // namespace closure_impl
 
-#ifndef NDEBUG
+#ifdef GRPC_DEBUG_LOCATION_ENABLED
 inline grpc_closure* grpc_closure_create(const char* file, int line,
                                          grpc_iomgr_cb_func cb, void* cb_arg) {
 #else
@@ -146,7 +157,7 @@ inline grpc_closure* grpc_closure_create(grpc_iomgr_cb_func cb, void* cb_arg) {
       static_cast<closure_impl::wrapped_closure*>(gpr_malloc(sizeof(*wc)));
   wc->cb = cb;
   wc->cb_arg = cb_arg;
-#ifndef NDEBUG
+#ifdef GRPC_DEBUG_LOCATION_ENABLED
   grpc_closure_init(file, line, &wc->wrapper, closure_impl::closure_wrapper,
                     wc);
 #else
@@ -156,7 +167,7 @@ inline grpc_closure* grpc_closure_create(grpc_iomgr_cb_func cb, void* cb_arg) {
 }
 
 /* Create a heap allocated closure: try to avoid except for very rare events */
-#ifndef NDEBUG
+#ifdef GRPC_DEBUG_LOCATION_ENABLED
 #define GRPC_CLOSURE_CREATE(cb, cb_arg, scheduler) \
   grpc_closure_create(__FILE__, __LINE__, cb, cb_arg)
 #else
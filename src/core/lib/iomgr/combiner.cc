@@ -154,6 +154,10 @@ static void combiner_exec(grpc_core::Combiner* lock, grpc_closure* cl,
   GPR_ASSERT(last & STATE_UNORPHANED);  // ensure lock has not been destroyed
   assert(cl->cb);
   cl->error_data.error = error;
+#ifdef GRPC_SERIALIZER_PROFILING
+  cl->combiner_enqueue_time = lock->profile.ItemQueued(
+      static_cast<size_t>(last / STATE_ELEM_COUNT_LOW_BIT) + 1);
+#endif
   lock->queue.Push(cl->next_data.mpscq_node.get());
 }
 
@@ -233,8 +237,19 @@ bool grpc_combiner_continue_exec_ctx() {
     grpc_error* cl_err = cl->error_data.error;
 #ifndef NDEBUG
     cl->scheduled = false;
+#endif
+#ifdef GRPC_SERIALIZER_PROFILING
+    // cl may be freed by its callback
+    const char* file_created = cl->file_created;
+    int line_created = cl->line_created;
+    gpr_cycle_counter enqueue_time = cl->combiner_enqueue_time;
+    gpr_cycle_counter start_time = gpr_get_cycle_counter();
 #endif
     cl->cb(cl->cb_arg, cl_err);
+#ifdef GRPC_SERIALIZER_PROFILING
+    lock->profile.ItemRan(file_created, line_created, enqueue_time,
+                          start_time);
+#endif
     GRPC_ERROR_UNREF(cl_err);
   } else {
     grpc_closure* c = lock->final_list.head;
@@ -249,8 +264,18 @@ bool grpc_combiner_continue_exec_ctx() {
       grpc_error* error = c->error_data.error;
 #ifndef NDEBUG
       c->scheduled = false;
+#endif
+#ifdef GRPC_SERIALIZER_PROFILING
+      const char* file_created = c->file_created;
+      int line_created = c->line_created;
+      gpr_cycle_counter enqueue_time = c->combiner_enqueue_time;
+      gpr_cycle_counter start_time = gpr_get_cycle_counter();
 #endif
       c->cb(c->cb_arg, error);
+#ifdef GRPC_SERIALIZER_PROFILING
+      lock->profile.ItemRan(file_created, line_created, enqueue_time,
+                            start_time);
+#endif
       GRPC_ERROR_UNREF(error);
       c = next;
     }
@@ -319,6 +344,11 @@ static void combiner_finally_exec(grpc_core::Combiner* lock,
   if (grpc_closure_list_empty(lock->final_list)) {
     gpr_atm_full_fetch_add(&lock->state, STATE_ELEM_COUNT_LOW_BIT);
   }
+#ifdef GRPC_SERIALIZER_PROFILING
+  closure->combiner_enqueue_time = lock->profile.ItemQueued(
+      static_cast<size_t>(gpr_atm_no_barrier_load(&lock->state) /
+                          STATE_ELEM_COUNT_LOW_BIT));
+#endif
   grpc_closure_list_append(&lock->final_list, closure, error);
 }
 
@@ -26,6 +26,7 @@
 #include <grpc/support/atm.h>
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/serializer_profiler.h"
 
 namespace grpc_core {
 // TODO(yashkt) : Remove this class and replace it with a class that does not
@@ -50,6 +51,9 @@ class Combiner {
   grpc_closure_list final_list;
   grpc_closure offload;
   gpr_refcount refs;
+#ifdef GRPC_SERIALIZER_PROFILING
+  SerializerProfile profile{SerializerProfile::Kind::kCombiner};
+#endif
 };
 }  // namespace grpc_core
 
@@ -52,6 +52,8 @@
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/block_annotate.h"
 #include "src/core/lib/iomgr/ev_posix.h"
@@ -460,6 +462,139 @@ static void fd_become_writable(grpc_fd* fd) { fd->write_closure->SetReady(); }
 
 static void fd_has_errors(grpc_fd* fd) { fd->error_closure->SetReady(); }
 
+/*******************************************************************************
+ * Busy polling
+ */
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_epoll1_busy_poll_us, 0,
+    "Declares how many microseconds the epoll1 designated poller spins for, "
+    "polling without blocking, before it blocks in epoll_wait. Trades CPU "
+    "time for wakeup latency. Set to 0 to never spin.");
+
+#define MAX_BUSY_POLL_US 1000000
+/* Upper bound of the number of pauses between two polls while spinning */
+#define MAX_SPIN_BACKOFF 256
+
+typedef enum { NOT_SPINNING, SPINNING, SPIN_KICKED } spin_state;
+
+/* How long the designated poller spins for before blocking, in microseconds.
+   Zero disables spinning. */
+static int g_busy_poll_us;
+
+/* Whether the designated poller is spinning. Kicks flip SPINNING to
+   SPIN_KICKED instead of writing the wakeup fd, and the poller stops spinning
+   when it sees that. Only the poller moves the state away from NOT_SPINNING,
+   so a kick that finds it there writes the wakeup fd, which the poller's next
+   epoll_wait picks up whether it spins or blocks. */
+static grpc_core::Atomic<int> g_spin_state;
+
+/* When the oldest kick the designated poller has not woken up for yet was
+   issued (see now_us()), or 0 */
+static grpc_core::Atomic<int64_t> g_kick_time_us;
+
+static int64_t now_us() {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  return static_cast<int64_t>(now.tv_sec) * GPR_US_PER_SEC +
+         now.tv_nsec / GPR_NS_PER_US;
+}
+
+static void spin_pause(int iterations) {
+  for (int i = 0; i < iterations; i++) {
+#if defined(__i386__) || defined(__x86_64__)
+    __asm__ __volatile__("pause" ::: "memory");
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+  }
+}
+
+static void busy_poll_global_init() {
+  g_busy_poll_us = GPR_CLAMP(GPR_GLOBAL_CONFIG_GET(grpc_epoll1_busy_poll_us),
+                             0, MAX_BUSY_POLL_US);
+  g_spin_state.Store(NOT_SPINNING, grpc_core::MemoryOrder::RELAXED);
+  g_kick_time_us.Store(0, grpc_core::MemoryOrder::RELAXED);
+}
+
+/* Polls without blocking until there are events, the poller is kicked, or
+   g_busy_poll_us (but no more than timeout ms) have passed, with exponential
+   backoff between polls. Returns what the last epoll_wait returned, and sets
+   *kicked if spinning stopped because of a kick. */
+static int busy_poll(int timeout, bool* kicked) {
+  GPR_TIMER_SCOPE("busy_poll", 0);
+  int64_t budget_us = g_busy_poll_us;
+  if (timeout > 0) {
+    budget_us =
+        GPR_MIN(budget_us, static_cast<int64_t>(timeout) * GPR_US_PER_MS);
+  }
+  const int64_t start_us = now_us();
+  int backoff = 1;
+  int r;
+  g_spin_state.Store(SPINNING, grpc_core::MemoryOrder::RELAXED);
+  for (;;) {
+    do {
+      GRPC_STATS_INC_SYSCALL_POLL();
+      r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS, 0);
+    } while (r < 0 && errno == EINTR);
+    if (r != 0 ||
+        g_spin_state.Load(grpc_core::MemoryOrder::ACQUIRE) == SPIN_KICKED ||
+        now_us() - start_us >= budget_us) {
+      break;
+    }
+    spin_pause(backoff);
+    backoff = GPR_MIN(backoff * 2, MAX_SPIN_BACKOFF);
+  }
+  int state = SPINNING;
+  if (!g_spin_state.CompareExchangeStrong(&state, NOT_SPINNING,
+                                          grpc_core::MemoryOrder::ACQ_REL,
+                                          grpc_core::MemoryOrder::ACQUIRE)) {
+    /* A kick came in and did not write the wakeup fd: do not block */
+    GPR_ASSERT(state == SPIN_KICKED);
+    g_spin_state.Store(NOT_SPINNING, grpc_core::MemoryOrder::RELAXED);
+    *kicked = true;
+  }
+  GRPC_STATS_INC_POLLSET_SPIN_TIME(now_us() - start_us);
+  return r;
+}
+
+/* Wakes up the designated poller. If it is spinning, it is told to stop
+   through g_spin_state, which saves writing (and later reading) the wakeup
+   fd. */
+static grpc_error* kick_active_poller() {
+  int64_t no_kick = 0;
+  g_kick_time_us.CompareExchangeStrong(&no_kick, now_us(),
+                                       grpc_core::MemoryOrder::RELAXED,
+                                       grpc_core::MemoryOrder::RELAXED);
+  if (g_busy_poll_us > 0) {
+    int state = SPINNING;
+    if (g_spin_state.CompareExchangeStrong(&state, SPIN_KICKED,
+                                           grpc_core::MemoryOrder::ACQ_REL,
+                                           grpc_core::MemoryOrder::ACQUIRE) ||
+        state == SPIN_KICKED) {
+      GRPC_STATS_INC_POLLSET_KICK_SPINNING();
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+        gpr_log(GPR_INFO, " .. poller is spinning, skip wakeup fd");
+      }
+      return GRPC_ERROR_NONE;
+    }
+  }
+  GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
+  return grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+}
+
+/* Records how long it took the designated poller to come out of epoll_wait
+   after the oldest kick it had not woken up for */
+static void record_wakeup_latency() {
+  if (g_kick_time_us.Load(grpc_core::MemoryOrder::RELAXED) == 0) return;
+  int64_t kick_time_us =
+      g_kick_time_us.Exchange(0, grpc_core::MemoryOrder::RELAXED);
+  if (kick_time_us != 0) {
+    GRPC_STATS_INC_POLLSET_WAKEUP_LATENCY(now_us() - kick_time_us);
+  }
+}
+
 /*******************************************************************************
  * Pollset Definitions
  */
@@ -518,6 +653,7 @@ static grpc_error* pollset_global_init(void) {
   gpr_tls_init(&g_current_thread_pollset);
   gpr_tls_init(&g_current_thread_worker);
   gpr_atm_no_barrier_store(&g_active_poller, 0);
+  busy_poll_global_init();
   global_wakeup_fd.read_fd = -1;
   grpc_error* err = grpc_wakeup_fd_init(&global_wakeup_fd);
   if (err != GRPC_ERROR_NONE) return err;
@@ -718,22 +854,35 @@ static grpc_error* process_epoll_events(grpc_pollset* /*pollset*/) {
 static grpc_error* do_epoll_wait(grpc_pollset* ps, grpc_millis deadline) {
   GPR_TIMER_SCOPE("do_epoll_wait", 0);
 
-  int r;
+  int r = 0;
+  bool kicked = false;
   int timeout = poll_deadline_to_millis_timeout(deadline);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_START_BLOCKING_REGION;
+  if (g_busy_poll_us > 0 && timeout != 0) {
+    r = busy_poll(timeout, &kicked);
+    if (r == 0 && !kicked) {
+      /* Take the time spent spinning off the timeout */
+      grpc_core::ExecCtx::Get()->InvalidateNow();
+      timeout = poll_deadline_to_millis_timeout(deadline);
+    }
   }
-  do {
-    GRPC_STATS_INC_SYSCALL_POLL();
-    r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
-                   timeout);
-  } while (r < 0 && errno == EINTR);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_END_BLOCKING_REGION;
+  if (r == 0 && !kicked) {
+    if (timeout != 0) {
+      GRPC_SCHEDULING_START_BLOCKING_REGION;
+    }
+    do {
+      GRPC_STATS_INC_SYSCALL_POLL();
+      r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
+                     timeout);
+    } while (r < 0 && errno == EINTR);
+    if (timeout != 0) {
+      GRPC_SCHEDULING_END_BLOCKING_REGION;
+    }
   }
 
   if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
 
+  record_wakeup_latency();
+
   GRPC_STATS_INC_POLL_EVENTS_RETURNED(r);
 
   if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
@@ -1123,12 +1272,11 @@ static grpc_error* pollset_kick(grpc_pollset* pollset,
                  root_worker ==
                      reinterpret_cast<grpc_pollset_worker*>(
                          gpr_atm_no_barrier_load(&g_active_poller))) {
-        GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
         if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
           gpr_log(GPR_INFO, " .. kicked %p", root_worker);
         }
         SET_KICK_STATE(root_worker, KICKED);
-        ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+        ret_err = kick_active_poller();
         goto done;
       } else if (next_worker->state == UNKICKED) {
         GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
@@ -1154,13 +1302,12 @@ static grpc_error* pollset_kick(grpc_pollset* pollset,
           }
           goto done;
         } else {
-          GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
           if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
             gpr_log(GPR_INFO, " .. non-root poller %p (root=%p)", next_worker,
                     root_worker);
           }
           SET_KICK_STATE(next_worker, KICKED);
-          ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+          ret_err = kick_active_poller();
           goto done;
         }
       } else {
@@ -1196,12 +1343,11 @@ static grpc_error* pollset_kick(grpc_pollset* pollset,
   } else if (specific_worker ==
              reinterpret_cast<grpc_pollset_worker*>(
                  gpr_atm_no_barrier_load(&g_active_poller))) {
-    GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
     if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
       gpr_log(GPR_INFO, " .. kick active poller");
     }
     SET_KICK_STATE(specific_worker, KICKED);
-    ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+    ret_err = kick_active_poller();
     goto done;
   } else if (specific_worker->initialized_cv) {
     GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
@@ -22,6 +22,8 @@
 
 #include <string.h>
 
+#include <thread>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
@@ -36,6 +38,16 @@
 
 #define MAX_DEPTH 2
 
+GPR_GLOBAL_CONFIG_DEFINE_STRING(
+    grpc_executor_strategy, "legacy",
+    "Declares which thread pool runs the default executor's closures: "
+    "'legacy' (per-thread closure lists) or 'work_stealing' (per-core "
+    "work-stealing deques).")
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_executor_pin_threads, false,
+    "If set, pins each work-stealing executor thread to its own core.")
+
 #define EXECUTOR_TRACE(format, ...)                       \
   do {                                                    \
     if (GRPC_TRACE_FLAG_ENABLED(executor_trace)) {        \
@@ -89,7 +101,8 @@ const EnqueueFunc
 
 TraceFlag executor_trace(false, "executor");
 
-Executor::Executor(const char* name) : name_(name) {
+Executor::Executor(const char* name, bool work_stealing)
+    : name_(name), work_stealing_(work_stealing) {
   adding_thread_lock_ = GPR_SPINLOCK_STATIC_INITIALIZER;
   gpr_atm_rel_store(&num_threads_, 0);
   max_threads_ = GPR_MAX(1, 2 * gpr_cpu_num_cores());
@@ -148,6 +161,13 @@ void Executor::SetThreading(bool threading) {
     }
 
     GPR_ASSERT(num_threads_ == 0);
+    if (work_stealing_) {
+      // Short jobs run on the pool. Long jobs still get the threads below,
+      // which grow on demand, so that they never hold up a pool worker.
+      pool_.store(new WorkStealingThreadPool(
+          gpr_cpu_num_cores(), name_, Thread::Options(),
+          GPR_GLOBAL_CONFIG_GET(grpc_executor_pin_threads)));
+    }
     gpr_atm_rel_store(&num_threads_, 1);
     thd_state_ = static_cast<ThreadState*>(
         gpr_zalloc(sizeof(ThreadState) * max_threads_));
@@ -170,6 +190,18 @@ void Executor::SetThreading(bool threading) {
       return;
     }
 
+    if (work_stealing_) {
+      // New short closures now run inline on the caller's exec_ctx; deleting
+      // the pool runs the ones already queued.
+      WorkStealingThreadPool* pool = pool_.exchange(nullptr);
+      // Enqueue() calls that loaded the pool before the exchange may still be
+      // pushing to it.
+      while (pool_enqueuers_.load() != 0) {
+        std::this_thread::yield();
+      }
+      delete pool;
+    }
+
     for (size_t i = 0; i < max_threads_; i++) {
       gpr_mu_lock(&thd_state_[i].mu);
       thd_state_[i].shutdown = true;
@@ -283,6 +315,18 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error* error,
       return;
     }
 
+    if (work_stealing_ && is_short) {
+      pool_enqueuers_.fetch_add(1);
+      WorkStealingThreadPool* pool = pool_.load();
+      if (pool != nullptr) pool->Run(closure, error);
+      pool_enqueuers_.fetch_sub(1);
+      if (pool != nullptr) return;
+      // The executor was shut down after num_threads_ was read.
+      grpc_closure_list_append(grpc_core::ExecCtx::Get()->closure_list(),
+                               closure, error);
+      return;
+    }
+
     ThreadState* ts =
         reinterpret_cast<ThreadState*>(gpr_tls_get(&g_this_thread_state));
     if (ts == nullptr) {
@@ -393,8 +437,17 @@ void Executor::InitAll() {
     return;
   }
 
+  // Only the default executor can use the work-stealing pool: resolver jobs
+  // block in getaddrinfo() and need threads of their own.
+  grpc_core::UniquePtr<char> strategy =
+      GPR_GLOBAL_CONFIG_GET(grpc_executor_strategy);
+  bool work_stealing = strcmp(strategy.get(), "work_stealing") == 0;
+  if (!work_stealing && strcmp(strategy.get(), "legacy") != 0) {
+    gpr_log(GPR_ERROR, "Unknown executor strategy '%s', using 'legacy'",
+            strategy.get());
+  }
   executors[static_cast<size_t>(ExecutorType::DEFAULT)] =
-      new Executor("default-executor");
+      new Executor("default-executor", work_stealing);
   executors[static_cast<size_t>(ExecutorType::RESOLVER)] =
       new Executor("resolver-executor");
 
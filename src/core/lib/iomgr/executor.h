@@ -21,9 +21,16 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <atomic>
+
 #include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/executor/work_stealing_threadpool.h"
+
+GPR_GLOBAL_CONFIG_DECLARE_STRING(grpc_executor_strategy);
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_executor_pin_threads);
 
 namespace grpc_core {
 
@@ -54,7 +61,10 @@ enum class ExecutorJobType {
 
 class Executor {
  public:
-  explicit Executor(const char* executor_name);
+  // If \a work_stealing is true, short closures run on a WorkStealingThreadPool
+  // with one worker per core instead of the per-thread closure lists. Long
+  // ones keep the per-thread closure lists.
+  explicit Executor(const char* executor_name, bool work_stealing = false);
 
   void Init();
 
@@ -112,6 +122,11 @@ class Executor {
   size_t max_threads_;
   gpr_atm num_threads_;
   gpr_spinlock adding_thread_lock_;
+  const bool work_stealing_;
+  std::atomic<WorkStealingThreadPool*> pool_{nullptr};
+  // Enqueue() calls that may be using pool_; SetThreading(false) waits for
+  // them before deleting the pool.
+  std::atomic<size_t> pool_enqueuers_{0};
 };
 
 // Global initializer for executor
@@ -0,0 +1,407 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/executor/work_stealing_threadpool.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Must be a power of two. Work pushed to a full deque goes to the injection
+// queue instead.
+constexpr int64_t kDequeSize = 256;
+// Every this many items a worker looks at the injection queue before its own
+// deque, so that work from outside the pool is not starved by closures that
+// keep rescheduling themselves.
+constexpr uint32_t kInjectionCheckInterval = 61;
+// How many items a worker runs in a row from its LIFO slot. Past that, the
+// slot moves to the deque, where thieves can get at it, and the worker takes
+// the oldest item of its deque instead; as in Tokio, this keeps two closures
+// that reschedule each other from starving the rest of the deque.
+constexpr uint32_t kLifoBudget = 3;
+
+GPR_TLS_DECL(g_current_worker);
+gpr_once g_tls_once = GPR_ONCE_INIT;
+
+void InitTls() { gpr_tls_init(&g_current_worker); }
+
+}  // namespace
+
+class WorkStealingThreadPool::Worker {
+ public:
+  Worker(WorkStealingThreadPool* pool, int index)
+      : pool_(pool), index_(index), rng_(static_cast<uint32_t>(index) + 1) {
+    for (std::atomic<uintptr_t>& slot : buffer_) {
+      slot.store(0, std::memory_order_relaxed);
+    }
+    thd_ = Thread(
+        pool->thd_name_, [](void* w) { static_cast<Worker*>(w)->Run(); },
+        this, nullptr, pool->thread_options_);
+  }
+
+  void Start() { thd_.Start(); }
+  void Join() { thd_.Join(); }
+
+  WorkStealingThreadPool* pool() const { return pool_; }
+
+  // Owner only: xorshift32, used to pick the first victim to steal from.
+  uint32_t NextRandom() {
+    rng_ ^= rng_ << 13;
+    rng_ ^= rng_ >> 17;
+    rng_ ^= rng_ << 5;
+    return rng_;
+  }
+
+  // Owner only: puts \a item in the LIFO slot, moving the previous occupant
+  // to the bottom of the deque. Returns whether that made an item visible to
+  // the other workers, which only the deque and the injection queue are.
+  bool Push(uintptr_t item) {
+    uintptr_t displaced = lifo_slot_.exchange(item, std::memory_order_relaxed);
+    if (displaced == 0) return false;
+    Spill(displaced);
+    return true;
+  }
+
+  // Any thread: takes the oldest item of the deque. The LIFO slot is left
+  // alone, since its owner runs it next.
+  uintptr_t Steal() {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t < b) {
+      uintptr_t item =
+          buffer_[t & (kDequeSize - 1)].load(std::memory_order_relaxed);
+      if (top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+        return item;
+      }
+      // Lost the race against the owner or another thief. The caller comes
+      // back here through HasWork() if the deque still is not empty.
+    }
+    return 0;
+  }
+
+  // Whether there is anything for other workers to steal.
+  bool HasWork() const {
+    return bottom_.load(std::memory_order_relaxed) >
+           top_.load(std::memory_order_relaxed);
+  }
+
+  size_t Size() const {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    return static_cast<size_t>(GPR_MAX(b - t, 0)) +
+           (lifo_slot_.load(std::memory_order_relaxed) != 0 ? 1 : 0);
+  }
+
+ private:
+  void Run() {
+    gpr_tls_set(&g_current_worker, reinterpret_cast<intptr_t>(this));
+    if (pool_->pin_threads_ && !Thread::PinCurrentToCore(index_)) {
+      gpr_log(GPR_DEBUG, "Failed to pin thread pool worker %d", index_);
+    }
+    ExecCtx exec_ctx(GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
+    for (;;) {
+      uintptr_t item = FindWork();
+      if (item == 0) {
+        if (!pool_->Park()) break;
+        ExecCtx::Get()->InvalidateNow();
+        continue;
+      }
+      RunItem(item);
+    }
+    gpr_tls_set(&g_current_worker, reinterpret_cast<intptr_t>(nullptr));
+  }
+
+  uintptr_t FindWork() {
+    uintptr_t item;
+    if (++tick_ % kInjectionCheckInterval == 0 &&
+        (item = pool_->PopInjected()) != 0) {
+      lifo_polls_ = 0;
+      return item;
+    }
+    item = lifo_slot_.exchange(0, std::memory_order_relaxed);
+    if (item != 0) {
+      if (lifo_polls_ < kLifoBudget) {
+        ++lifo_polls_;
+        return item;
+      }
+      // Out of budget: the slot goes after everything already in the deque.
+      Spill(item);
+      pool_->Notify();
+      if ((item = Steal()) != 0) {
+        lifo_polls_ = 0;
+        return item;
+      }
+    }
+    lifo_polls_ = 0;
+    if ((item = PopBottom()) != 0) return item;
+    if ((item = pool_->PopInjected()) != 0) return item;
+    return pool_->Steal(this);
+  }
+
+  // Owner only: makes \a item stealable.
+  void Spill(uintptr_t item) {
+    if (!PushBottom(item)) pool_->PushInjected(item);
+  }
+
+  // Chase-Lev deque, as formulated for C11 atomics by Le et al., "Correct and
+  // Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013). The owner
+  // pushes and pops at the bottom, thieves take from the top.
+  bool PushBottom(uintptr_t item) {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_acquire);
+    if (b - t >= kDequeSize) return false;
+    buffer_[b & (kDequeSize - 1)].store(item, std::memory_order_relaxed);
+    bottom_.store(b + 1, std::memory_order_release);
+    return true;
+  }
+
+  uintptr_t PopBottom() {
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+      // Empty.
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return 0;
+    }
+    uintptr_t item =
+        buffer_[b & (kDequeSize - 1)].load(std::memory_order_relaxed);
+    if (t == b) {
+      // Last item: race against thieves for it.
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        item = 0;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  WorkStealingThreadPool* const pool_;
+  const int index_;
+  Thread thd_;
+  // Owner-only state.
+  uint32_t rng_;
+  uint32_t tick_ = 0;
+  // Items run from the LIFO slot since the last one from anywhere else.
+  uint32_t lifo_polls_ = 0;
+
+  char pad0_[GPR_CACHELINE_SIZE];
+  std::atomic<uintptr_t> lifo_slot_{0};
+  std::atomic<int64_t> bottom_{0};
+  char pad1_[GPR_CACHELINE_SIZE];
+  std::atomic<int64_t> top_{0};
+  char pad2_[GPR_CACHELINE_SIZE];
+  std::atomic<uintptr_t> buffer_[kDequeSize];
+};
+
+WorkStealingThreadPool::WorkStealingThreadPool(int num_threads)
+    : WorkStealingThreadPool(num_threads, "WorkStealingWorker") {}
+
+WorkStealingThreadPool::WorkStealingThreadPool(
+    int num_threads, const char* thd_name,
+    const Thread::Options& thread_options, bool pin_threads)
+    : num_threads_(GPR_MAX(num_threads, 1)),
+      thd_name_(thd_name),
+      thread_options_(thread_options),
+      pin_threads_(pin_threads) {
+  gpr_once_init(&g_tls_once, InitTls);
+  // All worker threads must be joinable.
+  thread_options_.set_joinable(true);
+  workers_ = static_cast<Worker**>(gpr_zalloc(num_threads_ * sizeof(Worker*)));
+  for (int i = 0; i < num_threads_; ++i) {
+    workers_[i] = new Worker(this, i);
+  }
+  for (int i = 0; i < num_threads_; ++i) {
+    workers_[i]->Start();
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  {
+    MutexLock lock(&sleep_mu_);
+    shutdown_.store(true, std::memory_order_release);
+    sleep_cv_.Broadcast();
+  }
+  for (int i = 0; i < num_threads_; ++i) {
+    workers_[i]->Join();
+  }
+  // Work added from outside the pool after the last worker went away.
+  uintptr_t item;
+  while ((item = PopInjected()) != 0) {
+    RunItem(item);
+  }
+  for (int i = 0; i < num_threads_; ++i) {
+    delete workers_[i];
+  }
+  gpr_free(workers_);
+}
+
+void WorkStealingThreadPool::Add(
+    grpc_experimental_completion_queue_functor* closure) {
+  Schedule(reinterpret_cast<uintptr_t>(closure) | kFunctorTag);
+}
+
+void WorkStealingThreadPool::Run(grpc_closure* closure, grpc_error* error) {
+#ifndef NDEBUG
+  closure->scheduled = true;
+#endif
+  closure->error_data.error = error;
+  Schedule(reinterpret_cast<uintptr_t>(closure));
+}
+
+void WorkStealingThreadPool::Schedule(uintptr_t item) {
+  Worker* worker = reinterpret_cast<Worker*>(gpr_tls_get(&g_current_worker));
+  if (worker != nullptr && worker->pool() == this) {
+    // The LIFO slot is for this worker alone: only wake another one up if
+    // an item was pushed out of it.
+    if (!worker->Push(item)) return;
+  } else {
+    PushInjected(item);
+  }
+  Notify();
+}
+
+void WorkStealingThreadPool::PushInjected(uintptr_t item) {
+  MutexLock lock(&injection_mu_);
+  injection_queue_.push_back(item);
+  injection_size_.store(injection_queue_.size(), std::memory_order_relaxed);
+}
+
+uintptr_t WorkStealingThreadPool::PopInjected() {
+  if (injection_size_.load(std::memory_order_relaxed) == 0) return 0;
+  MutexLock lock(&injection_mu_);
+  if (injection_queue_.empty()) return 0;
+  uintptr_t item = injection_queue_.front();
+  injection_queue_.pop_front();
+  injection_size_.store(injection_queue_.size(), std::memory_order_relaxed);
+  return item;
+}
+
+uintptr_t WorkStealingThreadPool::Steal(Worker* thief) {
+  const int start = static_cast<int>(thief->NextRandom() % num_threads_);
+  for (int i = 0; i < num_threads_; ++i) {
+    Worker* victim = workers_[(start + i) % num_threads_];
+    if (victim == thief) continue;
+    uintptr_t item = victim->Steal();
+    if (item != 0) return item;
+  }
+  return 0;
+}
+
+bool WorkStealingThreadPool::HasWork() const {
+  if (injection_size_.load(std::memory_order_relaxed) != 0) return true;
+  for (int i = 0; i < num_threads_; ++i) {
+    if (workers_[i]->HasWork()) return true;
+  }
+  return false;
+}
+
+void WorkStealingThreadPool::Notify() {
+  // Pairs with the fence in Park(): either the sleeper sees the new work, or
+  // we see the sleeper.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_sleeping_.load(std::memory_order_relaxed) == 0) return;
+  MutexLock lock(&sleep_mu_);
+  // A worker that has already been signalled but has not run yet no longer
+  // counts as sleeping, so that a burst of work wakes as many workers as
+  // there are items rather than signalling the same one over and over.
+  if (num_sleeping_.load(std::memory_order_relaxed) == 0) return;
+  num_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+  ++num_signalled_;
+  sleep_cv_.Signal();
+}
+
+bool WorkStealingThreadPool::Park() {
+  MutexLock lock(&sleep_mu_);
+  num_sleeping_.fetch_add(1, std::memory_order_relaxed);
+  for (;;) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool has_work = HasWork();
+    if (has_work || shutdown_.load(std::memory_order_acquire)) {
+      // Take ourselves off the sleeper count, or use up a signal that was
+      // meant for one of the sleepers if there is one outstanding.
+      if (num_signalled_ > 0) {
+        --num_signalled_;
+      } else {
+        num_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+      }
+      return has_work;
+    }
+    sleep_cv_.Wait(&sleep_mu_);
+    // Woken up, by a signal or spuriously: count as sleeping again until we
+    // have found work.
+    if (num_signalled_ > 0) {
+      --num_signalled_;
+      num_sleeping_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+void WorkStealingThreadPool::RunItem(uintptr_t item) {
+  if ((item & kFunctorTag) != 0) {
+    auto* functor =
+        reinterpret_cast<grpc_experimental_completion_queue_functor*>(
+            item & ~kFunctorTag);
+    functor->functor_run(functor, functor->internal_success);
+    return;
+  }
+  // As in Executor::RunClosures(), closures run here may invoke
+  // application-level callbacks.
+  ApplicationCallbackExecCtx callback_exec_ctx(
+      GRPC_APP_CALLBACK_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
+  grpc_closure* closure = reinterpret_cast<grpc_closure*>(item);
+  grpc_error* error = closure->error_data.error;
+#ifndef NDEBUG
+  closure->scheduled = false;
+#endif
+  closure->cb(closure->cb_arg, error);
+  GRPC_ERROR_UNREF(error);
+  ExecCtx::Get()->Flush();
+}
+
+int WorkStealingThreadPool::num_pending_closures() const {
+  size_t n = injection_size_.load(std::memory_order_relaxed);
+  for (int i = 0; i < num_threads_; ++i) {
+    n += workers_[i]->Size();
+  }
+  return static_cast<int>(n);
+}
+
+int WorkStealingThreadPool::pool_capacity() const { return num_threads_; }
+
+const Thread::Options& WorkStealingThreadPool::thread_options() const {
+  return thread_options_;
+}
+
+const char* WorkStealingThreadPool::thread_name() const { return thd_name_; }
+
+}  // namespace grpc_core
@@ -0,0 +1,121 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_THREADPOOL_H
+#define GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_THREADPOOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/executor/threadpool.h"
+
+namespace grpc_core {
+
+// A fixed size thread pool in which every worker owns a Chase-Lev
+// work-stealing deque.
+//
+// Work scheduled from one of the pool's own threads stays on that thread: it
+// goes to the worker's LIFO slot, so a closure scheduling its continuation has
+// it run next on the same core while its data is still in cache, and whatever
+// was in the slot moves to the worker's deque. Only a few items in a row run
+// from the slot; after that it moves to the deque too, and the oldest item of
+// the deque runs instead. Work scheduled from any other thread goes to a
+// shared injection queue. Idle workers take work from their LIFO slot, then
+// their deque, then the injection queue, and finally steal from the deques of
+// the other workers before going to sleep. LIFO slots are never stolen from.
+//
+// Accepts both grpc_closure (with an error, as for Executor::Run()) and
+// completion queue functors (as ThreadPool does).
+class WorkStealingThreadPool : public ThreadPoolInterface {
+ public:
+  // Creates a pool of \a num_threads workers (at least 1). If \a pin_threads
+  // is true, worker i is pinned to core i modulo the number of cores, where
+  // the platform supports it.
+  explicit WorkStealingThreadPool(int num_threads);
+  WorkStealingThreadPool(
+      int num_threads, const char* thd_name,
+      const Thread::Options& thread_options = Thread::Options(),
+      bool pin_threads = false);
+
+  // Runs every pending closure, then shuts down the workers. Closures may keep
+  // scheduling work on the pool while it drains.
+  ~WorkStealingThreadPool() override;
+
+  WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+  WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+  void Add(grpc_experimental_completion_queue_functor* closure) override;
+
+  // Schedules \a closure to run with \a error on one of the workers. Takes
+  // ownership of \a error.
+  void Run(grpc_closure* closure, grpc_error* error);
+
+  // Approximate, since workers keep running concurrently.
+  int num_pending_closures() const override;
+  int pool_capacity() const override;
+  const Thread::Options& thread_options() const override;
+  const char* thread_name() const override;
+
+ private:
+  class Worker;
+
+  // Scheduled items are closures, or functors with the low bit set.
+  static constexpr uintptr_t kFunctorTag = 1;
+
+  void Schedule(uintptr_t item);
+  void PushInjected(uintptr_t item);
+  uintptr_t PopInjected();
+  uintptr_t Steal(Worker* thief);
+  bool HasWork() const;
+  // Wakes up a sleeping worker, if any.
+  void Notify();
+  // Returns false once the pool is shutting down and there is no work left.
+  bool Park();
+  static void RunItem(uintptr_t item);
+
+  const int num_threads_;
+  const char* thd_name_;
+  Thread::Options thread_options_;
+  const bool pin_threads_;
+  Worker** workers_ = nullptr;
+
+  Mutex injection_mu_;
+  std::deque<uintptr_t> injection_queue_;
+  std::atomic<size_t> injection_size_{0};
+
+  Mutex sleep_mu_;
+  CondVar sleep_cv_;
+  // Workers waiting on sleep_cv_ that no Notify() has signalled yet.
+  std::atomic<int> num_sleeping_{0};
+  // Signals sent by Notify() that no worker has picked up yet.
+  int num_signalled_ = 0;
+  std::atomic<bool> shutdown_{false};
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_THREADPOOL_H */
@@ -56,6 +56,9 @@
 /* Linux has TCP_INQ support since 4.18, but it is safe to set
    the socket option on older kernels. */
 #define GRPC_HAVE_TCP_INQ 1
+/* Linux has TCP_ZEROCOPY_RECEIVE support since 4.18. On older kernels the
+   socket option fails and reads fall back to recvmsg(). */
+#define GRPC_HAVE_TCP_ZEROCOPY_RECEIVE 1
 #ifdef LINUX_VERSION_CODE
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0)
 #define GRPC_LINUX_ERRQUEUE 1
@@ -0,0 +1,148 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/read_buffer_pool.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/gpr/useful.h"
+
+namespace grpc_core {
+
+namespace {
+
+constexpr size_t kSizeClassBytes[] = {
+    4 * 1024,  8 * 1024,  16 * 1024,  32 * 1024,  48 * 1024,
+    64 * 1024, 96 * 1024, 128 * 1024, 192 * 1024, 256 * 1024};
+constexpr int kNumSizeClasses = GPR_ARRAY_SIZE(kSizeClassBytes);
+constexpr size_t kMaxShards = 16;
+// Upper bound on the bytes of free buffers that a shard keeps.
+constexpr size_t kMaxCachedBytesPerShard = 1024 * 1024;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+struct alignas(GPR_CACHELINE_SIZE) Shard {
+  gpr_mu mu;
+  FreeBlock* free_blocks[kNumSizeClasses];
+  size_t cached_bytes;
+};
+
+gpr_once g_once = GPR_ONCE_INIT;
+Shard g_shards[kMaxShards];
+size_t g_num_shards;
+
+void InitShards() {
+  g_num_shards = GPR_CLAMP(gpr_cpu_num_cores(), 1, kMaxShards);
+  for (size_t i = 0; i < g_num_shards; i++) {
+    gpr_mu_init(&g_shards[i].mu);
+    for (int c = 0; c < kNumSizeClasses; c++) {
+      g_shards[i].free_blocks[c] = nullptr;
+    }
+    g_shards[i].cached_bytes = 0;
+  }
+}
+
+Shard* CurrentShard() {
+  gpr_once_init(&g_once, InitShards);
+  return &g_shards[gpr_cpu_current_cpu() % g_num_shards];
+}
+
+}  // namespace
+
+void ReadBufferPool::ReleaseCachedBlocks() {
+  gpr_once_init(&g_once, InitShards);
+  for (size_t i = 0; i < g_num_shards; i++) {
+    Shard* shard = &g_shards[i];
+    FreeBlock* free_blocks[kNumSizeClasses];
+    gpr_mu_lock(&shard->mu);
+    for (int c = 0; c < kNumSizeClasses; c++) {
+      free_blocks[c] = shard->free_blocks[c];
+      shard->free_blocks[c] = nullptr;
+    }
+    shard->cached_bytes = 0;
+    gpr_mu_unlock(&shard->mu);
+    for (int c = 0; c < kNumSizeClasses; c++) {
+      while (free_blocks[c] != nullptr) {
+        FreeBlock* next = free_blocks[c]->next;
+        gpr_free(free_blocks[c]);
+        free_blocks[c] = next;
+      }
+    }
+  }
+}
+
+int ReadBufferPool::SizeClassFor(size_t size) {
+  for (int c = 0; c < kNumSizeClasses; c++) {
+    if (kSizeClassBytes[c] == size) return c;
+  }
+  return -1;
+}
+
+size_t ReadBufferPool::RoundUp(size_t size) {
+  if (size < kSizeClassBytes[0]) return size;
+  for (int c = 0; c < kNumSizeClasses; c++) {
+    if (kSizeClassBytes[c] >= size) return kSizeClassBytes[c];
+  }
+  return size;
+}
+
+size_t ReadBufferPool::SizeClassBytes(int size_class) {
+  GPR_DEBUG_ASSERT(size_class >= 0 && size_class < kNumSizeClasses);
+  return kSizeClassBytes[size_class];
+}
+
+void* ReadBufferPool::Alloc(int size_class) {
+  GPR_DEBUG_ASSERT(size_class >= 0 && size_class < kNumSizeClasses);
+  Shard* shard = CurrentShard();
+  gpr_mu_lock(&shard->mu);
+  FreeBlock* block = shard->free_blocks[size_class];
+  if (block != nullptr) {
+    shard->free_blocks[size_class] = block->next;
+    shard->cached_bytes -= kSizeClassBytes[size_class];
+  }
+  gpr_mu_unlock(&shard->mu);
+  if (block == nullptr) {
+    return gpr_malloc(kHeaderSize + kSizeClassBytes[size_class]);
+  }
+  return block;
+}
+
+void ReadBufferPool::Free(int size_class, void* block) {
+  GPR_DEBUG_ASSERT(size_class >= 0 && size_class < kNumSizeClasses);
+  Shard* shard = CurrentShard();
+  gpr_mu_lock(&shard->mu);
+  if (shard->cached_bytes + kSizeClassBytes[size_class] <=
+      kMaxCachedBytesPerShard) {
+    FreeBlock* free_block = static_cast<FreeBlock*>(block);
+    free_block->next = shard->free_blocks[size_class];
+    shard->free_blocks[size_class] = free_block;
+    shard->cached_bytes += kSizeClassBytes[size_class];
+    block = nullptr;
+  }
+  gpr_mu_unlock(&shard->mu);
+  gpr_free(block);
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,77 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_READ_BUFFER_POOL_H
+#define GRPC_CORE_LIB_IOMGR_READ_BUFFER_POOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+namespace grpc_core {
+
+// Process-wide cache of read buffers in a few fixed size classes.
+//
+// Endpoints size their reads from their recent read history, which makes every
+// connection ask for a slightly different buffer size and churns the
+// allocator on servers with many connections. Rounding read sizes up to a size
+// class lets freed buffers be handed straight to the next read of that class.
+//
+// Size classes are at most 1.5x apart from 32K up, so that rounding up wastes
+// at most half of a large read.
+//
+// Freed buffers are cached in per-CPU shards, so that a buffer is usually
+// reused on the CPU (and in the cache) that last touched it and the shard
+// locks are rarely contended. Each shard caches a bounded number of bytes;
+// anything beyond that goes back to the allocator.
+//
+// Cached buffers are not charged to any resource quota: a buffer is charged to
+// the resource user that allocates it, like any other slice, until it is
+// freed. Instead, the cache is dropped whenever a resource quota starts
+// reclaiming memory.
+class ReadBufferPool {
+ public:
+  // Bytes reserved in front of every buffer for the owner's bookkeeping (e.g.
+  // a slice refcount). A multiple of the cache line size, so that buffers
+  // start on their own cache line.
+  static constexpr size_t kHeaderSize = 128;
+
+  // Returns the cached buffers to the allocator. Called under memory pressure
+  // and at shutdown. Buffers freed afterwards are cached again, so this is
+  // safe to call while buffers are still in use.
+  static void ReleaseCachedBlocks();
+
+  // Returns the size class whose buffers are exactly \a size bytes, or -1 if
+  // there is none.
+  static int SizeClassFor(size_t size);
+  // Returns the size of the buffers of the smallest size class that holds
+  // \a size bytes, or \a size if it is outside of the range of the size
+  // classes.
+  static size_t RoundUp(size_t size);
+  // Returns the buffer size of \a size_class.
+  static size_t SizeClassBytes(int size_class);
+
+  // Returns a block of kHeaderSize + SizeClassBytes(size_class) bytes.
+  static void* Alloc(int size_class);
+  // Returns a block obtained from Alloc(size_class) to the pool.
+  static void Free(int size_class, void* block);
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_IOMGR_READ_BUFFER_POOL_H */
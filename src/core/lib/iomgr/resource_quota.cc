@@ -34,7 +34,10 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/arena.h"
+#include "src/core/lib/gprpp/atomic.h"
 #include "src/core/lib/iomgr/combiner.h"
+#include "src/core/lib/iomgr/read_buffer_pool.h"
 #include "src/core/lib/slice/slice_internal.h"
 
 grpc_core::TraceFlag grpc_resource_quota_trace(false, "resource_quota");
@@ -86,8 +89,12 @@ struct grpc_resource_user {
      can pull it back under memory pressure.
      This value can become negative if more memory has been requested than
      existed in the free pool, at which point the quota is consulted to bring
-     this value non-negative (asynchronously). */
-  int64_t free_pool;
+     this value non-negative (asynchronously).
+     Allocations that fit in the pool and frees to an already non-empty pool
+     update it without taking mu (see ru_try_alloc_from_free_pool and
+     ru_try_free_to_free_pool); everything that makes it negative or brings it
+     back above zero happens under mu. */
+  grpc_core::Atomic<int64_t> free_pool;
   /* A list of closures to call once free_pool becomes non-negative - ie when
      all outstanding allocations have been granted. */
   grpc_closure_list on_allocated;
@@ -325,7 +332,8 @@ static bool rq_alloc(grpc_resource_quota* resource_quota) {
               "RQ: check allocation for user %p shutdown=%" PRIdPTR
               " free_pool=%" PRId64 " outstanding_allocations=%" PRId64,
               resource_user, gpr_atm_no_barrier_load(&resource_user->shutdown),
-              resource_user->free_pool, resource_user->outstanding_allocations);
+              resource_user->free_pool.Load(grpc_core::MemoryOrder::RELAXED),
+              resource_user->outstanding_allocations);
     }
     if (gpr_atm_no_barrier_load(&resource_user->shutdown)) {
       resource_user->allocating = false;
@@ -334,7 +342,8 @@ static bool rq_alloc(grpc_resource_quota* resource_quota) {
           GRPC_ERROR_CREATE_FROM_STATIC_STRING("Resource user shutdown"));
       int64_t aborted_allocations = resource_user->outstanding_allocations;
       resource_user->outstanding_allocations = 0;
-      resource_user->free_pool += aborted_allocations;
+      resource_user->free_pool.FetchAdd(aborted_allocations,
+                                        grpc_core::MemoryOrder::RELAXED);
       grpc_core::ExecCtx::RunList(DEBUG_LOCATION, &resource_user->on_allocated);
       gpr_mu_unlock(&resource_user->mu);
       if (aborted_allocations > 0) {
@@ -342,10 +351,13 @@ static bool rq_alloc(grpc_resource_quota* resource_quota) {
       }
       continue;
     }
-    if (resource_user->free_pool < 0 &&
-        -resource_user->free_pool <= resource_quota->free_pool) {
-      int64_t amt = -resource_user->free_pool;
-      resource_user->free_pool = 0;
+    // A negative free pool is only ever changed under mu.
+    int64_t free_pool =
+        resource_user->free_pool.Load(grpc_core::MemoryOrder::RELAXED);
+    if (free_pool < 0 && -free_pool <= resource_quota->free_pool) {
+      int64_t amt = -free_pool;
+      free_pool = 0;
+      resource_user->free_pool.Store(0, grpc_core::MemoryOrder::RELAXED);
       resource_quota->free_pool -= amt;
       rq_update_estimate(resource_quota);
       if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
@@ -356,11 +368,11 @@ static bool rq_alloc(grpc_resource_quota* resource_quota) {
                 resource_quota->free_pool);
       }
     } else if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace) &&
-               resource_user->free_pool >= 0) {
+               free_pool >= 0) {
       gpr_log(GPR_INFO, "RQ %s %s: discard already satisfied alloc request",
               resource_quota->name.c_str(), resource_user->name.c_str());
     }
-    if (resource_user->free_pool >= 0) {
+    if (free_pool >= 0) {
       resource_user->allocating = false;
       resource_user->outstanding_allocations = 0;
       grpc_core::ExecCtx::RunList(DEBUG_LOCATION, &resource_user->on_allocated);
@@ -382,9 +394,14 @@ static bool rq_reclaim_from_per_user_free_pool(
                                           GRPC_RULIST_NON_EMPTY_FREE_POOL))) {
     gpr_mu_lock(&resource_user->mu);
     resource_user->added_to_free_pool = false;
-    if (resource_user->free_pool > 0) {
-      int64_t amt = resource_user->free_pool;
-      resource_user->free_pool = 0;
+    // Allocations may still be taking from the pool without holding mu.
+    int64_t amt =
+        resource_user->free_pool.Load(grpc_core::MemoryOrder::RELAXED);
+    while (amt > 0 && !resource_user->free_pool.CompareExchangeWeak(
+                          &amt, 0, grpc_core::MemoryOrder::RELAXED,
+                          grpc_core::MemoryOrder::RELAXED)) {
+    }
+    if (amt > 0) {
       resource_quota->free_pool += amt;
       rq_update_estimate(resource_quota);
       if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
@@ -401,8 +418,8 @@ static bool rq_reclaim_from_per_user_free_pool(
         gpr_log(GPR_INFO,
                 "RQ %s %s: failed to reclaim_from_per_user_free_pool; "
                 "free_pool = %" PRId64 "; rq_free_pool = %" PRId64,
-                resource_quota->name.c_str(), resource_user->name.c_str(),
-                resource_user->free_pool, resource_quota->free_pool);
+                resource_quota->name.c_str(), resource_user->name.c_str(), amt,
+                resource_quota->free_pool);
       }
       gpr_mu_unlock(&resource_user->mu);
     }
@@ -422,6 +439,11 @@ static bool rq_reclaim(grpc_resource_quota* resource_quota, bool destructive) {
             resource_quota->name.c_str(), resource_user->name.c_str(),
             destructive ? "destructive" : "benign");
   }
+  /* Memory is short enough to take it back from resource users: stop holding
+     on to blocks of destroyed call arenas and read buffers too, which are not
+     charged to the quota. */
+  grpc_core::Arena::ReleaseCachedBlocks();
+  grpc_core::ReadBufferPool::ReleaseCachedBlocks();
   resource_quota->reclaiming = true;
   grpc_resource_quota_ref_internal(resource_quota);
   grpc_closure* c = resource_user->reclaimers[destructive];
@@ -443,14 +465,21 @@ class RuSliceRefcount {
  public:
   static void Destroy(void* p) {
     auto* rc = static_cast<RuSliceRefcount*>(p);
+    const int size_class = rc->size_class_;
     rc->~RuSliceRefcount();
-    gpr_free(rc);
+    if (size_class >= 0) {
+      ReadBufferPool::Free(size_class, rc);
+    } else {
+      gpr_free(rc);
+    }
   }
-  RuSliceRefcount(grpc_resource_user* resource_user, size_t size)
+  RuSliceRefcount(grpc_resource_user* resource_user, size_t size,
+                  int size_class)
       : base_(grpc_slice_refcount::Type::REGULAR, &refs_, Destroy, this,
               &base_),
         resource_user_(resource_user),
-        size_(size) {
+        size_(size),
+        size_class_(size_class) {
     // Nothing to do here.
   }
   ~RuSliceRefcount() { grpc_resource_user_free(resource_user_, size_); }
@@ -462,19 +491,38 @@ class RuSliceRefcount {
   RefCount refs_;
   grpc_resource_user* resource_user_;
   size_t size_;
+  // The ReadBufferPool size class of the slice, or -1 if it was allocated
+  // directly.
+  int size_class_;
 };
 
+static_assert(sizeof(RuSliceRefcount) <= ReadBufferPool::kHeaderSize,
+              "RuSliceRefcount does not fit in a ReadBufferPool header");
+
 }  // namespace grpc_core
 
 static grpc_slice ru_slice_create(grpc_resource_user* resource_user,
                                   size_t size) {
-  auto* rc = static_cast<grpc_core::RuSliceRefcount*>(
-      gpr_malloc(sizeof(grpc_core::RuSliceRefcount) + size));
-  new (rc) grpc_core::RuSliceRefcount(resource_user, size);
+  /* Slices whose size matches a size class of the read buffer pool (which is
+     what endpoints round their reads to) are recycled through the pool */
+  const int size_class = grpc_core::ReadBufferPool::SizeClassFor(size);
+  grpc_core::RuSliceRefcount* rc;
+  uint8_t* bytes;
+  if (size_class >= 0) {
+    void* block = grpc_core::ReadBufferPool::Alloc(size_class);
+    rc = static_cast<grpc_core::RuSliceRefcount*>(block);
+    bytes =
+        static_cast<uint8_t*>(block) + grpc_core::ReadBufferPool::kHeaderSize;
+  } else {
+    rc = static_cast<grpc_core::RuSliceRefcount*>(
+        gpr_malloc(sizeof(grpc_core::RuSliceRefcount) + size));
+    bytes = reinterpret_cast<uint8_t*>(rc + 1);
+  }
+  new (rc) grpc_core::RuSliceRefcount(resource_user, size, size_class);
   grpc_slice slice;
 
   slice.refcount = rc->base_refcount();
-  slice.data.refcounted.bytes = reinterpret_cast<uint8_t*>(rc + 1);
+  slice.data.refcounted.bytes = bytes;
   slice.data.refcounted.length = size;
   return slice;
 }
@@ -583,8 +631,10 @@ static void ru_destroy(void* ru, grpc_error* /*error*/) {
                           GRPC_ERROR_CANCELLED);
   grpc_core::ExecCtx::Run(DEBUG_LOCATION, resource_user->reclaimers[1],
                           GRPC_ERROR_CANCELLED);
-  if (resource_user->free_pool != 0) {
-    resource_user->resource_quota->free_pool += resource_user->free_pool;
+  int64_t free_pool =
+      resource_user->free_pool.Load(grpc_core::MemoryOrder::RELAXED);
+  if (free_pool != 0) {
+    resource_user->resource_quota->free_pool += free_pool;
     rq_step_sched(resource_user->resource_quota);
   }
   grpc_resource_quota_unref_internal(resource_user->resource_quota);
@@ -791,7 +841,7 @@ grpc_resource_user* grpc_resource_user_create(
   gpr_mu_init(&resource_user->mu);
   gpr_atm_rel_store(&resource_user->refs, 1);
   gpr_atm_rel_store(&resource_user->shutdown, 0);
-  resource_user->free_pool = 0;
+  resource_user->free_pool.Store(0, grpc_core::MemoryOrder::RELAXED);
   grpc_closure_list_init(&resource_user->on_allocated);
   resource_user->allocating = false;
   resource_user->added_to_free_pool = false;
@@ -883,17 +933,61 @@ void grpc_resource_user_free_threads(grpc_resource_user* resource_user,
   gpr_mu_unlock(&resource_user->resource_quota->thread_count_mu);
 }
 
+/* Takes size bytes from the user's free pool without holding mu, if the pool
+   holds that many. Returns false, changing nothing, otherwise. */
+static bool ru_try_alloc_from_free_pool(grpc_resource_user* resource_user,
+                                        size_t size) {
+  int64_t free_pool =
+      resource_user->free_pool.Load(grpc_core::MemoryOrder::RELAXED);
+  do {
+    if (free_pool < static_cast<int64_t>(size)) return false;
+  } while (!resource_user->free_pool.CompareExchangeWeak(
+      &free_pool, free_pool - static_cast<int64_t>(size),
+      grpc_core::MemoryOrder::RELAXED, grpc_core::MemoryOrder::RELAXED));
+  ru_ref_by(resource_user, static_cast<gpr_atm>(size));
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
+    gpr_log(GPR_INFO, "RQ %s %s: alloc %" PRIdPTR "; free_pool -> %" PRId64,
+            resource_user->resource_quota->name.c_str(),
+            resource_user->name.c_str(), size,
+            free_pool - static_cast<int64_t>(size));
+  }
+  return true;
+}
+
+/* Returns size bytes to the user's free pool without holding mu, if the pool is
+   already non-empty (and so needs neither to complete pending allocations nor
+   to be published to the quota). Returns false, changing nothing, otherwise. */
+static bool ru_try_free_to_free_pool(grpc_resource_user* resource_user,
+                                     size_t size) {
+  int64_t free_pool =
+      resource_user->free_pool.Load(grpc_core::MemoryOrder::RELAXED);
+  do {
+    if (free_pool <= 0) return false;
+  } while (!resource_user->free_pool.CompareExchangeWeak(
+      &free_pool, free_pool + static_cast<int64_t>(size),
+      grpc_core::MemoryOrder::RELAXED, grpc_core::MemoryOrder::RELAXED));
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
+    gpr_log(GPR_INFO, "RQ %s %s: free %" PRIdPTR "; free_pool -> %" PRId64,
+            resource_user->resource_quota->name.c_str(),
+            resource_user->name.c_str(), size,
+            free_pool + static_cast<int64_t>(size));
+  }
+  return true;
+}
+
 static bool resource_user_alloc_locked(grpc_resource_user* resource_user,
                                        size_t size,
                                        grpc_closure* optional_on_done) {
   ru_ref_by(resource_user, static_cast<gpr_atm>(size));
-  resource_user->free_pool -= static_cast<int64_t>(size);
+  int64_t free_pool = resource_user->free_pool.FetchSub(
+                          size, grpc_core::MemoryOrder::RELAXED) -
+                      static_cast<int64_t>(size);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
     gpr_log(GPR_INFO, "RQ %s %s: alloc %" PRIdPTR "; free_pool -> %" PRId64,
             resource_user->resource_quota->name.c_str(),
-            resource_user->name.c_str(), size, resource_user->free_pool);
+            resource_user->name.c_str(), size, free_pool);
   }
-  if (GPR_LIKELY(resource_user->free_pool >= 0)) return true;
+  if (GPR_LIKELY(free_pool >= 0)) return true;
   // Slow path: We need to wait for the free pool to refill.
   if (optional_on_done != nullptr) {
     resource_user->outstanding_allocations += static_cast<int64_t>(size);
@@ -911,7 +1005,6 @@ static bool resource_user_alloc_locked(grpc_resource_user* resource_user,
 bool grpc_resource_user_safe_alloc(grpc_resource_user* resource_user,
                                    size_t size) {
   if (gpr_atm_no_barrier_load(&resource_user->shutdown)) return false;
-  gpr_mu_lock(&resource_user->mu);
   grpc_resource_quota* resource_quota = resource_user->resource_quota;
   bool cas_success;
   do {
@@ -919,11 +1012,12 @@ bool grpc_resource_user_safe_alloc(grpc_resource_user* resource_user,
     gpr_atm new_used = used + size;
     if (static_cast<size_t>(new_used) >
         grpc_resource_quota_peek_size(resource_quota)) {
-      gpr_mu_unlock(&resource_user->mu);
       return false;
     }
     cas_success = gpr_atm_full_cas(&resource_quota->used, used, new_used);
   } while (!cas_success);
+  if (ru_try_alloc_from_free_pool(resource_user, size)) return true;
+  gpr_mu_lock(&resource_user->mu);
   resource_user_alloc_locked(resource_user, size, nullptr);
   gpr_mu_unlock(&resource_user->mu);
   return true;
@@ -933,9 +1027,13 @@ bool grpc_resource_user_alloc(grpc_resource_user* resource_user, size_t size,
                               grpc_closure* optional_on_done) {
   // TODO(juanlishen): Maybe return immediately if shutting down. Deferring this
   // because some tests become flaky after the change.
-  gpr_mu_lock(&resource_user->mu);
   grpc_resource_quota* resource_quota = resource_user->resource_quota;
   gpr_atm_no_barrier_fetch_add(&resource_quota->used, size);
+  // Fast path: the memory is already cached by this user.
+  if (GPR_LIKELY(ru_try_alloc_from_free_pool(resource_user, size))) {
+    return true;
+  }
+  gpr_mu_lock(&resource_user->mu);
   const bool ret =
       resource_user_alloc_locked(resource_user, size, optional_on_done);
   gpr_mu_unlock(&resource_user->mu);
@@ -943,18 +1041,26 @@ bool grpc_resource_user_alloc(grpc_resource_user* resource_user, size_t size,
 }
 
 void grpc_resource_user_free(grpc_resource_user* resource_user, size_t size) {
-  gpr_mu_lock(&resource_user->mu);
   grpc_resource_quota* resource_quota = resource_user->resource_quota;
   gpr_atm prior = gpr_atm_no_barrier_fetch_add(&resource_quota->used, -size);
   GPR_ASSERT(prior >= static_cast<long>(size));
-  bool was_zero_or_negative = resource_user->free_pool <= 0;
-  resource_user->free_pool += static_cast<int64_t>(size);
+  // Fast path: the free pool is already non-empty, so no transition to
+  // publish.
+  if (GPR_LIKELY(ru_try_free_to_free_pool(resource_user, size))) {
+    ru_unref_by(resource_user, static_cast<gpr_atm>(size));
+    return;
+  }
+  gpr_mu_lock(&resource_user->mu);
+  int64_t free_pool =
+      resource_user->free_pool.FetchAdd(size, grpc_core::MemoryOrder::RELAXED);
+  bool was_zero_or_negative = free_pool <= 0;
+  free_pool += static_cast<int64_t>(size);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
     gpr_log(GPR_INFO, "RQ %s %s: free %" PRIdPTR "; free_pool -> %" PRId64,
             resource_user->resource_quota->name.c_str(),
-            resource_user->name.c_str(), size, resource_user->free_pool);
+            resource_user->name.c_str(), size, free_pool);
   }
-  bool is_bigger_than_zero = resource_user->free_pool > 0;
+  bool is_bigger_than_zero = free_pool > 0;
   if (is_bigger_than_zero && was_zero_or_negative &&
       !resource_user->added_to_free_pool) {
     resource_user->added_to_free_pool = true;
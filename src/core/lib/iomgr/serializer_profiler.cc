@@ -0,0 +1,248 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/serializer_profiler.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+#ifdef GRPC_SERIALIZER_PROFILING
+
+namespace {
+
+// At most this many serializers and locations are rendered
+constexpr size_t kMaxRenderedSerializers = 100;
+constexpr size_t kMaxRenderedLocations = 20;
+
+struct LocationStats {
+  uint64_t items_run = 0;
+  uint64_t queue_time_us = 0;
+  uint64_t exec_time_us = 0;
+};
+
+// Location stats are kept per cpu, so that serializers running on different
+// cpus do not contend on a single lock.
+struct LocationShard {
+  gpr_mu mu;
+  std::map<std::pair<const char*, int>, LocationStats> locations;
+};
+
+gpr_once g_init_once = GPR_ONCE_INIT;
+gpr_mu g_registry_mu;
+SerializerProfile* g_registry_head;
+size_t g_num_shards;
+LocationShard* g_shards;
+
+void InitProfiler() {
+  gpr_mu_init(&g_registry_mu);
+  g_num_shards = GPR_MAX(1, gpr_cpu_num_cores());
+  g_shards = new LocationShard[g_num_shards];
+  for (size_t i = 0; i < g_num_shards; i++) {
+    gpr_mu_init(&g_shards[i].mu);
+  }
+}
+
+uint64_t MicrosBetween(gpr_cycle_counter start, gpr_cycle_counter end) {
+  if (end <= start) return 0;
+  gpr_timespec elapsed = gpr_cycle_counter_sub(end, start);
+  return static_cast<uint64_t>(elapsed.tv_sec) * GPR_US_PER_SEC +
+         elapsed.tv_nsec / GPR_NS_PER_US;
+}
+
+}  // namespace
+
+void SerializerProfile::Histogram::Add(uint64_t value) {
+  int bucket = 0;
+  while (bucket < kBuckets - 1 && value >= (uint64_t(1) << bucket)) {
+    bucket++;
+  }
+  buckets_[bucket].FetchAdd(1, MemoryOrder::RELAXED);
+  sum_.FetchAdd(value, MemoryOrder::RELAXED);
+}
+
+Json SerializerProfile::Histogram::RenderJson() const {
+  uint64_t count = 0;
+  Json::Array buckets;
+  for (int i = 0; i < kBuckets; i++) {
+    uint64_t bucket_count = buckets_[i].Load(MemoryOrder::RELAXED);
+    if (bucket_count == 0) continue;
+    count += bucket_count;
+    buckets.emplace_back(Json::Object{
+        {"min", std::to_string(i == 0 ? 0 : uint64_t(1) << (i - 1))},
+        {"count", std::to_string(bucket_count)},
+    });
+  }
+  return Json::Object{
+      {"count", std::to_string(count)},
+      {"sum", std::to_string(sum())},
+      {"bucket", std::move(buckets)},
+  };
+}
+
+SerializerProfile::SerializerProfile(Kind kind) : kind_(kind) {
+  gpr_once_init(&g_init_once, InitProfiler);
+  gpr_mu_lock(&g_registry_mu);
+  next_ = g_registry_head;
+  if (next_ != nullptr) next_->prev_ = this;
+  g_registry_head = this;
+  gpr_mu_unlock(&g_registry_mu);
+}
+
+SerializerProfile::~SerializerProfile() {
+  gpr_mu_lock(&g_registry_mu);
+  if (prev_ != nullptr) {
+    prev_->next_ = next_;
+  } else {
+    g_registry_head = next_;
+  }
+  if (next_ != nullptr) next_->prev_ = prev_;
+  gpr_mu_unlock(&g_registry_mu);
+}
+
+gpr_cycle_counter SerializerProfile::ItemQueued(size_t depth) {
+  queue_depth_.Add(depth);
+  // Stats are sharded by the cpu the current ExecCtx started on, and work
+  // serializers may run outside of one.
+  if (ExecCtx::Get() != nullptr) {
+    if (kind_ == Kind::kCombiner) {
+      GRPC_STATS_INC_COMBINER_QUEUE_DEPTH(depth);
+    } else {
+      GRPC_STATS_INC_WORK_SERIALIZER_QUEUE_DEPTH(depth);
+    }
+  }
+  return gpr_get_cycle_counter();
+}
+
+void SerializerProfile::ItemRan(const char* file, int line,
+                                gpr_cycle_counter queued_at,
+                                gpr_cycle_counter started_at) {
+  const uint64_t queue_time_us = MicrosBetween(queued_at, started_at);
+  const uint64_t exec_time_us =
+      MicrosBetween(started_at, gpr_get_cycle_counter());
+  queue_time_us_.Add(queue_time_us);
+  exec_time_us_.Add(exec_time_us);
+  if (ExecCtx::Get() != nullptr) {
+    if (kind_ == Kind::kCombiner) {
+      GRPC_STATS_INC_COMBINER_QUEUE_TIME(queue_time_us);
+      GRPC_STATS_INC_COMBINER_EXEC_TIME(exec_time_us);
+    } else {
+      GRPC_STATS_INC_WORK_SERIALIZER_QUEUE_TIME(queue_time_us);
+      GRPC_STATS_INC_WORK_SERIALIZER_EXEC_TIME(exec_time_us);
+    }
+  }
+  LocationShard& shard =
+      g_shards[static_cast<size_t>(gpr_cpu_current_cpu()) % g_num_shards];
+  gpr_mu_lock(&shard.mu);
+  LocationStats& stats = shard.locations[std::make_pair(file, line)];
+  stats.items_run++;
+  stats.queue_time_us += queue_time_us;
+  stats.exec_time_us += exec_time_us;
+  gpr_mu_unlock(&shard.mu);
+}
+
+Json SerializerProfile::RenderJson() const {
+  return Json::Object{
+      {"kind", kind_ == Kind::kCombiner ? "combiner" : "workSerializer"},
+      {"queueDepth", queue_depth_.RenderJson()},
+      {"queueTimeUs", queue_time_us_.RenderJson()},
+      {"execTimeUs", exec_time_us_.RenderJson()},
+  };
+}
+
+Json RenderSerializerProfiles() {
+  gpr_once_init(&g_init_once, InitProfiler);
+  // Live serializers, by the time spent running their items.
+  std::vector<std::pair<uint64_t, Json>> serializers;
+  gpr_mu_lock(&g_registry_mu);
+  for (SerializerProfile* profile = g_registry_head; profile != nullptr;
+       profile = profile->next_) {
+    serializers.emplace_back(profile->exec_time_us_.sum(),
+                             profile->RenderJson());
+  }
+  gpr_mu_unlock(&g_registry_mu);
+  std::stable_sort(serializers.begin(), serializers.end(),
+                   [](const std::pair<uint64_t, Json>& a,
+                      const std::pair<uint64_t, Json>& b) {
+                     return a.first > b.first;
+                   });
+  Json::Array serializer_array;
+  for (size_t i = 0; i < serializers.size() && i < kMaxRenderedSerializers;
+       i++) {
+    serializer_array.emplace_back(std::move(serializers[i].second));
+  }
+  // Locations, merged across shards. The same file may be referred to by
+  // different pointers from different translation units.
+  std::map<std::pair<std::string, int>, LocationStats> merged;
+  for (size_t i = 0; i < g_num_shards; i++) {
+    gpr_mu_lock(&g_shards[i].mu);
+    for (const auto& p : g_shards[i].locations) {
+      LocationStats& stats = merged[std::make_pair(
+          std::string(p.first.first == nullptr ? "<unknown>" : p.first.first),
+          p.first.second)];
+      stats.items_run += p.second.items_run;
+      stats.queue_time_us += p.second.queue_time_us;
+      stats.exec_time_us += p.second.exec_time_us;
+    }
+    gpr_mu_unlock(&g_shards[i].mu);
+  }
+  std::vector<std::pair<std::string, LocationStats>> locations;
+  for (const auto& p : merged) {
+    locations.emplace_back(
+        p.first.first + ":" + std::to_string(p.first.second), p.second);
+  }
+  std::stable_sort(locations.begin(), locations.end(),
+                   [](const std::pair<std::string, LocationStats>& a,
+                      const std::pair<std::string, LocationStats>& b) {
+                     return a.second.exec_time_us > b.second.exec_time_us;
+                   });
+  Json::Array location_array;
+  for (size_t i = 0; i < locations.size() && i < kMaxRenderedLocations; i++) {
+    location_array.emplace_back(Json::Object{
+        {"location", locations[i].first},
+        {"itemsRun", std::to_string(locations[i].second.items_run)},
+        {"queueTimeUs", std::to_string(locations[i].second.queue_time_us)},
+        {"execTimeUs", std::to_string(locations[i].second.exec_time_us)},
+    });
+  }
+  return Json::Object{
+      {"serializer", std::move(serializer_array)},
+      {"location", std::move(location_array)},
+  };
+}
+
+#else  // GRPC_SERIALIZER_PROFILING
+
+Json RenderSerializerProfiles() { return Json::Object(); }
+
+#endif  // GRPC_SERIALIZER_PROFILING
+
+}  // namespace grpc_core
@@ -0,0 +1,107 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_SERIALIZER_PROFILER_H
+#define GRPC_CORE_LIB_IOMGR_SERIALIZER_PROFILER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/json/json.h"
+
+// Contention profiling for combiners and work serializers.
+//
+// Builds defining GRPC_SERIALIZER_PROFILING record, for every combiner and
+// work serializer, how many items are queued on it, how long items wait before
+// running and how long they run for. The time is also attributed to the
+// location each item was created at (its DEBUG_LOCATION, or the place its
+// closure was initialized at). The process-wide distributions are exported as
+// the combiner_* and work_serializer_* histograms of stats_data.yaml, and the
+// per-serializer data and the costliest locations through
+// grpc_channelz_get_serializer_profile().
+//
+// Without GRPC_SERIALIZER_PROFILING, none of this is compiled in.
+
+namespace grpc_core {
+
+#ifdef GRPC_SERIALIZER_PROFILING
+
+// The profile of a single combiner or work serializer. Profiles register
+// themselves on construction, so that they can be rendered while alive.
+class SerializerProfile {
+ public:
+  enum class Kind { kCombiner, kWorkSerializer };
+
+  explicit SerializerProfile(Kind kind);
+  ~SerializerProfile();
+
+  SerializerProfile(const SerializerProfile&) = delete;
+  SerializerProfile& operator=(const SerializerProfile&) = delete;
+
+  // Records that an item was queued, with \a depth items queued including it.
+  // Returns the time to pass to ItemRan().
+  gpr_cycle_counter ItemQueued(size_t depth);
+
+  // Records that an item created at \a file:\a line, queued at \a queued_at,
+  // ran from \a started_at until now.
+  void ItemRan(const char* file, int line, gpr_cycle_counter queued_at,
+               gpr_cycle_counter started_at);
+
+  Json RenderJson() const;
+
+ private:
+  // Counts values into power of two buckets: bucket i holds values in
+  // [2^(i-1), 2^i), bucket 0 holds zeros.
+  class Histogram {
+   public:
+    static constexpr int kBuckets = 33;
+
+    void Add(uint64_t value);
+    uint64_t sum() const { return sum_.Load(MemoryOrder::RELAXED); }
+    Json RenderJson() const;
+
+   private:
+    Atomic<uint64_t> buckets_[kBuckets];
+    Atomic<uint64_t> sum_;
+  };
+
+  friend Json RenderSerializerProfiles();
+
+  const Kind kind_;
+  Histogram queue_depth_;
+  Histogram queue_time_us_;
+  Histogram exec_time_us_;
+  // Registry links, protected by the registry lock
+  SerializerProfile* prev_ = nullptr;
+  SerializerProfile* next_ = nullptr;
+};
+
+#endif  // GRPC_SERIALIZER_PROFILING
+
+// Renders the profiles of the live combiners and work serializers, busiest
+// first, and the locations the most time was spent running items from. Returns
+// an empty object when GRPC_SERIALIZER_PROFILING is not defined.
+Json RenderSerializerProfiles();
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_IOMGR_SERIALIZER_PROFILER_H */
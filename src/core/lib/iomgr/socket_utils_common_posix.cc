@@ -209,6 +209,63 @@ grpc_error* grpc_set_socket_reuse_port(int fd, int reuse) {
 #endif
 }
 
+grpc_error* grpc_set_socket_incoming_cpu(int fd, int cpu) {
+#ifndef SO_INCOMING_CPU
+  (void)fd;
+  (void)cpu;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "SO_INCOMING_CPU unavailable on compiling system");
+#else
+  if (0 != setsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, &cpu, sizeof(cpu))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(SO_INCOMING_CPU)");
+  }
+  return GRPC_ERROR_NONE;
+#endif
+}
+
+int grpc_get_socket_incoming_cpu(int fd) {
+#ifndef SO_INCOMING_CPU
+  (void)fd;
+  return -1;
+#else
+  int cpu;
+  socklen_t intlen = sizeof(cpu);
+  if (0 != getsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, &cpu, &intlen)) {
+    return -1;
+  }
+  return cpu;
+#endif
+}
+
+grpc_error* grpc_set_socket_busy_poll(int fd, int usec) {
+#ifndef SO_BUSY_POLL
+  (void)fd;
+  (void)usec;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "SO_BUSY_POLL unavailable on compiling system");
+#else
+  if (0 != setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(usec))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(SO_BUSY_POLL)");
+  }
+  return GRPC_ERROR_NONE;
+#endif
+}
+
+grpc_error* grpc_set_socket_prefer_busy_poll(int fd) {
+#ifndef SO_PREFER_BUSY_POLL
+  (void)fd;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "SO_PREFER_BUSY_POLL unavailable on compiling system");
+#else
+  int prefer = 1;
+  if (0 != setsockopt(fd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &prefer,
+                      sizeof(prefer))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(SO_PREFER_BUSY_POLL)");
+  }
+  return GRPC_ERROR_NONE;
+#endif
+}
+
 static gpr_once g_probe_so_reuesport_once = GPR_ONCE_INIT;
 static int g_support_so_reuseport = false;
 
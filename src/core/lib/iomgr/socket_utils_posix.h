@@ -65,6 +65,22 @@ grpc_error* grpc_set_socket_low_latency(int fd, int low_latency);
 /* set SO_REUSEPORT */
 grpc_error* grpc_set_socket_reuse_port(int fd, int reuse);
 
+/* set SO_INCOMING_CPU: within a SO_REUSEPORT group, connections received on
+   \a cpu are preferably accepted by this socket */
+grpc_error* grpc_set_socket_incoming_cpu(int fd, int cpu);
+
+/* return the CPU that processed the most recent packets of \a fd
+   (SO_INCOMING_CPU), or -1 if it is unknown */
+int grpc_get_socket_incoming_cpu(int fd);
+
+/* set SO_BUSY_POLL to \a usec: reads that find no data busy poll the device
+   queue for up to \a usec microseconds before sleeping */
+grpc_error* grpc_set_socket_busy_poll(int fd, int usec);
+
+/* set SO_PREFER_BUSY_POLL, which keeps the device from raising interrupts
+   while \a fd is busy polled */
+grpc_error* grpc_set_socket_prefer_busy_poll(int fd);
+
 /* Configure the default values for TCP_USER_TIMEOUT */
 void config_default_tcp_user_timeout(bool enable, int timeout, bool is_client);
 
@@ -29,9 +29,11 @@
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -54,8 +56,10 @@
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/executor.h"
+#include "src/core/lib/iomgr/read_buffer_pool.h"
 #include "src/core/lib/iomgr/sockaddr_utils.h"
 #include "src/core/lib/iomgr/socket_utils_posix.h"
+#include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
@@ -84,6 +88,12 @@
 #define MSG_ZEROCOPY 0x4000000
 #endif
 
+// TCP zero copy receive socket option. As with MSG_ZEROCOPY, this is a
+// fallback for library headers that predate it.
+#ifndef TCP_ZEROCOPY_RECEIVE
+#define TCP_ZEROCOPY_RECEIVE 35
+#endif
+
 #ifdef GRPC_MSG_IOVLEN_TYPE
 typedef GRPC_MSG_IOVLEN_TYPE msg_iovlen_type;
 #else
@@ -346,6 +356,56 @@ class TcpZerocopySendCtx {
   bool memory_limited_ = false;
 };
 
+// The argument of getsockopt(TCP_ZEROCOPY_RECEIVE). This is the prefix of the
+// kernel's struct tcp_zerocopy_receive that we use; kernels older than 5.3
+// only know the first three fields and report the smaller size via optlen.
+struct TcpZerocopyReceiveArgs {
+  uint64_t address;         // in: address of the mapping
+  uint32_t length;          // in/out: number of bytes to map/mapped
+  uint32_t recv_skip_hint;  // out: unaligned bytes to read with recvmsg()
+  uint32_t inq;             // out: bytes left in the receive queue
+  int32_t err;              // out: pending socket error
+};
+
+// Owns a read-only mapping of received pages, and is the refcount of the slice
+// that exposes those pages to the upper layers. The pages are given back to
+// the kernel, and their memory to the resource quota, once the last ref to the
+// slice is dropped.
+class TcpZerocopyReceiveRefcount {
+ public:
+  static void Destroy(void* p) {
+    delete static_cast<TcpZerocopyReceiveRefcount*>(p);
+  }
+  TcpZerocopyReceiveRefcount(void* address, size_t length,
+                             grpc_resource_user* resource_user)
+      : base_(grpc_slice_refcount::Type::REGULAR, &refs_, Destroy, this,
+              &base_),
+        address_(address),
+        length_(length),
+        resource_user_(resource_user) {}
+  ~TcpZerocopyReceiveRefcount() {
+    munmap(address_, length_);
+    grpc_resource_user_free(resource_user_, length_);
+  }
+
+  // Returns the slice spanning the whole mapping. The slice takes over the
+  // initial ref.
+  grpc_slice slice() {
+    grpc_slice slice;
+    slice.refcount = &base_;
+    slice.data.refcounted.bytes = static_cast<uint8_t*>(address_);
+    slice.data.refcounted.length = length_;
+    return slice;
+  }
+
+ private:
+  grpc_slice_refcount base_;
+  RefCount refs_;
+  void* address_;
+  size_t length_;
+  grpc_resource_user* resource_user_;
+};
+
 }  // namespace grpc_core
 
 using grpc_core::TcpZerocopySendCtx;
@@ -376,6 +436,26 @@ struct grpc_tcp {
   int inq;          /* bytes pending on the socket from the last read. */
   bool inq_capable; /* cache whether kernel supports inq */
 
+  bool rx_zerocopy_enabled; /* map received pages instead of copying them */
+  /* only zerocopy when at least this many bytes are pending on the socket */
+  size_t rx_zerocopy_threshold_bytes;
+  /* bytes at the head of the receive queue that cannot be mapped, as reported
+     by the last zerocopy receive; these are read with recvmsg() first */
+  size_t rx_zerocopy_skip_bytes;
+
+  /* Idle mode: spare read buffers are released once the endpoint has waited
+     this long for incoming bytes. Negative disables idle mode. */
+  int idle_release_ms;
+  gpr_mu idle_mu;
+  /* spare read buffers put aside while waiting for incoming bytes */
+  grpc_slice_buffer idle_read_buffer; /* guarded by idle_mu */
+  grpc_millis idle_since;             /* guarded by idle_mu */
+  bool idle_timer_pending;            /* guarded by idle_mu */
+  bool idle_buffers_released;         /* guarded by idle_mu */
+  bool idle_shutdown;                 /* guarded by idle_mu */
+  grpc_timer idle_timer;
+  grpc_closure idle_timer_closure;
+
   grpc_slice_buffer* outgoing_buffer;
   /* byte within outgoing_buffer->slices[0] to write next */
   size_t outgoing_byte_idx;
@@ -595,6 +675,11 @@ static size_t get_target_read_size(grpc_tcp* tcp) {
                                               tcp->max_read_chunk_size)) +
                255) &
               ~static_cast<size_t>(255);
+  /* Reads that fit a read buffer pool size class use the whole buffer of that
+     class, so that their slices can be recycled across endpoints. The classes
+     are close enough that this wastes at most half of a large read. */
+  sz = std::min(grpc_core::ReadBufferPool::RoundUp(sz),
+                static_cast<size_t>(tcp->max_read_chunk_size));
   /* don't use more than 1/16th of the overall resource quota for a single read
    * alloc */
   size_t rqmax = grpc_resource_quota_peek_size(rq);
@@ -618,9 +703,12 @@ static grpc_error* tcp_annotate_error(grpc_error* src_error, grpc_tcp* tcp) {
 static void tcp_handle_read(void* arg /* grpc_tcp */, grpc_error* error);
 static void tcp_handle_write(void* arg /* grpc_tcp */, grpc_error* error);
 
+static void tcp_stop_idle_timer(grpc_tcp* tcp);
+
 static void tcp_shutdown(grpc_endpoint* ep, grpc_error* why) {
   grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
   ZerocopyDisableAndWaitForRemaining(tcp);
+  tcp_stop_idle_timer(tcp);
   grpc_fd_shutdown(tcp->em_fd, why);
   grpc_resource_user_shutdown(tcp->resource_user);
 }
@@ -629,6 +717,8 @@ static void tcp_free(grpc_tcp* tcp) {
   grpc_fd_orphan(tcp->em_fd, tcp->release_fd_cb, tcp->release_fd,
                  "tcp_unref_orphan");
   grpc_slice_buffer_destroy_internal(&tcp->last_read_buffer);
+  grpc_slice_buffer_destroy_internal(&tcp->idle_read_buffer);
+  gpr_mu_destroy(&tcp->idle_mu);
   grpc_resource_user_unref(tcp->resource_user);
   /* The lock is not really necessary here, since all refs have been released */
   gpr_mu_lock(&tcp->tb_mu);
@@ -670,6 +760,7 @@ static void tcp_ref(grpc_tcp* tcp) { tcp->refcount.Ref(); }
 static void tcp_destroy(grpc_endpoint* ep) {
   grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
   grpc_slice_buffer_reset_and_unref_internal(&tcp->last_read_buffer);
+  tcp_stop_idle_timer(tcp);
   if (grpc_event_engine_can_track_errors()) {
     ZerocopyDisableAndWaitForRemaining(tcp);
     gpr_atm_no_barrier_store(&tcp->stop_error_notification, true);
@@ -703,6 +794,89 @@ static void call_read_cb(grpc_tcp* tcp, grpc_error* error) {
   grpc_core::Closure::Run(DEBUG_LOCATION, cb, error);
 }
 
+/* Called before waiting for the socket to become readable. In idle mode, the
+ * spare buffers of incoming_buffer are put aside, and released if the wait
+ * lasts longer than tcp->idle_release_ms: an idle connection then holds no read
+ * buffers at all, and the next read allocates them again once the poller
+ * reports the socket readable. */
+static void tcp_park_read_buffers(grpc_tcp* tcp) {
+  if (tcp->idle_release_ms < 0 || tcp->incoming_buffer->count == 0) return;
+  gpr_mu_lock(&tcp->idle_mu);
+  if (tcp->idle_release_ms == 0 || tcp->idle_shutdown) {
+    grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
+    tcp->idle_buffers_released = true;
+    GRPC_STATS_INC_TCP_IDLE_READ_BUFFERS_RELEASED();
+  } else {
+    grpc_slice_buffer_swap(tcp->incoming_buffer, &tcp->idle_read_buffer);
+    tcp->idle_since = grpc_core::ExecCtx::Get()->Now();
+    /* A busy endpoint parks its buffers on every read: rather than re-arming
+     * the timer each time, an expired timer checks whether the current wait
+     * has lasted long enough (see tcp_handle_idle_timer()). */
+    if (!tcp->idle_timer_pending) {
+      tcp->idle_timer_pending = true;
+      TCP_REF(tcp, "idle_timer");
+      grpc_timer_init(&tcp->idle_timer, tcp->idle_since + tcp->idle_release_ms,
+                      &tcp->idle_timer_closure);
+    }
+  }
+  gpr_mu_unlock(&tcp->idle_mu);
+}
+
+/* Called once the socket is readable: takes back the spare buffers put aside by
+ * tcp_park_read_buffers(). Returns true if they were released in the
+ * meantime. */
+static bool tcp_unpark_read_buffers(grpc_tcp* tcp) {
+  if (tcp->idle_release_ms < 0) return false;
+  gpr_mu_lock(&tcp->idle_mu);
+  grpc_slice_buffer_move_into(&tcp->idle_read_buffer, tcp->incoming_buffer);
+  bool released = tcp->idle_buffers_released;
+  tcp->idle_buffers_released = false;
+  gpr_mu_unlock(&tcp->idle_mu);
+  return released;
+}
+
+static void tcp_handle_idle_timer(void* arg /* grpc_tcp */, grpc_error* error) {
+  grpc_tcp* tcp = static_cast<grpc_tcp*>(arg);
+  grpc_slice_buffer released;
+  grpc_slice_buffer_init(&released);
+  gpr_mu_lock(&tcp->idle_mu);
+  tcp->idle_timer_pending = false;
+  if (tcp->idle_read_buffer.count > 0) {
+    grpc_millis deadline = tcp->idle_since + tcp->idle_release_ms;
+    if (error == GRPC_ERROR_NONE && !tcp->idle_shutdown &&
+        deadline > grpc_core::ExecCtx::Get()->Now()) {
+      /* The endpoint has read since the timer was armed: wait for the rest of
+       * the current idle period. */
+      tcp->idle_timer_pending = true;
+      grpc_timer_init(&tcp->idle_timer, deadline, &tcp->idle_timer_closure);
+      gpr_mu_unlock(&tcp->idle_mu);
+      return;
+    }
+    grpc_slice_buffer_swap(&tcp->idle_read_buffer, &released);
+    tcp->idle_buffers_released = true;
+  }
+  gpr_mu_unlock(&tcp->idle_mu);
+  if (released.count > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
+      gpr_log(GPR_INFO, "TCP:%p released %" PRIuPTR " idle read bytes", tcp,
+              released.length);
+    }
+    GRPC_STATS_INC_TCP_IDLE_READ_BUFFERS_RELEASED();
+  }
+  grpc_slice_buffer_destroy_internal(&released);
+  TCP_UNREF(tcp, "idle_timer");
+}
+
+static void tcp_stop_idle_timer(grpc_tcp* tcp) {
+  if (tcp->idle_release_ms <= 0) return;
+  gpr_mu_lock(&tcp->idle_mu);
+  tcp->idle_shutdown = true;
+  if (tcp->idle_timer_pending) {
+    grpc_timer_cancel(&tcp->idle_timer);
+  }
+  gpr_mu_unlock(&tcp->idle_mu);
+}
+
 #define MAX_READ_IOVEC 4
 static void tcp_do_read(grpc_tcp* tcp) {
   GPR_TIMER_SCOPE("tcp_do_read", 0);
@@ -765,6 +939,7 @@ static void tcp_do_read(grpc_tcp* tcp) {
       if (errno == EAGAIN) {
         finish_estimate(tcp);
         tcp->inq = 0;
+        tcp_park_read_buffers(tcp);
         /* We've consumed the edge, request a new one */
         notify_on_read(tcp);
       } else {
@@ -841,6 +1016,8 @@ static void tcp_do_read(grpc_tcp* tcp) {
   }
 
   GPR_DEBUG_ASSERT(total_read_bytes > 0);
+  tcp->rx_zerocopy_skip_bytes -=
+      std::min(tcp->rx_zerocopy_skip_bytes, total_read_bytes);
   if (total_read_bytes < tcp->incoming_buffer->length) {
     grpc_slice_buffer_trim_end(tcp->incoming_buffer,
                                tcp->incoming_buffer->length - total_read_bytes,
@@ -850,6 +1027,90 @@ static void tcp_do_read(grpc_tcp* tcp) {
   TCP_UNREF(tcp, "read");
 }
 
+#ifdef GRPC_HAVE_TCP_ZEROCOPY_RECEIVE
+static void tcp_disable_rx_zerocopy(grpc_tcp* tcp, const char* reason) {
+  gpr_log(GPR_INFO, "Disabling TCP RX zerocopy on fd %d: %s: %s", tcp->fd,
+          reason, strerror(errno));
+  tcp->rx_zerocopy_enabled = false;
+}
+
+/* Tries to read the bytes pending on the socket by mapping the kernel's receive
+ * pages into a read-only slice, instead of copying them into the slices
+ * allocated for the read. Returns true if the read was completed this way.
+ * Otherwise nothing was consumed from the socket, and the caller falls back to
+ * tcp_do_read(). */
+static bool tcp_do_read_zerocopy(grpc_tcp* tcp) {
+  GPR_TIMER_SCOPE("tcp_do_read_zerocopy", 0);
+  static const size_t kPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  /* Only whole pages can be mapped */
+  size_t length = std::min(static_cast<size_t>(tcp->inq),
+                           static_cast<size_t>(tcp->max_read_chunk_size)) &
+                  ~(kPageSize - 1);
+  if (length == 0 || length < tcp->rx_zerocopy_threshold_bytes) {
+    return false;
+  }
+  /* The mapped pages are charged to the resource quota like the slices of a
+     copying read. Under memory pressure the copying read waits for quota. */
+  if (!grpc_resource_user_safe_alloc(tcp->resource_user, length)) {
+    return false;
+  }
+  void* address = mmap(nullptr, length, PROT_READ, MAP_SHARED, tcp->fd, 0);
+  if (address == MAP_FAILED) {
+    grpc_resource_user_free(tcp->resource_user, length);
+    tcp_disable_rx_zerocopy(tcp, "mmap");
+    return false;
+  }
+  grpc_core::TcpZerocopyReceiveArgs zc;
+  memset(&zc, 0, sizeof(zc));
+  zc.address = reinterpret_cast<uint64_t>(address);
+  zc.length = static_cast<uint32_t>(length);
+  socklen_t zc_len = sizeof(zc);
+  int err;
+  do {
+    GPR_TIMER_SCOPE("getsockopt", 0);
+    GRPC_STATS_INC_SYSCALL_READ();
+    err = getsockopt(tcp->fd, IPPROTO_TCP, TCP_ZEROCOPY_RECEIVE, &zc, &zc_len);
+  } while (err < 0 && errno == EINTR);
+  if (err < 0 || zc.length == 0) {
+    munmap(address, length);
+    grpc_resource_user_free(tcp->resource_user, length);
+    if (err < 0) {
+      /* Socket errors are reported by the recvmsg() of the fallback read */
+      tcp_disable_rx_zerocopy(tcp, "getsockopt(TCP_ZEROCOPY_RECEIVE)");
+    } else {
+      tcp->rx_zerocopy_skip_bytes = zc.recv_skip_hint;
+    }
+    return false;
+  }
+  if (zc.length < length) {
+    munmap(static_cast<char*>(address) + zc.length, length - zc.length);
+    grpc_resource_user_free(tcp->resource_user, length - zc.length);
+  }
+  tcp->rx_zerocopy_skip_bytes = zc.recv_skip_hint;
+  /* Kernels older than 5.3 do not report the bytes left on the socket */
+  if (zc_len >= offsetof(grpc_core::TcpZerocopyReceiveArgs, inq) +
+                    sizeof(zc.inq)) {
+    tcp->inq = static_cast<int>(zc.inq);
+  } else {
+    tcp->inq = 1;
+  }
+
+  GRPC_STATS_INC_TCP_READ_SIZE(zc.length);
+  add_to_estimate(tcp, zc.length);
+  if (tcp->inq == 0) {
+    finish_estimate(tcp);
+  }
+  /* Keep the spare slices of the previous read for the next copying read */
+  grpc_slice_buffer_swap(tcp->incoming_buffer, &tcp->last_read_buffer);
+  auto* refcount = new grpc_core::TcpZerocopyReceiveRefcount(
+      address, zc.length, tcp->resource_user);
+  grpc_slice_buffer_add(tcp->incoming_buffer, refcount->slice());
+  call_read_cb(tcp, GRPC_ERROR_NONE);
+  TCP_UNREF(tcp, "read");
+  return true;
+}
+#endif /* GRPC_HAVE_TCP_ZEROCOPY_RECEIVE */
+
 static void tcp_read_allocation_done(void* tcpp, grpc_error* error) {
   grpc_tcp* tcp = static_cast<grpc_tcp*>(tcpp);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
@@ -867,6 +1128,12 @@ static void tcp_read_allocation_done(void* tcpp, grpc_error* error) {
 }
 
 static void tcp_continue_read(grpc_tcp* tcp) {
+#ifdef GRPC_HAVE_TCP_ZEROCOPY_RECEIVE
+  if (tcp->rx_zerocopy_enabled && tcp->rx_zerocopy_skip_bytes == 0 &&
+      tcp_do_read_zerocopy(tcp)) {
+    return;
+  }
+#endif /* GRPC_HAVE_TCP_ZEROCOPY_RECEIVE */
   size_t target_read_size = get_target_read_size(tcp);
   /* Wait for allocation only when there is no buffer left. */
   if (tcp->incoming_buffer->length == 0 &&
@@ -893,12 +1160,16 @@ static void tcp_handle_read(void* arg /* grpc_tcp */, grpc_error* error) {
     gpr_log(GPR_INFO, "TCP:%p got_read: %s", tcp, grpc_error_string(error));
   }
 
+  bool idle_buffers_released = tcp_unpark_read_buffers(tcp);
   if (GPR_UNLIKELY(error != GRPC_ERROR_NONE)) {
     grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
     grpc_slice_buffer_reset_and_unref_internal(&tcp->last_read_buffer);
     call_read_cb(tcp, GRPC_ERROR_REF(error));
     TCP_UNREF(tcp, "read");
   } else {
+    if (idle_buffers_released) {
+      GRPC_STATS_INC_TCP_IDLE_READ_BUFFERS_REALLOCATED();
+    }
     tcp_continue_read(tcp);
   }
 }
@@ -921,6 +1192,7 @@ static void tcp_read(grpc_endpoint* ep, grpc_slice_buffer* incoming_buffer,
     /* Upper layer asked to read more but we know there is no pending data
      * to read from previous reads. So, wait for POLLIN.
      */
+    tcp_park_read_buffers(tcp);
     notify_on_read(tcp);
   } else {
     /* Not the first time. We may or may not have more bytes available. In any
@@ -1698,6 +1970,9 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
                                const grpc_channel_args* channel_args,
                                const char* peer_string) {
   static constexpr bool kZerocpTxEnabledDefault = false;
+  static constexpr bool kZerocpRxEnabledDefault = false;
+  static constexpr int kZerocpRxRecvBytesThresholdDefault = 64 * 1024;
+  static constexpr int kIdleReadBufferReleaseMsDefault = -1;
   int tcp_read_chunk_size = GRPC_TCP_DEFAULT_READ_SLICE_SIZE;
   int tcp_max_read_chunk_size = 4 * 1024 * 1024;
   int tcp_min_read_chunk_size = 256;
@@ -1706,6 +1981,9 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
       grpc_core::TcpZerocopySendCtx::kDefaultSendBytesThreshold;
   int tcp_tx_zerocopy_max_simult_sends =
       grpc_core::TcpZerocopySendCtx::kDefaultMaxSends;
+  bool tcp_rx_zerocopy_enabled = kZerocpRxEnabledDefault;
+  int tcp_rx_zerocopy_recv_bytes_thresh = kZerocpRxRecvBytesThresholdDefault;
+  int idle_read_buffer_release_ms = kIdleReadBufferReleaseMsDefault;
   grpc_resource_quota* resource_quota = grpc_resource_quota_create(nullptr);
   if (channel_args != nullptr) {
     for (size_t i = 0; i < channel_args->num_args; i++) {
@@ -1747,6 +2025,22 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
             grpc_core::TcpZerocopySendCtx::kDefaultMaxSends, 0, INT_MAX};
         tcp_tx_zerocopy_max_simult_sends =
             grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED)) {
+        tcp_rx_zerocopy_enabled = grpc_channel_arg_get_bool(
+            &channel_args->args[i], kZerocpRxEnabledDefault);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_RX_ZEROCOPY_RECV_BYTES_THRESHOLD)) {
+        grpc_integer_options options = {kZerocpRxRecvBytesThresholdDefault, 0,
+                                        INT_MAX};
+        tcp_rx_zerocopy_recv_bytes_thresh =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_IDLE_READ_BUFFER_RELEASE_MS)) {
+        grpc_integer_options options = {kIdleReadBufferReleaseMsDefault, -1,
+                                        INT_MAX};
+        idle_read_buffer_release_ms =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
       }
     }
   }
@@ -1806,6 +2100,15 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   gpr_atm_no_barrier_store(&tcp->shutdown_count, 0);
   tcp->em_fd = em_fd;
   grpc_slice_buffer_init(&tcp->last_read_buffer);
+  tcp->idle_release_ms = idle_read_buffer_release_ms;
+  gpr_mu_init(&tcp->idle_mu);
+  grpc_slice_buffer_init(&tcp->idle_read_buffer);
+  tcp->idle_since = 0;
+  tcp->idle_timer_pending = false;
+  tcp->idle_buffers_released = false;
+  tcp->idle_shutdown = false;
+  GRPC_CLOSURE_INIT(&tcp->idle_timer_closure, tcp_handle_idle_timer, tcp,
+                    grpc_schedule_on_exec_ctx);
   tcp->resource_user = grpc_resource_user_create(resource_quota, peer_string);
   grpc_resource_user_slice_allocator_init(
       &tcp->slice_allocator, tcp->resource_user, tcp_read_allocation_done, tcp);
@@ -1837,6 +2140,12 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
 #else
   tcp->inq_capable = false;
 #endif /* GRPC_HAVE_TCP_INQ */
+  /* Receive zerocopy relies on TCP_INQ to tell when a read is large enough to
+     be worth mapping. */
+  tcp->rx_zerocopy_enabled = tcp_rx_zerocopy_enabled && tcp->inq_capable;
+  tcp->rx_zerocopy_threshold_bytes =
+      static_cast<size_t>(tcp_rx_zerocopy_recv_bytes_thresh);
+  tcp->rx_zerocopy_skip_bytes = 0;
   /* Start being notified on errors if event engine can track errors. */
   if (grpc_event_engine_can_track_errors()) {
     /* Grab a ref to tcp so that we can safely access the tcp struct when
@@ -1865,6 +2174,7 @@ void grpc_tcp_destroy_and_release_fd(grpc_endpoint* ep, int* fd,
   tcp->release_fd = fd;
   tcp->release_fd_cb = done;
   grpc_slice_buffer_reset_and_unref_internal(&tcp->last_read_buffer);
+  tcp_stop_idle_timer(tcp);
   if (grpc_event_engine_can_track_errors()) {
     /* Stop errors notification. */
     ZerocopyDisableAndWaitForRemaining(tcp);
@@ -60,6 +60,52 @@
 #include "src/core/lib/iomgr/tcp_server_utils_posix.h"
 #include "src/core/lib/iomgr/unix_sockets_posix.h"
 
+/* Checks once, on a throwaway socket, which busy poll options accepted
+   connections can take, so that a kernel or a process without the privileges
+   for them logs one warning rather than an error per connection. */
+static void probe_busy_poll(grpc_tcp_server* s) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    /* This might be an ipv6-only environment */
+    fd = socket(AF_INET6, SOCK_STREAM, 0);
+  }
+  if (fd < 0) {
+    gpr_log(GPR_ERROR, "Failed to probe busy poll support: %s",
+            strerror(errno));
+    s->busy_poll_us = 0;
+    return;
+  }
+  grpc_error* err = grpc_set_socket_busy_poll(fd, s->busy_poll_us);
+  if (err != GRPC_ERROR_NONE) {
+    gpr_log(GPR_ERROR, "Not busy polling accepted connections: %s",
+            grpc_error_string(err));
+    GRPC_ERROR_UNREF(err);
+    s->busy_poll_us = 0;
+  } else {
+    err = grpc_set_socket_prefer_busy_poll(fd);
+    if (err != GRPC_ERROR_NONE) {
+      gpr_log(GPR_INFO,
+              "Busy polling accepted connections without preferring it: %s",
+              grpc_error_string(err));
+      GRPC_ERROR_UNREF(err);
+    } else {
+      s->prefer_busy_poll = true;
+    }
+  }
+  close(fd);
+}
+
+/* Applies the busy poll options probe_busy_poll() found usable to \a fd */
+static void set_busy_poll(grpc_tcp_server* s, int fd) {
+  if (s->busy_poll_us <= 0) return;
+  GRPC_LOG_IF_ERROR("set_socket_busy_poll",
+                    grpc_set_socket_busy_poll(fd, s->busy_poll_us));
+  if (s->prefer_busy_poll) {
+    GRPC_LOG_IF_ERROR("set_socket_prefer_busy_poll",
+                      grpc_set_socket_prefer_busy_poll(fd));
+  }
+}
+
 static grpc_error* tcp_server_create(grpc_closure* shutdown_complete,
                                      const grpc_channel_args* args,
                                      grpc_tcp_server** server) {
@@ -67,6 +113,9 @@ static grpc_error* tcp_server_create(grpc_closure* shutdown_complete,
       static_cast<grpc_tcp_server*>(gpr_zalloc(sizeof(grpc_tcp_server)));
   s->so_reuseport = grpc_is_socket_reuse_port_supported();
   s->expand_wildcard_addrs = false;
+  s->cpu_affinity = false;
+  s->busy_poll_us = 0;
+  s->prefer_busy_poll = false;
   for (size_t i = 0; i < (args == nullptr ? 0 : args->num_args); i++) {
     if (0 == strcmp(GRPC_ARG_ALLOW_REUSEPORT, args->args[i].key)) {
       if (args->args[i].type == GRPC_ARG_INTEGER) {
@@ -85,8 +134,28 @@ static grpc_error* tcp_server_create(grpc_closure* shutdown_complete,
         return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
             GRPC_ARG_EXPAND_WILDCARD_ADDRS " must be an integer");
       }
+    } else if (0 == strcmp(GRPC_ARG_SERVER_CPU_AFFINITY, args->args[i].key)) {
+      if (args->args[i].type == GRPC_ARG_INTEGER) {
+        s->cpu_affinity = (args->args[i].value.integer != 0);
+      } else {
+        gpr_free(s);
+        return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            GRPC_ARG_SERVER_CPU_AFFINITY " must be an integer");
+      }
+    } else if (0 ==
+               strcmp(GRPC_ARG_TCP_SERVER_BUSY_POLL_US, args->args[i].key)) {
+      if (args->args[i].type == GRPC_ARG_INTEGER) {
+        s->busy_poll_us = args->args[i].value.integer;
+      } else {
+        gpr_free(s);
+        return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            GRPC_ARG_TCP_SERVER_BUSY_POLL_US " must be an integer");
+      }
     }
   }
+  if (s->busy_poll_us > 0) {
+    probe_busy_poll(s);
+  }
   gpr_ref_init(&s->refs, 1);
   gpr_mu_init(&s->mu);
   s->active_ports = 0;
@@ -187,6 +256,22 @@ static void tcp_server_destroy(grpc_tcp_server* s) {
   }
 }
 
+/* Picks the pollset that will own a newly accepted connection \a fd: the one
+   matching the CPU that received it when cpu_affinity is set and the kernel
+   reports it, round-robin otherwise. */
+static grpc_pollset* pick_read_notifier_pollset(grpc_tcp_server* s, int fd) {
+  size_t num_pollsets = s->pollsets->size();
+  if (s->cpu_affinity && num_pollsets > 1) {
+    int cpu = grpc_get_socket_incoming_cpu(fd);
+    if (cpu >= 0) {
+      return (*s->pollsets)[static_cast<size_t>(cpu) % num_pollsets];
+    }
+  }
+  return (*s->pollsets)[static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
+                            &s->next_pollset_to_assign, 1)) %
+                        num_pollsets];
+}
+
 /* event manager callback when reads are ready */
 static void on_read(void* arg, grpc_error* err) {
   grpc_tcp_listener* sp = static_cast<grpc_tcp_listener*>(arg);
@@ -237,6 +322,7 @@ static void on_read(void* arg, grpc_error* err) {
     }
 
     grpc_set_socket_no_sigpipe_if_possible(fd);
+    set_busy_poll(sp->server, fd);
 
     std::string addr_str = grpc_sockaddr_to_uri(&addr);
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
@@ -247,10 +333,7 @@ static void on_read(void* arg, grpc_error* err) {
     std::string name = absl::StrCat("tcp-server-connection:", addr_str);
     grpc_fd* fdobj = grpc_fd_create(fd, name.c_str(), true);
 
-    read_notifier_pollset = (*(sp->server->pollsets))
-        [static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
-             &sp->server->next_pollset_to_assign, 1)) %
-         sp->server->pollsets->size()];
+    read_notifier_pollset = pick_read_notifier_pollset(sp->server, fd);
 
     grpc_pollset_add_fd(read_notifier_pollset, fdobj);
 
@@ -508,6 +591,17 @@ static void tcp_server_start(grpc_tcp_server* s,
           "clone_port", clone_port(sp, (unsigned)(pollsets->size() - 1))));
       for (i = 0; i < pollsets->size(); i++) {
         grpc_pollset_add_fd((*pollsets)[i], sp->emfd);
+        if (s->cpu_affinity) {
+          // Steer connections received on CPU i to the listener polled by
+          // pollset i. Best effort: without it the SO_REUSEPORT hash decides.
+          grpc_error* err =
+              grpc_set_socket_incoming_cpu(sp->fd, static_cast<int>(i));
+          if (err != GRPC_ERROR_NONE) {
+            gpr_log(GPR_DEBUG, "Failed to set listener CPU affinity: %s",
+                    grpc_error_string(err));
+            GRPC_ERROR_UNREF(err);
+          }
+        }
         GRPC_CLOSURE_INIT(&sp->read_closure, on_read, sp,
                           grpc_schedule_on_exec_ctx);
         grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
@@ -585,6 +679,7 @@ class ExternalConnectionHandler : public grpc_core::TcpServerFdHandler {
       return;
     }
     grpc_set_socket_no_sigpipe_if_possible(fd);
+    set_busy_poll(s_, fd);
     std::string addr_str = grpc_sockaddr_to_uri(&addr);
     if (grpc_tcp_trace.enabled()) {
       gpr_log(GPR_INFO, "SERVER_CONNECT: incoming external connection: %s",
@@ -592,10 +687,7 @@ class ExternalConnectionHandler : public grpc_core::TcpServerFdHandler {
     }
     std::string name = absl::StrCat("tcp-server-connection:", addr_str);
     grpc_fd* fdobj = grpc_fd_create(fd, name.c_str(), true);
-    read_notifier_pollset =
-        (*(s_->pollsets))[static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
-                              &s_->next_pollset_to_assign, 1)) %
-                          s_->pollsets->size()];
+    read_notifier_pollset = pick_read_notifier_pollset(s_, fd);
     grpc_pollset_add_fd(read_notifier_pollset, fdobj);
     grpc_tcp_server_acceptor* acceptor =
         static_cast<grpc_tcp_server_acceptor*>(gpr_malloc(sizeof(*acceptor)));
@@ -70,6 +70,12 @@ struct grpc_tcp_server {
   bool so_reuseport;
   /* expand wildcard addresses to a list of all local addresses */
   bool expand_wildcard_addrs;
+  /* assign connections to pollsets by the CPU that received them */
+  bool cpu_affinity;
+  /* SO_BUSY_POLL value for accepted connections; unset if not positive */
+  int busy_poll_us;
+  /* also set SO_PREFER_BUSY_POLL on accepted connections */
+  bool prefer_busy_poll;
 
   /* linked list of server ports */
   grpc_tcp_listener* head;
@@ -19,14 +19,40 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/lib/iomgr/timer.h"
+
+#include <string.h>
+
+#include <grpc/support/log.h>
+
 #include "src/core/lib/iomgr/timer_manager.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_STRING(
+    grpc_timer_strategy, "heap",
+    "Declares which timer implementation to use: 'heap' (sharded binary "
+    "heaps) or 'wheel' (per-CPU hierarchical timing wheels).")
+
+extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_timer_wheel_vtable;
+
 grpc_timer_vtable* grpc_timer_impl;
 
 void grpc_set_timer_impl(grpc_timer_vtable* vtable) {
   grpc_timer_impl = vtable;
 }
 
+grpc_timer_vtable* grpc_generic_timer_impl(void) {
+  grpc_core::UniquePtr<char> value = GPR_GLOBAL_CONFIG_GET(grpc_timer_strategy);
+  if (strcmp(value.get(), "wheel") == 0) {
+    gpr_log(GPR_DEBUG, "Using timer implementation: wheel");
+    return &grpc_timer_wheel_vtable;
+  }
+  if (strcmp(value.get(), "heap") != 0) {
+    gpr_log(GPR_ERROR, "Unknown timer strategy '%s', using 'heap'",
+            value.get());
+  }
+  return &grpc_generic_timer_vtable;
+}
+
 void grpc_timer_init(grpc_timer* timer, grpc_millis deadline,
                      grpc_closure* closure) {
   grpc_timer_impl->init(timer, deadline, closure);
@@ -24,9 +24,12 @@
 #include "src/core/lib/iomgr/port.h"
 
 #include <grpc/support/time.h>
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_STRING(grpc_timer_strategy);
+
 typedef struct grpc_timer {
   grpc_millis deadline;
   // Uninitialized if not using heap, or INVALID_HEAP_INDEX if not in heap.
@@ -39,7 +42,8 @@ typedef struct grpc_timer {
   struct grpc_timer* hash_table_next;
 #endif
 
-  // Optional field used by custom timers
+  // Optional field used by custom timers, and by the timing wheel to point
+  // at the slot holding the timer
   void* custom_timer;
 } grpc_timer;
 
@@ -124,4 +128,8 @@ void grpc_kick_poller(void);
 /* Sets the timer implementation */
 void grpc_set_timer_impl(grpc_timer_vtable* vtable);
 
+/* Returns the generic timer implementation selected by GRPC_TIMER_STRATEGY:
+   sharded heaps ("heap", the default) or per-CPU timing wheels ("wheel") */
+grpc_timer_vtable* grpc_generic_timer_impl(void);
+
 #endif /* GRPC_CORE_LIB_IOMGR_TIMER_H */
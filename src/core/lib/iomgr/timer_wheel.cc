@@ -0,0 +1,493 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <atomic>
+#include <new>
+
+#include "src/core/lib/iomgr/timer.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+/* A hierarchical hashed timing wheel (Varghese & Lauck, scheme 7), as an
+ * alternative to the heap-based timer_generic.cc.
+ *
+ * Each wheel has five levels. Level 0 has 256 one-millisecond slots; each
+ * higher level has 64 slots, each 64 times wider than a slot of the level
+ * below, so the wheel spans 2^32 ms (~49 days) and later deadlines are parked
+ * in the last level until they come within range. A timer is linked into the
+ * slot covering its deadline, which makes insertion and cancellation O(1).
+ * As time advances, every time level 0 wraps around the next slot of level 1
+ * is redistributed ("cascaded") into level 0, and so on up the levels.
+ *
+ * There is one wheel per CPU. A timer goes to the wheel of the CPU that
+ * initializes it, and its wheel index is kept in heap_index so that cancel
+ * finds it again. Within a wheel, slots are null-terminated doubly linked
+ * lists threaded through timer->next/prev, and timer->custom_timer points at
+ * the head of the slot holding the timer so that cancellation can unlink it
+ * without searching. */
+
+#define LEVEL0_BITS 8
+#define LEVEL_BITS 6
+#define NUM_LEVELS 5
+#define LEVEL0_SIZE (1 << LEVEL0_BITS)
+#define LEVEL_SIZE (1 << LEVEL_BITS)
+#define NUM_SLOTS (LEVEL0_SIZE + (NUM_LEVELS - 1) * LEVEL_SIZE)
+/* Timers further than this into the future are parked in the last level */
+#define MAX_WHEEL_SPAN \
+  ((static_cast<grpc_millis>(1) << (LEVEL0_BITS + 4 * LEVEL_BITS)) - 1)
+
+#define MAX_SHARDS 32
+
+extern grpc_core::TraceFlag grpc_timer_trace;
+extern grpc_core::TraceFlag grpc_timer_check_trace;
+
+namespace {
+
+struct wheel_shard {
+  gpr_mu mu;
+  /* The next tick to run: every timer with a deadline before it has fired. */
+  grpc_millis now;
+  /* Number of pending timers in this wheel. */
+  size_t count;
+  /* A lower bound on the deadline of the next timer due in this wheel.
+     Written under mu, read without it by the checker. */
+  std::atomic<grpc_millis> min_deadline;
+  /* One bit per non-empty slot: four words for level 0, then one word for
+     each higher level. */
+  uint64_t occupied[LEVEL0_SIZE / 64 + NUM_LEVELS - 1];
+  grpc_timer* slots[NUM_SLOTS];
+};
+
+struct alignas(GPR_CACHELINE_SIZE) padded_wheel_shard : public wheel_shard {};
+
+struct shared_mutables {
+  /* The deadline of the next timer due across all wheels (a lower bound) */
+  std::atomic<grpc_millis> min_timer;
+  /* Allow only one run_some_expired_timers at once */
+  gpr_spinlock checker_mu;
+  bool initialized;
+  /* Serializes updates of min_timer */
+  gpr_mu mu;
+} GPR_ALIGN_STRUCT(GPR_CACHELINE_SIZE);
+
+size_t g_num_shards;
+padded_wheel_shard* g_shards;
+shared_mutables g_shared_mutables;
+
+int lowest_bit(uint64_t bits) {
+#if defined(__GNUC__)
+  return __builtin_ctzll(bits);
+#else
+  int n = 0;
+  while ((bits & 1) == 0) {
+    bits >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+int level_shift(int level) { return LEVEL0_BITS + (level - 1) * LEVEL_BITS; }
+
+void set_occupied(wheel_shard* shard, int slot) {
+  shard->occupied[slot / 64] |= static_cast<uint64_t>(1) << (slot % 64);
+}
+
+void clear_occupied(wheel_shard* shard, int slot) {
+  shard->occupied[slot / 64] &= ~(static_cast<uint64_t>(1) << (slot % 64));
+}
+
+/* Returns the first non-empty level 0 slot at or after \a from, or
+   LEVEL0_SIZE if there is none. */
+int next_level0_slot(const wheel_shard* shard, int from) {
+  for (int word = from / 64; word < LEVEL0_SIZE / 64; ++word) {
+    uint64_t bits = shard->occupied[word];
+    if (word == from / 64) bits &= ~static_cast<uint64_t>(0) << (from % 64);
+    if (bits != 0) return word * 64 + lowest_bit(bits);
+  }
+  return LEVEL0_SIZE;
+}
+
+/* REQUIRES: shard->mu locked */
+void add_locked(wheel_shard* shard, grpc_timer* timer) {
+  grpc_millis expires = GPR_MAX(timer->deadline, shard->now);
+  grpc_millis delta = expires - shard->now;
+  if (delta > MAX_WHEEL_SPAN) {
+    delta = MAX_WHEEL_SPAN;
+    expires = shard->now + MAX_WHEEL_SPAN;
+  }
+  int slot;
+  if (delta < LEVEL0_SIZE) {
+    slot = static_cast<int>(expires & (LEVEL0_SIZE - 1));
+  } else {
+    int level = 1;
+    while (delta >> (level_shift(level) + LEVEL_BITS) != 0) ++level;
+    slot = LEVEL0_SIZE + (level - 1) * LEVEL_SIZE +
+           static_cast<int>((expires >> level_shift(level)) & (LEVEL_SIZE - 1));
+  }
+  grpc_timer** head = &shard->slots[slot];
+  timer->prev = nullptr;
+  timer->next = *head;
+  if (*head != nullptr) (*head)->prev = timer;
+  *head = timer;
+  timer->custom_timer = head;
+  set_occupied(shard, slot);
+}
+
+/* REQUIRES: shard->mu locked */
+void remove_locked(wheel_shard* shard, grpc_timer* timer) {
+  grpc_timer** head = static_cast<grpc_timer**>(timer->custom_timer);
+  if (timer->prev != nullptr) {
+    timer->prev->next = timer->next;
+  } else {
+    *head = timer->next;
+    if (*head == nullptr) {
+      clear_occupied(shard, static_cast<int>(head - shard->slots));
+    }
+  }
+  if (timer->next != nullptr) timer->next->prev = timer->prev;
+}
+
+/* Unlinks every timer in \a slot and returns them as a list.
+   REQUIRES: shard->mu locked */
+grpc_timer* take_slot_locked(wheel_shard* shard, int slot) {
+  grpc_timer* list = shard->slots[slot];
+  shard->slots[slot] = nullptr;
+  clear_occupied(shard, slot);
+  return list;
+}
+
+/* REQUIRES: shard->mu locked */
+size_t fire_list_locked(wheel_shard* shard, grpc_timer* list,
+                        grpc_error* error) {
+  size_t n = 0;
+  while (list != nullptr) {
+    grpc_timer* timer = list;
+    list = timer->next;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+      gpr_log(GPR_INFO, "TIMER %p: FIRE %" PRId64 "ms late", timer,
+              shard->now - timer->deadline);
+    }
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_REF(error));
+    n++;
+  }
+  shard->count -= n;
+  return n;
+}
+
+/* Redistributes the level slots that come due at tick shard->now, which must
+   be the start of a level 0 revolution.
+   REQUIRES: shard->mu locked */
+void cascade_locked(wheel_shard* shard) {
+  for (int level = 1; level < NUM_LEVELS; ++level) {
+    int index = static_cast<int>((shard->now >> level_shift(level)) &
+                                 (LEVEL_SIZE - 1));
+    grpc_timer* list =
+        take_slot_locked(shard, LEVEL0_SIZE + (level - 1) * LEVEL_SIZE + index);
+    while (list != nullptr) {
+      grpc_timer* timer = list;
+      list = timer->next;
+      add_locked(shard, timer);
+    }
+    if (index != 0) break;
+  }
+}
+
+/* Returns a lower bound on the next deadline in \a shard: exact for timers in
+   level 0, and the time their slot will be cascaded for the others.
+   REQUIRES: shard->mu locked */
+grpc_millis compute_min_deadline(const wheel_shard* shard) {
+  if (shard->count == 0) return GRPC_MILLIS_INF_FUTURE;
+  grpc_millis result = GRPC_MILLIS_INF_FUTURE;
+  int index = static_cast<int>(shard->now & (LEVEL0_SIZE - 1));
+  grpc_millis base = shard->now - index;
+  int slot = next_level0_slot(shard, index);
+  if (slot < LEVEL0_SIZE) {
+    result = base + slot;
+  } else {
+    /* Slots behind the cursor hold timers of the next revolution. */
+    slot = next_level0_slot(shard, 0);
+    if (slot < index) result = base + LEVEL0_SIZE + slot;
+  }
+  for (int level = 1; level < NUM_LEVELS; ++level) {
+    uint64_t bits = shard->occupied[LEVEL0_SIZE / 64 + level - 1];
+    if (bits == 0) continue;
+    int shift = level_shift(level);
+    /* The first revolution boundary of this level not yet processed... */
+    grpc_millis q = (shard->now + (static_cast<grpc_millis>(1) << shift) - 1) >>
+                    shift;
+    int start = static_cast<int>(q & (LEVEL_SIZE - 1));
+    /* ...and the first non-empty slot from there on, wrapping around. */
+    uint64_t rotated =
+        (bits >> start) | (start == 0 ? 0 : bits << (64 - start));
+    grpc_millis cascade_at = (q + lowest_bit(rotated)) << shift;
+    result = GPR_MIN(result, cascade_at);
+  }
+  return result;
+}
+
+/* Runs every timer due at or before \a now.
+   REQUIRES: shard->mu locked */
+size_t advance_locked(wheel_shard* shard, grpc_millis now, grpc_error* error) {
+  size_t n = 0;
+  if (now == GRPC_MILLIS_INF_FUTURE) {
+    /* Shutting down: flush everything. */
+    for (int slot = 0; slot < NUM_SLOTS; ++slot) {
+      n += fire_list_locked(shard, take_slot_locked(shard, slot), error);
+    }
+    return n;
+  }
+  while (shard->now <= now) {
+    int index = static_cast<int>(shard->now & (LEVEL0_SIZE - 1));
+    if (index == 0) cascade_locked(shard);
+    if (shard->slots[index] != nullptr) {
+      n += fire_list_locked(shard, take_slot_locked(shard, index), error);
+      shard->now++;
+      continue;
+    }
+    /* Nothing due at this tick: skip straight to the next tick that has
+       timers to fire or to cascade. */
+    shard->now = GPR_MIN(compute_min_deadline(shard), now + 1);
+  }
+  return n;
+}
+
+void timer_list_init() {
+  g_num_shards = GPR_CLAMP(gpr_cpu_num_cores(), 1, MAX_SHARDS);
+  g_shards = static_cast<padded_wheel_shard*>(
+      gpr_malloc_aligned(g_num_shards * sizeof(*g_shards), GPR_CACHELINE_SIZE));
+
+  g_shared_mutables.initialized = true;
+  g_shared_mutables.checker_mu = GPR_SPINLOCK_INITIALIZER;
+  gpr_mu_init(&g_shared_mutables.mu);
+  g_shared_mutables.min_timer.store(GRPC_MILLIS_INF_FUTURE,
+                                    std::memory_order_relaxed);
+
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  for (size_t i = 0; i < g_num_shards; i++) {
+    wheel_shard* shard = new (&g_shards[i]) padded_wheel_shard();
+    gpr_mu_init(&shard->mu);
+    shard->now = now;
+    shard->count = 0;
+    shard->min_deadline.store(GRPC_MILLIS_INF_FUTURE,
+                              std::memory_order_relaxed);
+    memset(shard->occupied, 0, sizeof(shard->occupied));
+    memset(shard->slots, 0, sizeof(shard->slots));
+  }
+}
+
+grpc_timer_check_result run_some_expired_timers(grpc_millis now,
+                                                grpc_millis* next,
+                                                grpc_error* error);
+
+void timer_list_shutdown() {
+  run_some_expired_timers(
+      GRPC_MILLIS_INF_FUTURE, nullptr,
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Timer list shutdown"));
+  for (size_t i = 0; i < g_num_shards; i++) {
+    gpr_mu_destroy(&g_shards[i].mu);
+    g_shards[i].~padded_wheel_shard();
+  }
+  gpr_mu_destroy(&g_shared_mutables.mu);
+  gpr_free_aligned(g_shards);
+  g_shared_mutables.initialized = false;
+}
+
+void timer_init(grpc_timer* timer, grpc_millis deadline,
+                grpc_closure* closure) {
+  uint32_t shard_index =
+      static_cast<uint32_t>(gpr_cpu_current_cpu()) % MAX_SHARDS;
+  timer->closure = closure;
+  timer->deadline = deadline;
+  timer->heap_index = shard_index;
+
+#ifndef NDEBUG
+  timer->hash_table_next = nullptr;
+#endif
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: SET %" PRId64 " now %" PRId64 " call %p[%p]",
+            timer, deadline, grpc_core::ExecCtx::Get()->Now(), closure,
+            closure->cb);
+  }
+
+  if (!g_shared_mutables.initialized) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION, timer->closure,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Attempt to create timer before initialization"));
+    return;
+  }
+
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  if (deadline <= now) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure, GRPC_ERROR_NONE);
+    /* early out */
+    return;
+  }
+
+  wheel_shard* shard = &g_shards[shard_index % g_num_shards];
+  gpr_mu_lock(&shard->mu);
+  timer->pending = true;
+  if (shard->count == 0) {
+    /* An empty wheel is not advanced by the checker, so it may lag behind. */
+    shard->now = GPR_MAX(shard->now, now);
+  }
+  add_locked(shard, timer);
+  shard->count++;
+  /* The checker only needs a lower bound on the deadlines in the wheel, so
+     there is no need to work out which slot comes due first. */
+  bool is_first_timer =
+      deadline < shard->min_deadline.load(std::memory_order_relaxed);
+  if (is_first_timer) {
+    shard->min_deadline.store(deadline, std::memory_order_relaxed);
+  }
+  gpr_mu_unlock(&shard->mu);
+
+  /* As in timer_generic.cc: a checker that ran between the unlock above and
+     the lock below has either seen the new min_deadline of the shard, or will
+     be corrected here. */
+  if (is_first_timer) {
+    gpr_mu_lock(&g_shared_mutables.mu);
+    if (deadline <
+        g_shared_mutables.min_timer.load(std::memory_order_relaxed)) {
+      g_shared_mutables.min_timer.store(deadline, std::memory_order_relaxed);
+      grpc_kick_poller();
+    }
+    gpr_mu_unlock(&g_shared_mutables.mu);
+  }
+}
+
+void timer_consume_kick(void) {}
+
+void timer_cancel(grpc_timer* timer) {
+  if (!g_shared_mutables.initialized) {
+    /* must have already been cancelled, also the shard mutex is invalid */
+    return;
+  }
+
+  /* heap_index is only meaningful once the timer has been initialized; a timer
+     that was only grpc_timer_init_unset() is not pending in any wheel. */
+  wheel_shard* shard = &g_shards[timer->heap_index % g_num_shards];
+  gpr_mu_lock(&shard->mu);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: CANCEL pending=%s", timer,
+            timer->pending ? "true" : "false");
+  }
+
+  if (timer->pending) {
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_CANCELLED);
+    timer->pending = false;
+    remove_locked(shard, timer);
+    shard->count--;
+  }
+  gpr_mu_unlock(&shard->mu);
+}
+
+grpc_timer_check_result run_some_expired_timers(grpc_millis now,
+                                                grpc_millis* next,
+                                                grpc_error* error) {
+  grpc_timer_check_result result = GRPC_TIMERS_NOT_CHECKED;
+
+  grpc_millis min_timer =
+      g_shared_mutables.min_timer.load(std::memory_order_relaxed);
+  if (now < min_timer) {
+    if (next != nullptr) *next = GPR_MIN(*next, min_timer);
+    GRPC_ERROR_UNREF(error);
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  if (gpr_spinlock_trylock(&g_shared_mutables.checker_mu)) {
+    result = GRPC_TIMERS_CHECKED_AND_EMPTY;
+    for (size_t i = 0; i < g_num_shards; i++) {
+      wheel_shard* shard = &g_shards[i];
+      if (shard->min_deadline.load(std::memory_order_relaxed) > now) continue;
+      gpr_mu_lock(&shard->mu);
+      size_t n = advance_locked(shard, now, error);
+      shard->min_deadline.store(compute_min_deadline(shard),
+                                std::memory_order_relaxed);
+      gpr_mu_unlock(&shard->mu);
+      if (n > 0) result = GRPC_TIMERS_FIRED;
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+        gpr_log(GPR_INFO, "  .. wheel[%d] popped %" PRIdPTR,
+                static_cast<int>(i), n);
+      }
+    }
+
+    /* A grpc_timer_init() lowering a shard's min_deadline after we read it
+       below will also lower min_timer once it gets g_shared_mutables.mu. */
+    gpr_mu_lock(&g_shared_mutables.mu);
+    grpc_millis new_min = GRPC_MILLIS_INF_FUTURE;
+    for (size_t i = 0; i < g_num_shards; i++) {
+      new_min = GPR_MIN(
+          new_min, g_shards[i].min_deadline.load(std::memory_order_relaxed));
+    }
+    g_shared_mutables.min_timer.store(new_min, std::memory_order_relaxed);
+    gpr_mu_unlock(&g_shared_mutables.mu);
+    if (next != nullptr) *next = GPR_MIN(*next, new_min);
+    gpr_spinlock_unlock(&g_shared_mutables.checker_mu);
+  }
+
+  GRPC_ERROR_UNREF(error);
+
+  return result;
+}
+
+grpc_timer_check_result timer_check(grpc_millis* next) {
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  grpc_error* shutdown_error =
+      now != GRPC_MILLIS_INF_FUTURE
+          ? GRPC_ERROR_NONE
+          : GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shutting down timer system");
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO, "TIMER CHECK BEGIN: now=%" PRId64 " min=%" PRId64, now,
+            g_shared_mutables.min_timer.load(std::memory_order_relaxed));
+  }
+  grpc_timer_check_result r =
+      run_some_expired_timers(now, next, shutdown_error);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO, "TIMER CHECK END: r=%d", r);
+  }
+  return r;
+}
+
+}  // namespace
+
+grpc_timer_vtable grpc_timer_wheel_vtable = {
+    timer_init,      timer_cancel,        timer_check,
+    timer_list_init, timer_list_shutdown, timer_consume_kick};
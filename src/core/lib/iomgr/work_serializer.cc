@@ -20,6 +20,8 @@
 
 #include "src/core/lib/iomgr/work_serializer.h"
 
+#include "src/core/lib/iomgr/serializer_profiler.h"
+
 namespace grpc_core {
 
 DebugOnlyTraceFlag grpc_work_serializer_trace(false, "work_serializer");
@@ -31,6 +33,9 @@ struct CallbackWrapper {
   MultiProducerSingleConsumerQueue::Node mpscq_node;
   const std::function<void()> callback;
   const DebugLocation location;
+#ifdef GRPC_SERIALIZER_PROFILING
+  gpr_cycle_counter enqueue_time;
+#endif
 };
 
 class WorkSerializer::WorkSerializerImpl : public Orphanable {
@@ -47,6 +52,9 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   // orphaned.
   Atomic<size_t> size_{1};
   MultiProducerSingleConsumerQueue queue_;
+#ifdef GRPC_SERIALIZER_PROFILING
+  SerializerProfile profile_{SerializerProfile::Kind::kWorkSerializer};
+#endif
 };
 
 void WorkSerializer::WorkSerializerImpl::Run(
@@ -64,12 +72,22 @@ void WorkSerializer::WorkSerializerImpl::Run(
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
       gpr_log(GPR_INFO, "  Executing immediately");
     }
+#ifdef GRPC_SERIALIZER_PROFILING
+    gpr_cycle_counter start_time = profile_.ItemQueued(1);
+#endif
     callback();
+#ifdef GRPC_SERIALIZER_PROFILING
+    profile_.ItemRan(location.file(), location.line(), start_time, start_time);
+#endif
     // Loan this thread to the work serializer thread and drain the queue.
     DrainQueue();
   } else {
     CallbackWrapper* cb_wrapper =
         new CallbackWrapper(std::move(callback), location);
+#ifdef GRPC_SERIALIZER_PROFILING
+    // prev_size counts the orphaning ref, but not this callback
+    cb_wrapper->enqueue_time = profile_.ItemQueued(prev_size);
+#endif
     // There already are closures executing on this work serializer. Simply add
     // this closure to the queue.
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
@@ -135,7 +153,14 @@ void WorkSerializer::WorkSerializerImpl::DrainQueue() {
               cb_wrapper, cb_wrapper->location.file(),
               cb_wrapper->location.line());
     }
+#ifdef GRPC_SERIALIZER_PROFILING
+    gpr_cycle_counter start_time = gpr_get_cycle_counter();
+#endif
     cb_wrapper->callback();
+#ifdef GRPC_SERIALIZER_PROFILING
+    profile_.ItemRan(cb_wrapper->location.file(), cb_wrapper->location.line(),
+                     cb_wrapper->enqueue_time, start_time);
+#endif
     delete cb_wrapper;
   }
 }
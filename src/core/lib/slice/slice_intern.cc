@@ -24,7 +24,10 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include <thread>
+
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gpr/murmur_hash.h"
@@ -37,21 +40,96 @@
 #define LOG2_SHARD_COUNT 5
 #define SHARD_COUNT (1 << LOG2_SHARD_COUNT)
 #define INITIAL_SHARD_CAPACITY 8
+/* Number of per-CPU counters that lookups register in; see
+   intern_read_lock(). */
+#define READER_STRIPE_COUNT 16
+/* Number of unlinked strings a shard holds before waiting for lookups to
+   drain and freeing them. */
+#define RETIRE_BATCH 32
 
 #define TABLE_IDX(hash, capacity) (((hash) >> LOG2_SHARD_COUNT) % (capacity))
 #define SHARD_IDX(hash) ((hash) & ((1 << LOG2_SHARD_COUNT) - 1))
 
 using grpc_core::InternedSliceRefcount;
 
+typedef std::atomic<InternedSliceRefcount*> slice_bucket;
+
+/* Lookups walk a shard without taking mu: chains are only modified under mu,
+   with release stores, and strings and tables are only freed after
+   intern_synchronize(). Growing the table relinks every chain, which a lookup
+   in flight may follow into another chain: it then misses its string, and
+   falls back to mu. */
 typedef struct slice_shard {
   gpr_mu mu;
-  InternedSliceRefcount** strs;
+  /* Published before capacity, so that a lookup seeing the new capacity also
+     sees the new table. */
+  std::atomic<slice_bucket*> strs;
+  std::atomic<size_t> capacity;
   size_t count;
-  size_t capacity;
+  /* Strings unlinked from strs that a lookup may still be reading. */
+  InternedSliceRefcount* retired[RETIRE_BATCH];
+  size_t retired_count;
 } slice_shard;
 
 static slice_shard g_shards[SHARD_COUNT];
 
+/* Lookups in flight, counted per CPU and per epoch parity. */
+struct alignas(GPR_CACHELINE_SIZE) reader_stripe {
+  std::atomic<intptr_t> active[2];
+};
+static reader_stripe g_reader_stripes[READER_STRIPE_COUNT];
+static std::atomic<uintptr_t> g_reader_epoch;
+static gpr_mu g_synchronize_mu;
+
+/* Registers a lookup of the intern table. Returns the counter to pass to
+   intern_read_unlock(). */
+static std::atomic<intptr_t>* intern_read_lock() {
+  reader_stripe* stripe =
+      &g_reader_stripes[gpr_cpu_current_cpu() % READER_STRIPE_COUNT];
+  for (;;) {
+    const uintptr_t epoch = g_reader_epoch.load();
+    std::atomic<intptr_t>* active = &stripe->active[epoch & 1];
+    active->fetch_add(1);
+    /* If the epoch moved on, intern_synchronize() may have already checked
+       this counter: register again under the new epoch. */
+    if (g_reader_epoch.load() == epoch) return active;
+    active->fetch_sub(1);
+  }
+}
+
+static void intern_read_unlock(std::atomic<intptr_t>* active) {
+  active->fetch_sub(1, std::memory_order_release);
+}
+
+/* Returns once every lookup that started before the call has finished. Any
+   string unlinked before the call can then be freed. */
+static void intern_synchronize() {
+  GPR_TIMER_SCOPE("intern_synchronize", 0);
+  grpc_core::MutexLock lock(&g_synchronize_mu);
+  const uintptr_t epoch = g_reader_epoch.fetch_add(1);
+  for (size_t i = 0; i < READER_STRIPE_COUNT; i++) {
+    while (g_reader_stripes[i].active[epoch & 1].load() != 0) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+/* Frees unlinked strings. Requires intern_synchronize() to have been called
+   after they were unlinked, or no concurrent lookups. */
+static void free_strings(InternedSliceRefcount** strs, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    InternedSliceRefcount* s = strs[i];
+    s->~InternedSliceRefcount();
+    gpr_free(s);
+  }
+}
+
+/* Frees the retired strings of a shard; see free_strings(). */
+static void free_retired(slice_shard* shard) {
+  free_strings(shard->retired, shard->retired_count);
+  shard->retired_count = 0;
+}
+
 struct static_metadata_hash_ent {
   uint32_t hash;
   uint32_t idx;
@@ -67,43 +145,69 @@ namespace grpc_core {
 uint32_t g_hash_seed;
 static bool g_forced_hash_seed = false;
 
-InternedSliceRefcount::~InternedSliceRefcount() {
-  slice_shard* shard = &g_shards[SHARD_IDX(this->hash)];
-  MutexLock lock(&shard->mu);
-  InternedSliceRefcount** prev_next;
-  InternedSliceRefcount* cur;
-  for (prev_next = &shard->strs[TABLE_IDX(this->hash, shard->capacity)],
-      cur = *prev_next;
-       cur != this; prev_next = &cur->bucket_next, cur = cur->bucket_next) {
+void InternedSliceRefcount::Destroy(void* arg) {
+  auto* rc = static_cast<InternedSliceRefcount*>(arg);
+  slice_shard* shard = &g_shards[SHARD_IDX(rc->hash)];
+  InternedSliceRefcount* batch[RETIRE_BATCH];
+  size_t batch_count = 0;
+  {
+    MutexLock lock(&shard->mu);
+    slice_bucket* prev_next =
+        &shard->strs.load(std::memory_order_relaxed)[TABLE_IDX(
+            rc->hash, shard->capacity.load(std::memory_order_relaxed))];
+    InternedSliceRefcount* cur;
+    while ((cur = prev_next->load(std::memory_order_relaxed)) != rc) {
+      prev_next = &cur->bucket_next;
+    }
+    prev_next->store(rc->bucket_next.load(std::memory_order_relaxed),
+                     std::memory_order_release);
+    shard->count--;
+    shard->retired[shard->retired_count++] = rc;
+    if (shard->retired_count == RETIRE_BATCH) {
+      /* Take the batch out of the shard: waiting for lookups under mu would
+         stall every intern and unref in the shard behind it. */
+      memcpy(batch, shard->retired, sizeof(batch));
+      batch_count = RETIRE_BATCH;
+      shard->retired_count = 0;
+    }
+  }
+  if (batch_count > 0) {
+    intern_synchronize();
+    free_strings(batch, batch_count);
   }
-  *prev_next = cur->bucket_next;
-  shard->count--;
 }
 
 }  // namespace grpc_core
 
-static void grow_shard(slice_shard* shard) {
+/* Relinks the strings of a shard into a table twice as large. Returns the old
+   table, which lookups may still be reading: the caller frees it after
+   releasing mu and calling intern_synchronize(). */
+static slice_bucket* grow_shard(slice_shard* shard) {
   GPR_TIMER_SCOPE("grow_strtab", 0);
 
-  size_t capacity = shard->capacity * 2;
+  const size_t old_capacity = shard->capacity.load(std::memory_order_relaxed);
+  slice_bucket* old_strtab = shard->strs.load(std::memory_order_relaxed);
+  size_t capacity = old_capacity * 2;
   size_t i;
-  InternedSliceRefcount** strtab;
+  slice_bucket* strtab;
   InternedSliceRefcount *s, *next;
 
-  strtab = static_cast<InternedSliceRefcount**>(
-      gpr_zalloc(sizeof(InternedSliceRefcount*) * capacity));
+  strtab = static_cast<slice_bucket*>(
+      gpr_zalloc(sizeof(slice_bucket) * capacity));
 
-  for (i = 0; i < shard->capacity; i++) {
-    for (s = shard->strs[i]; s; s = next) {
+  for (i = 0; i < old_capacity; i++) {
+    for (s = old_strtab[i].load(std::memory_order_relaxed); s; s = next) {
       size_t idx = TABLE_IDX(s->hash, capacity);
-      next = s->bucket_next;
-      s->bucket_next = strtab[idx];
-      strtab[idx] = s;
+      next = s->bucket_next.load(std::memory_order_relaxed);
+      /* Release, as lookups in flight may follow the new links. */
+      s->bucket_next.store(strtab[idx].load(std::memory_order_relaxed),
+                           std::memory_order_release);
+      strtab[idx].store(s, std::memory_order_relaxed);
     }
   }
-  gpr_free(shard->strs);
-  shard->strs = strtab;
-  shard->capacity = capacity;
+  shard->strs.store(strtab, std::memory_order_release);
+  shard->capacity.store(capacity, std::memory_order_release);
+  return old_strtab;
 }
 
 grpc_core::InternedSlice::InternedSlice(InternedSliceRefcount* s) {
@@ -197,47 +301,58 @@ static size_t GetLength(const grpc_slice& slice) {
 // Creates an interned slice for a string that does not currently exist in the
 // intern table. SliceArgs is either a const grpc_slice& or a const
 // pair<const char*, size_t>&. Hash is the pre-computed hash value. We must
-// already hold the shard lock. Helper for FindOrCreateInternedSlice().
+// already hold the shard lock. If the shard grew, sets \a old_strtab to the
+// table to free once the lock is released. Helper for
+// FindOrCreateInternedSlice().
 //
 // Returns: a newly interned slice.
 template <typename SliceArgs>
 static InternedSliceRefcount* InternNewStringLocked(slice_shard* shard,
                                                     size_t shard_idx,
                                                     uint32_t hash,
-                                                    const SliceArgs& args) {
+                                                    const SliceArgs& args,
+                                                    slice_bucket** old_strtab) {
   /* string data goes after the internal_string header */
   size_t len = GetLength(args);
   const void* buffer = GetBuffer(args);
+  slice_bucket* bucket =
+      &shard->strs.load(std::memory_order_relaxed)[shard_idx];
   InternedSliceRefcount* s =
       static_cast<InternedSliceRefcount*>(gpr_malloc(sizeof(*s) + len));
-  new (s) grpc_core::InternedSliceRefcount(len, hash, shard->strs[shard_idx]);
+  new (s) grpc_core::InternedSliceRefcount(
+      len, hash, bucket->load(std::memory_order_relaxed));
   // TODO(arjunroy): Investigate why hpack tried to intern the nullptr string.
   // https://github.com/grpc/grpc/pull/20110#issuecomment-526729282
   if (len > 0) {
     memcpy(reinterpret_cast<char*>(s + 1), buffer, len);
   }
-  shard->strs[shard_idx] = s;
+  // Publishes the string to lookups that do not hold the lock.
+  bucket->store(s, std::memory_order_release);
   shard->count++;
-  if (shard->count > shard->capacity * 2) {
-    grow_shard(shard);
+  if (shard->count > shard->capacity.load(std::memory_order_relaxed) * 2) {
+    *old_strtab = grow_shard(shard);
   }
   return s;
 }
 
 // Attempt to see if the provided slice or string matches an existing interned
 // slice. SliceArgs... is either a const grpc_slice& or a string and length. In
-// either case, hash is the pre-computed hash value.  We must already hold the
-// shard lock. Helper for FindOrCreateInternedSlice().
+// either case, hash is the pre-computed hash value. Safe to call without the
+// shard lock, but may then miss a string while the shard is being resized.
+// Helper for FindOrCreateInternedSlice().
 //
-// Returns: a pre-existing matching static slice, or null.
+// Returns: a pre-existing matching interned slice, or null.
 template <typename SliceArgs>
-static InternedSliceRefcount* MatchInternedSliceLocked(uint32_t hash,
-                                                       size_t idx,
-                                                       const SliceArgs& args) {
+static InternedSliceRefcount* MatchInternedSlice(slice_shard* shard,
+                                                 uint32_t hash,
+                                                 const SliceArgs& args) {
+  const size_t idx =
+      TABLE_IDX(hash, shard->capacity.load(std::memory_order_acquire));
   InternedSliceRefcount* s;
-  slice_shard* shard = &g_shards[SHARD_IDX(hash)];
   /* search for an existing string */
-  for (s = shard->strs[idx]; s; s = s->bucket_next) {
+  for (s = shard->strs.load(std::memory_order_acquire)[idx].load(
+           std::memory_order_acquire);
+       s; s = s->bucket_next.load(std::memory_order_acquire)) {
     if (s->hash == hash && grpc_core::InternedSlice(s) == args) {
       if (s->refcnt.RefIfNonZero()) {
         return s;
@@ -251,21 +366,33 @@ static InternedSliceRefcount* MatchInternedSliceLocked(uint32_t hash,
 // slice, and failing that, create an interned slice with its contents. Returns
 // either the existing matching interned slice or the newly created one.
 // SliceArgs is either a const grpc_slice& or const pair<const char*, size_t>&.
-// In either case, hash is the pre-computed hash value. We do not hold the
-// shard lock here, but do take it.
+// In either case, hash is the pre-computed hash value. Existing strings are
+// found without taking the shard lock; creating one takes it.
 //
 // Returns: an interned slice, either pre-existing/matched or newly created.
 template <typename SliceArgs>
 static InternedSliceRefcount* FindOrCreateInternedSlice(uint32_t hash,
                                                         const SliceArgs& args) {
   slice_shard* shard = &g_shards[SHARD_IDX(hash)];
+  InternedSliceRefcount* s = nullptr;
+  std::atomic<intptr_t>* reader = intern_read_lock();
+  s = MatchInternedSlice(shard, hash, args);
+  intern_read_unlock(reader);
+  if (s != nullptr) return s;
+  slice_bucket* old_strtab = nullptr;
   gpr_mu_lock(&shard->mu);
-  const size_t idx = TABLE_IDX(hash, shard->capacity);
-  InternedSliceRefcount* s = MatchInternedSliceLocked(hash, idx, args);
+  s = MatchInternedSlice(shard, hash, args);
   if (s == nullptr) {
-    s = InternNewStringLocked(shard, idx, hash, args);
+    s = InternNewStringLocked(
+        shard, TABLE_IDX(hash, shard->capacity.load(std::memory_order_relaxed)),
+        hash, args, &old_strtab);
   }
   gpr_mu_unlock(&shard->mu);
+  if (old_strtab != nullptr) {
+    /* Wait for lookups outside mu, not to stall the shard behind them. */
+    intern_synchronize();
+    gpr_free(old_strtab);
+  }
   return s;
 }
 
@@ -312,13 +439,16 @@ void grpc_slice_intern_init(void) {
     grpc_core::g_hash_seed =
         static_cast<uint32_t>(gpr_now(GPR_CLOCK_REALTIME).tv_nsec);
   }
+  gpr_mu_init(&g_synchronize_mu);
   for (size_t i = 0; i < SHARD_COUNT; i++) {
     slice_shard* shard = &g_shards[i];
     gpr_mu_init(&shard->mu);
     shard->count = 0;
-    shard->capacity = INITIAL_SHARD_CAPACITY;
-    shard->strs = static_cast<InternedSliceRefcount**>(
-        gpr_zalloc(sizeof(*shard->strs) * shard->capacity));
+    shard->retired_count = 0;
+    shard->capacity.store(INITIAL_SHARD_CAPACITY, std::memory_order_relaxed);
+    shard->strs.store(static_cast<slice_bucket*>(gpr_zalloc(
+                          sizeof(slice_bucket) * INITIAL_SHARD_CAPACITY)),
+                      std::memory_order_relaxed);
   }
   for (size_t i = 0; i < GPR_ARRAY_SIZE(static_metadata_hash); i++) {
     static_metadata_hash[i].hash = 0;
@@ -353,12 +483,16 @@ void grpc_slice_intern_shutdown(void) {
   for (size_t i = 0; i < SHARD_COUNT; i++) {
     slice_shard* shard = &g_shards[i];
     gpr_mu_destroy(&shard->mu);
+    free_retired(shard);
+    slice_bucket* strs = shard->strs.load(std::memory_order_relaxed);
     /* TODO(ctiller): GPR_ASSERT(shard->count == 0); */
     if (shard->count != 0) {
       gpr_log(GPR_DEBUG, "WARNING: %" PRIuPTR " metadata strings were leaked",
               shard->count);
-      for (size_t j = 0; j < shard->capacity; j++) {
-        for (InternedSliceRefcount* s = shard->strs[j]; s; s = s->bucket_next) {
+      for (size_t j = 0; j < shard->capacity.load(std::memory_order_relaxed);
+           j++) {
+        for (InternedSliceRefcount* s = strs[j].load(std::memory_order_relaxed);
+             s; s = s->bucket_next.load(std::memory_order_relaxed)) {
           char* text = grpc_dump_slice(grpc_core::InternedSlice(s),
                                        GPR_DUMP_HEX | GPR_DUMP_ASCII);
           gpr_log(GPR_DEBUG, "LEAKED: %s", text);
@@ -369,6 +503,7 @@ void grpc_slice_intern_shutdown(void) {
         abort();
       }
     }
-    gpr_free(shard->strs);
+    gpr_free(strs);
   }
+  gpr_mu_destroy(&g_synchronize_mu);
 }
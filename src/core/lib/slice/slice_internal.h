@@ -27,6 +27,8 @@
 #include <grpc/slice_buffer.h>
 #include <string.h>
 
+#include <atomic>
+
 #include "src/core/lib/gpr/murmur_hash.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -187,11 +189,9 @@ struct StaticSliceRefcount {
 extern grpc_slice_refcount kNoopRefcount;
 
 struct InternedSliceRefcount {
-  static void Destroy(void* arg) {
-    auto* rc = static_cast<InternedSliceRefcount*>(arg);
-    rc->~InternedSliceRefcount();
-    gpr_free(rc);
-  }
+  // Unlinks the string from the intern table. Its memory is released once no
+  // concurrent lookup can still be reading it.
+  static void Destroy(void* arg);
 
   InternedSliceRefcount(size_t length, uint32_t hash,
                         InternedSliceRefcount* bucket_next)
@@ -201,14 +201,13 @@ struct InternedSliceRefcount {
         hash(hash),
         bucket_next(bucket_next) {}
 
-  ~InternedSliceRefcount();
-
   grpc_slice_refcount base;
   grpc_slice_refcount sub;
   const size_t length;
   RefCount refcnt;
   const uint32_t hash;
-  InternedSliceRefcount* bucket_next;
+  // Read without the shard lock by lookups in slice_intern.cc.
+  std::atomic<InternedSliceRefcount*> bucket_next;
 };
 
 }  // namespace grpc_core
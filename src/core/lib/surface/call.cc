@@ -741,6 +741,12 @@ static void cancel_with_status(grpc_call* c, grpc_status_code status,
   cancel_with_error(c, error_from_status(status, description));
 }
 
+void grpc_call_cancel_with_status_internal(grpc_call* call,
+                                           grpc_status_code status,
+                                           const char* description) {
+  cancel_with_status(call, status, description);
+}
+
 static void set_final_status(grpc_call* call, grpc_error* error) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_call_error_trace)) {
     gpr_log(GPR_DEBUG, "set_final_status %s", call->is_client ? "CLI" : "SVR");
@@ -30,6 +30,7 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 #include <grpc/support/time.h>
@@ -38,6 +39,7 @@
 #include "src/core/lib/gpr/spinlock.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/atomic.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/pollset.h"
@@ -198,7 +200,8 @@ struct cq_vtable {
   grpc_cq_completion_type cq_completion_type;
   size_t data_size;
   void (*init)(void* data,
-               grpc_experimental_completion_queue_functor* shutdown_callback);
+               grpc_experimental_completion_queue_functor* shutdown_callback,
+               bool sharded);
   void (*shutdown)(grpc_completion_queue* cq);
   void (*destroy)(void* data);
   bool (*begin_op)(grpc_completion_queue* cq, void* tag);
@@ -213,14 +216,28 @@ struct cq_vtable {
 
 namespace {
 
-/* Queue that holds the cq_completion_events. Internally uses
+/* Upper bound on the number of shards in a CqEventQueue */
+#define MAX_CQ_EVENT_QUEUE_SHARDS 16
+
+/* Queue that holds the cq_completion_events. It is made of shards, each a
  * MultiProducerSingleConsumerQueue (a lockfree multiproducer single consumer
- * queue). It uses a queue_lock to support multiple consumers.
+ * queue) with its own queue_lock to support multiple consumers.
+ * By default there is a single shard, and events are popped in the order they
+ * were pushed. Completion queues created with the cq_sharded attribute get one
+ * shard per CPU: producers push to the shard of the CPU they run on, and
+ * consumers start with their own CPU's shard and move on to the others, so
+ * that threads sharing a completion queue rarely contend for the same lock.
+ * Events pushed from one CPU are then popped in order, but there is no
+ * ordering across shards.
  * Only used in completion queues whose completion_type is GRPC_CQ_NEXT */
 class CqEventQueue {
  public:
-  CqEventQueue() = default;
-  ~CqEventQueue() = default;
+  explicit CqEventQueue(bool sharded)
+      : num_shards_(sharded ? GPR_CLAMP(gpr_cpu_num_cores(), 1,
+                                        MAX_CQ_EVENT_QUEUE_SHARDS)
+                            : 1),
+        shards_(new Shard[num_shards_]) {}
+  ~CqEventQueue() { delete[] shards_; }
 
   /* Note: The counter is not incremented/decremented atomically with push/pop.
    * The count is only eventually consistent */
@@ -230,12 +247,26 @@ class CqEventQueue {
 
   bool Push(grpc_cq_completion* c);
   grpc_cq_completion* Pop();
+  /* Pops up to max_events completions into events and returns how many were
+   * popped. Like Pop(), may come back empty handed while the queue is not */
+  size_t PopBatch(grpc_cq_completion** events, size_t max_events);
 
  private:
-  /* Spinlock to serialize consumers i.e pop() operations */
-  gpr_spinlock queue_lock_ = GPR_SPINLOCK_INITIALIZER;
+  struct Shard {
+    /* Spinlock to serialize consumers i.e pop() operations */
+    gpr_spinlock queue_lock = GPR_SPINLOCK_INITIALIZER;
+    grpc_core::MultiProducerSingleConsumerQueue queue;
+    /* Keeps the next shard's lock off this shard's tail cacheline */
+    char padding[GPR_CACHELINE_SIZE];
+  };
+
+  /* The shard of the calling thread's CPU */
+  size_t CurrentShard() const {
+    return num_shards_ == 1 ? 0 : gpr_cpu_current_cpu() % num_shards_;
+  }
 
-  grpc_core::MultiProducerSingleConsumerQueue queue_;
+  const size_t num_shards_;
+  Shard* const shards_;
 
   /* A lazy counter of number of items in the queue. This is NOT atomically
      incremented/decremented along with push/pop operations and hence is only
@@ -244,6 +275,8 @@ class CqEventQueue {
 };
 
 struct cq_next_data {
+  explicit cq_next_data(bool sharded) : queue(sharded) {}
+
   ~cq_next_data() {
     GPR_ASSERT(queue.num_items() == 0);
 #ifndef NDEBUG
@@ -396,13 +429,17 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
 static grpc_event cq_pluck(grpc_completion_queue* cq, void* tag,
                            gpr_timespec deadline, void* reserved);
 
-// Note that cq_init_next and cq_init_pluck do not use the shutdown_callback
+// Note that cq_init_next and cq_init_pluck do not use the shutdown_callback,
+// and cq_init_pluck and cq_init_callback do not use sharded
 static void cq_init_next(
-    void* data, grpc_experimental_completion_queue_functor* shutdown_callback);
+    void* data, grpc_experimental_completion_queue_functor* shutdown_callback,
+    bool sharded);
 static void cq_init_pluck(
-    void* data, grpc_experimental_completion_queue_functor* shutdown_callback);
+    void* data, grpc_experimental_completion_queue_functor* shutdown_callback,
+    bool sharded);
 static void cq_init_callback(
-    void* data, grpc_experimental_completion_queue_functor* shutdown_callback);
+    void* data, grpc_experimental_completion_queue_functor* shutdown_callback,
+    bool sharded);
 static void cq_destroy_next(void* data);
 static void cq_destroy_pluck(void* data);
 static void cq_destroy_callback(void* data);
@@ -482,46 +519,68 @@ int grpc_completion_queue_thread_local_cache_flush(grpc_completion_queue* cq,
 }
 
 bool CqEventQueue::Push(grpc_cq_completion* c) {
-  queue_.Push(
+  Shard* shard = &shards_[CurrentShard()];
+  shard->queue.Push(
       reinterpret_cast<grpc_core::MultiProducerSingleConsumerQueue::Node*>(c));
   return num_queue_items_.FetchAdd(1, grpc_core::MemoryOrder::RELAXED) == 0;
 }
 
 grpc_cq_completion* CqEventQueue::Pop() {
   grpc_cq_completion* c = nullptr;
+  PopBatch(&c, 1);
+  return c;
+}
 
-  if (gpr_spinlock_trylock(&queue_lock_)) {
+size_t CqEventQueue::PopBatch(grpc_cq_completion** events,
+                              size_t max_events) {
+  /* A push is counted after it is linked in, so this can miss an event that
+     is being pushed; the pusher then sees the queue as empty and kicks. */
+  if (num_items() == 0) return 0;
+
+  size_t n = 0;
+  const size_t start = CurrentShard();
+  for (size_t i = 0; i < num_shards_ && n < max_events; i++) {
+    Shard* shard = &shards_[(start + i) % num_shards_];
+    if (!gpr_spinlock_trylock(&shard->queue_lock)) {
+      GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES();
+      continue;
+    }
     GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES();
 
-    bool is_empty = false;
-    c = reinterpret_cast<grpc_cq_completion*>(queue_.PopAndCheckEnd(&is_empty));
-    gpr_spinlock_unlock(&queue_lock_);
-
-    if (c == nullptr && !is_empty) {
-      GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES();
+    while (n < max_events) {
+      bool is_empty = false;
+      grpc_cq_completion* c = reinterpret_cast<grpc_cq_completion*>(
+          shard->queue.PopAndCheckEnd(&is_empty));
+      if (c == nullptr) {
+        if (!is_empty) {
+          GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES();
+        }
+        break;
+      }
+      events[n++] = c;
     }
-  } else {
-    GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES();
+    gpr_spinlock_unlock(&shard->queue_lock);
   }
 
-  if (c) {
-    num_queue_items_.FetchSub(1, grpc_core::MemoryOrder::RELAXED);
+  if (n > 0) {
+    num_queue_items_.FetchSub(n, grpc_core::MemoryOrder::RELAXED);
   }
 
-  return c;
+  return n;
 }
 
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
-    grpc_experimental_completion_queue_functor* shutdown_callback) {
+    grpc_experimental_completion_queue_functor* shutdown_callback,
+    bool sharded) {
   GPR_TIMER_SCOPE("grpc_completion_queue_create_internal", 0);
 
   grpc_completion_queue* cq;
 
   GRPC_API_TRACE(
       "grpc_completion_queue_create_internal(completion_type=%d, "
-      "polling_type=%d)",
-      2, (completion_type, polling_type));
+      "polling_type=%d, sharded=%d)",
+      3, (completion_type, polling_type, sharded));
 
   const cq_vtable* vtable = &g_cq_vtable[completion_type];
   const cq_poller_vtable* poller_vtable =
@@ -541,7 +600,7 @@ grpc_completion_queue* grpc_completion_queue_create_internal(
   new (&cq->owning_refs) grpc_core::RefCount(2);
 
   poller_vtable->init(POLLSET_FROM_CQ(cq), &cq->mu);
-  vtable->init(DATA_FROM_CQ(cq), shutdown_callback);
+  vtable->init(DATA_FROM_CQ(cq), shutdown_callback, sharded);
 
   GRPC_CLOSURE_INIT(&cq->pollset_shutdown_done, on_pollset_shutdown_done, cq,
                     grpc_schedule_on_exec_ctx);
@@ -550,8 +609,9 @@ grpc_completion_queue* grpc_completion_queue_create_internal(
 
 static void cq_init_next(
     void* data,
-    grpc_experimental_completion_queue_functor* /*shutdown_callback*/) {
-  new (data) cq_next_data();
+    grpc_experimental_completion_queue_functor* /*shutdown_callback*/,
+    bool sharded) {
+  new (data) cq_next_data(sharded);
 }
 
 static void cq_destroy_next(void* data) {
@@ -561,7 +621,8 @@ static void cq_destroy_next(void* data) {
 
 static void cq_init_pluck(
     void* data,
-    grpc_experimental_completion_queue_functor* /*shutdown_callback*/) {
+    grpc_experimental_completion_queue_functor* /*shutdown_callback*/,
+    bool /*sharded*/) {
   new (data) cq_pluck_data();
 }
 
@@ -571,7 +632,8 @@ static void cq_destroy_pluck(void* data) {
 }
 
 static void cq_init_callback(
-    void* data, grpc_experimental_completion_queue_functor* shutdown_callback) {
+    void* data, grpc_experimental_completion_queue_functor* shutdown_callback,
+    bool /*sharded*/) {
   new (data) cq_callback_data(shutdown_callback);
 }
 
@@ -964,24 +1026,40 @@ static void dump_pending_tags(grpc_completion_queue* cq) {
 static void dump_pending_tags(grpc_completion_queue* /*cq*/) {}
 #endif
 
-static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
-                          void* reserved) {
-  GPR_TIMER_SCOPE("grpc_completion_queue_next", 0);
+/* Most completions popped from the queue in one go by cq_pop_events */
+#define MAX_CQ_POP_BATCH 16
+
+/* Fills events with up to max_events completions popped from the queue and
+   returns how many there were */
+static size_t cq_pop_events(cq_next_data* cqd, grpc_event* events,
+                            size_t max_events) {
+  grpc_cq_completion* completions[MAX_CQ_POP_BATCH];
+  size_t n = 0;
+  while (n < max_events) {
+    size_t popped = cqd->queue.PopBatch(
+        completions,
+        GPR_MIN(max_events - n, static_cast<size_t>(MAX_CQ_POP_BATCH)));
+    if (popped == 0) break;
+    for (size_t i = 0; i < popped; i++) {
+      grpc_cq_completion* c = completions[i];
+      events[n].type = GRPC_OP_COMPLETE;
+      events[n].success = c->next & 1u;
+      events[n].tag = c->tag;
+      c->done(c->done_arg, c);
+      n++;
+    }
+  }
+  return n;
+}
 
-  grpc_event ret;
+/* Shared by grpc_completion_queue_next and grpc_completion_queue_next_batch:
+   blocks until at least one event can be returned and fills in up to
+   max_events of them. A timeout or shutdown is reported as a single event. */
+static size_t cq_next_events(grpc_completion_queue* cq, grpc_event* events,
+                             size_t max_events, gpr_timespec deadline) {
+  size_t num_events = 0;
   cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
 
-  GRPC_API_TRACE(
-      "grpc_completion_queue_next("
-      "cq=%p, "
-      "deadline=gpr_timespec { tv_sec: %" PRId64
-      ", tv_nsec: %d, clock_type: %d }, "
-      "reserved=%p)",
-      5,
-      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
-       reserved));
-  GPR_ASSERT(!reserved);
-
   dump_pending_tags(cq);
 
   GRPC_CQ_INTERNAL_REF(cq, "next");
@@ -1001,27 +1079,24 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     if (is_finished_arg.stolen_completion != nullptr) {
       grpc_cq_completion* c = is_finished_arg.stolen_completion;
       is_finished_arg.stolen_completion = nullptr;
-      ret.type = GRPC_OP_COMPLETE;
-      ret.success = c->next & 1u;
-      ret.tag = c->tag;
+      events[0].type = GRPC_OP_COMPLETE;
+      events[0].success = c->next & 1u;
+      events[0].tag = c->tag;
       c->done(c->done_arg, c);
-      break;
+      num_events = 1;
     }
 
-    grpc_cq_completion* c = cqd->queue.Pop();
+    num_events +=
+        cq_pop_events(cqd, events + num_events, max_events - num_events);
 
-    if (c != nullptr) {
-      ret.type = GRPC_OP_COMPLETE;
-      ret.success = c->next & 1u;
-      ret.tag = c->tag;
-      c->done(c->done_arg, c);
+    if (num_events > 0) {
       break;
     } else {
-      /* If c == NULL it means either the queue is empty OR in an transient
-         inconsistent state. If it is the latter, we shold do a 0-timeout poll
-         so that the thread comes back quickly from poll to make a second
-         attempt at popping. Not doing this can potentially deadlock this
-         thread forever (if the deadline is infinity) */
+      /* If nothing was popped it means either the queue is empty OR in an
+         transient inconsistent state. If it is the latter, we shold do a
+         0-timeout poll so that the thread comes back quickly from poll to make
+         a second attempt at popping. Not doing this can potentially deadlock
+         this thread forever (if the deadline is infinity) */
       if (cqd->queue.num_items() > 0) {
         iteration_deadline = 0;
       }
@@ -1040,15 +1115,17 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
         continue;
       }
 
-      ret.type = GRPC_QUEUE_SHUTDOWN;
-      ret.success = 0;
+      events[0].type = GRPC_QUEUE_SHUTDOWN;
+      events[0].success = 0;
+      num_events = 1;
       break;
     }
 
     if (!is_finished_arg.first_loop &&
         grpc_core::ExecCtx::Get()->Now() >= deadline_millis) {
-      ret.type = GRPC_QUEUE_TIMEOUT;
-      ret.success = 0;
+      events[0].type = GRPC_QUEUE_TIMEOUT;
+      events[0].success = 0;
+      num_events = 1;
       dump_pending_tags(cq);
       break;
     }
@@ -1065,8 +1142,9 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
       gpr_log(GPR_ERROR, "Completion queue next failed: %s", msg);
 
       GRPC_ERROR_UNREF(err);
-      ret.type = GRPC_QUEUE_TIMEOUT;
-      ret.success = 0;
+      events[0].type = GRPC_QUEUE_TIMEOUT;
+      events[0].success = 0;
+      num_events = 1;
       dump_pending_tags(cq);
       break;
     }
@@ -1080,11 +1158,33 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     gpr_mu_unlock(cq->mu);
   }
 
-  GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &ret);
+  for (size_t i = 0; i < num_events; i++) {
+    GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &events[i]);
+  }
   GRPC_CQ_INTERNAL_UNREF(cq, "next");
 
   GPR_ASSERT(is_finished_arg.stolen_completion == nullptr);
 
+  return num_events;
+}
+
+static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
+                          void* reserved) {
+  GPR_TIMER_SCOPE("grpc_completion_queue_next", 0);
+
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next("
+      "cq=%p, "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      5,
+      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
+       reserved));
+  GPR_ASSERT(!reserved);
+
+  grpc_event ret;
+  cq_next_events(cq, &ret, 1, deadline);
   return ret;
 }
 
@@ -1135,6 +1235,28 @@ grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
   return cq->vtable->next(cq, deadline, reserved);
 }
 
+size_t grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                        grpc_event* events, size_t max_events,
+                                        gpr_timespec deadline,
+                                        void* reserved) {
+  GPR_TIMER_SCOPE("grpc_completion_queue_next_batch", 0);
+
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next_batch("
+      "cq=%p, events=%p, max_events=%" PRIuPTR ", "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      7,
+      (cq, events, max_events, deadline.tv_sec, deadline.tv_nsec,
+       (int)deadline.clock_type, reserved));
+  GPR_ASSERT(!reserved);
+  GPR_ASSERT(cq->vtable->cq_completion_type == GRPC_CQ_NEXT);
+  GPR_ASSERT(max_events > 0);
+
+  return cq_next_events(cq, events, max_events, deadline);
+}
+
 static int add_plucker(grpc_completion_queue* cq, void* tag,
                        grpc_pollset_worker** worker) {
   cq_pluck_data* cqd = static_cast<cq_pluck_data*> DATA_FROM_CQ(cq);
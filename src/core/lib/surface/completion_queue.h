@@ -92,6 +92,7 @@ int grpc_get_cq_poll_num(grpc_completion_queue* cq);
 
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
-    grpc_experimental_completion_queue_functor* shutdown_callback);
+    grpc_experimental_completion_queue_functor* shutdown_callback,
+    bool sharded);
 
 #endif /* GRPC_CORE_LIB_SURFACE_COMPLETION_QUEUE_H */
@@ -31,7 +31,9 @@ static grpc_completion_queue* default_create(
     const grpc_completion_queue_factory* /*factory*/,
     const grpc_completion_queue_attributes* attr) {
   return grpc_completion_queue_create_internal(
-      attr->cq_completion_type, attr->cq_polling_type, attr->cq_shutdown_cb);
+      attr->cq_completion_type, attr->cq_polling_type, attr->cq_shutdown_cb,
+      attr->version >= GRPC_CQ_VERSION_MINIMUM_FOR_SHARDING &&
+          attr->cq_sharded != 0);
 }
 
 static grpc_completion_queue_factory_vtable default_vtable = {default_create};
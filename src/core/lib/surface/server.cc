@@ -534,7 +534,14 @@ RefCountedPtr<channelz::ServerNode> CreateChannelzNode(
 Server::Server(const grpc_channel_args* args)
     : channel_args_(grpc_channel_args_copy(args)),
       default_resource_user_(CreateDefaultResourceUser(args)),
-      channelz_node_(CreateChannelzNode(args)) {}
+      channelz_node_(CreateChannelzNode(args)),
+      max_inflight_calls_(grpc_channel_args_find_integer(
+          args, GRPC_ARG_SERVER_MAX_INFLIGHT_CALLS, {INT_MAX, 1, INT_MAX})),
+      reject_memory_pressure_(
+          grpc_channel_args_find_integer(
+              args, GRPC_ARG_SERVER_MEMORY_PRESSURE_REJECT_PERCENT,
+              {0, 0, 100}) /
+          100.0) {}
 
 Server::~Server() {
   grpc_channel_args_destroy(channel_args_);
@@ -762,6 +769,18 @@ std::vector<grpc_channel*> Server::GetChannelsLocked() const {
   return channels;
 }
 
+const char* Server::CheckCallAdmission() const {
+  if (calls_in_flight_.load(std::memory_order_relaxed) > max_inflight_calls_) {
+    return "Too many calls in flight";
+  }
+  if (reject_memory_pressure_ > 0 && default_resource_user_ != nullptr &&
+      grpc_resource_quota_get_memory_pressure(grpc_resource_user_quota(
+          default_resource_user_)) >= reject_memory_pressure_) {
+    return "Server memory pressure too high";
+  }
+  return nullptr;
+}
+
 void Server::ListenerDestroyDone(void* arg, grpc_error* /*error*/) {
   Server* server = static_cast<Server*>(arg);
   MutexLock lock(&server->mu_global_);
@@ -1135,6 +1154,16 @@ void Server::ChannelData::AcceptStream(void* arg, grpc_transport* /*transport*/,
     calld->FailCallCreation();
     return;
   }
+  // Shed load before the call is matched and anything else is allocated for
+  // it. The call itself is counted in calls_in_flight_ already.
+  const char* rejection = chand->server_->CheckCallAdmission();
+  if (rejection != nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_server_channel_trace)) {
+      gpr_log(GPR_INFO, "Rejecting incoming call: %s", rejection);
+    }
+    calld->Reject(rejection);
+    return;
+  }
   calld->Start(elem);
 }
 
@@ -1188,6 +1217,7 @@ Server::CallData::CallData(grpc_call_element* elem,
     : server_(std::move(server)),
       call_(grpc_call_from_top_element(elem)),
       call_combiner_(args.call_combiner) {
+  server_->calls_in_flight_.fetch_add(1, std::memory_order_relaxed);
   GRPC_CLOSURE_INIT(&recv_initial_metadata_ready_, RecvInitialMetadataReady,
                     elem, grpc_schedule_on_exec_ctx);
   GRPC_CLOSURE_INIT(&recv_trailing_metadata_ready_, RecvTrailingMetadataReady,
@@ -1196,6 +1226,7 @@ Server::CallData::CallData(grpc_call_element* elem,
 
 Server::CallData::~CallData() {
   GPR_ASSERT(state_.Load(MemoryOrder::RELAXED) != CallState::PENDING);
+  server_->calls_in_flight_.fetch_sub(1, std::memory_order_relaxed);
   GRPC_ERROR_UNREF(recv_initial_metadata_error_);
   if (host_.has_value()) {
     grpc_slice_unref_internal(*host_);
@@ -1233,6 +1264,13 @@ void Server::CallData::FailCallCreation() {
   }
 }
 
+void Server::CallData::Reject(const char* reason) {
+  state_.Store(CallState::ZOMBIED, MemoryOrder::RELAXED);
+  grpc_call_cancel_with_status_internal(call_, GRPC_STATUS_RESOURCE_EXHAUSTED,
+                                        reason);
+  KillZombie();
+}
+
 void Server::CallData::Start(grpc_call_element* elem) {
   grpc_op op;
   op.op = GRPC_OP_RECV_INITIAL_METADATA;
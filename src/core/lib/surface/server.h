@@ -258,6 +258,10 @@ class Server : public InternallyRefCounted<Server> {
 
     void FailCallCreation();
 
+    // Fails a call that was not admitted with RESOURCE_EXHAUSTED, before it
+    // is started. Invoked from ChannelData::AcceptStream().
+    void Reject(const char* reason);
+
     // Filter vtable functions.
     static grpc_error* InitCallElement(grpc_call_element* elem,
                                        const grpc_call_element_args* args);
@@ -356,9 +360,21 @@ class Server : public InternallyRefCounted<Server> {
 
   std::vector<grpc_channel*> GetChannelsLocked() const;
 
+  // Returns why a newly accepted call should be rejected, or null if it can
+  // proceed.
+  const char* CheckCallAdmission() const;
+
   grpc_channel_args* const channel_args_;
   grpc_resource_user* default_resource_user_ = nullptr;
   RefCountedPtr<channelz::ServerNode> channelz_node_;
+
+  // Admission control: see GRPC_ARG_SERVER_MAX_INFLIGHT_CALLS and
+  // GRPC_ARG_SERVER_MEMORY_PRESSURE_REJECT_PERCENT. The memory pressure limit
+  // is 0 when disabled.
+  const int max_inflight_calls_;
+  const double reject_memory_pressure_;
+  // Number of calls whose CallData is alive.
+  std::atomic<int> calls_in_flight_{0};
   std::unique_ptr<grpc_server_config_fetcher> config_fetcher_;
 
   std::vector<grpc_completion_queue*> cqs_;
@@ -37,6 +37,9 @@ BdpEstimator::BdpEstimator(const char* name)
       inter_ping_delay_(100),  // start at 100ms
       stable_estimate_count_(0),
       bw_est_(0),
+      completed_pings_(0),
+      last_ping_bytes_(0),
+      last_ping_rtt_(0),
       name_(name) {}
 
 grpc_millis BdpEstimator::CompletePing() {
@@ -79,6 +82,9 @@ grpc_millis BdpEstimator::CompletePing() {
               inter_ping_delay_);
     }
   }
+  completed_pings_++;
+  last_ping_bytes_ = accumulator_;
+  last_ping_rtt_ = dt;
   ping_state_ = PingState::UNSCHEDULED;
   accumulator_ = 0;
   return grpc_core::ExecCtx::Get()->Now() + inter_ping_delay_;
@@ -76,6 +76,13 @@ class BdpEstimator {
 
   int64_t accumulator() { return accumulator_; }
 
+  // Number of pings completed so far, and what the last one measured: the
+  // bytes received while it was outstanding, and its round-trip time in
+  // seconds
+  int64_t completed_pings() const { return completed_pings_; }
+  int64_t last_ping_bytes() const { return last_ping_bytes_; }
+  double last_ping_rtt() const { return last_ping_rtt_; }
+
  private:
   enum class PingState { UNSCHEDULED, SCHEDULED, STARTED };
 
@@ -87,6 +94,9 @@ class BdpEstimator {
   int inter_ping_delay_;
   int stable_estimate_count_;
   double bw_est_;
+  int64_t completed_pings_;
+  int64_t last_ping_bytes_;
+  double last_ping_rtt_;
   const char* name_;
 };
 
@@ -0,0 +1,56 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/transport/bottleneck_estimator.h"
+
+#include "src/core/lib/gpr/useful.h"
+
+namespace grpc_core {
+
+BottleneckEstimator::BottleneckEstimator() : BottleneckEstimator(Args()) {}
+
+BottleneckEstimator::BottleneckEstimator(const Args& args) : args_(args) {}
+
+void BottleneckEstimator::AddSample(int64_t delivered_bytes, double rtt,
+                                    grpc_millis now) {
+  if (rtt <= 0) return;
+  int window = args_.bandwidth_window_rounds();
+  if (window < 1) window = 1;
+  if (window > kMaxBandwidthWindowRounds) window = kMaxBandwidthWindowRounds;
+  /* the bottleneck bandwidth is the best delivery rate of the last rounds:
+     rounds that were limited by the application or by the window itself
+     deliver less, and are ignored by the max */
+  bandwidth_samples_[rounds_ % window] =
+      static_cast<double>(delivered_bytes) / rtt;
+  rounds_++;
+  max_bandwidth_ = 0.0;
+  for (int64_t i = 0; i < GPR_MIN(rounds_, window); i++) {
+    max_bandwidth_ = GPR_MAX(max_bandwidth_, bandwidth_samples_[i]);
+  }
+  /* samples above the propagation delay saw queueing; keep the smallest one,
+     but let it expire so that route changes are eventually picked up */
+  if (min_rtt_ == 0.0 || rtt <= min_rtt_ ||
+      now - min_rtt_stamp_ > args_.min_rtt_window()) {
+    min_rtt_ = rtt;
+    min_rtt_stamp_ = now;
+  }
+}
+
+}  // namespace grpc_core
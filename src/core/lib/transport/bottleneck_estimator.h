@@ -0,0 +1,91 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_TRANSPORT_BOTTLENECK_ESTIMATOR_H
+#define GRPC_CORE_LIB_TRANSPORT_BOTTLENECK_ESTIMATOR_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+/* \file Bottleneck bandwidth and round-trip time estimator.
+   Models a path from delivery samples (bytes delivered over one round trip),
+   in the manner of BBR: the bottleneck bandwidth is the largest delivery rate
+   seen over the last few rounds, and the propagation delay is the smallest
+   round-trip time seen over a longer period. Their product is the bandwidth
+   delay product of the path, independent of any queueing the samples saw. */
+
+namespace grpc_core {
+
+class BottleneckEstimator {
+ public:
+  class Args {
+   public:
+    int bandwidth_window_rounds() const { return bandwidth_window_rounds_; }
+    grpc_millis min_rtt_window() const { return min_rtt_window_; }
+
+    Args& set_bandwidth_window_rounds(int bandwidth_window_rounds) {
+      bandwidth_window_rounds_ = bandwidth_window_rounds;
+      return *this;
+    }
+    Args& set_min_rtt_window(grpc_millis min_rtt_window) {
+      min_rtt_window_ = min_rtt_window;
+      return *this;
+    }
+
+   private:
+    int bandwidth_window_rounds_ = 10;
+    grpc_millis min_rtt_window_ = 10000;
+  };
+
+  BottleneckEstimator();
+  explicit BottleneckEstimator(const Args& args);
+
+  /// Adds a sample: \a delivered_bytes arrived over a round trip of \a rtt
+  /// seconds, which completed at \a now
+  void AddSample(int64_t delivered_bytes, double rtt, grpc_millis now);
+
+  /// Returns true once at least one sample has been added
+  bool has_samples() const { return rounds_ > 0; }
+
+  /// Bottleneck bandwidth, in bytes per second
+  double max_bandwidth() const { return max_bandwidth_; }
+
+  /// Propagation round-trip time, in seconds
+  double min_rtt() const { return min_rtt_; }
+
+  /// Bandwidth delay product of the path, in bytes
+  double EstimateBdp() const { return max_bandwidth_ * min_rtt_; }
+
+ private:
+  static constexpr int kMaxBandwidthWindowRounds = 32;
+
+  const Args args_;
+  // Delivery rate of the last rounds, indexed by round modulo the window
+  double bandwidth_samples_[kMaxBandwidthWindowRounds] = {};
+  int64_t rounds_ = 0;
+  double max_bandwidth_ = 0.0;
+  double min_rtt_ = 0.0;
+  grpc_millis min_rtt_stamp_ = 0;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_TRANSPORT_BOTTLENECK_ESTIMATOR_H */
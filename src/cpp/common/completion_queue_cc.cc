@@ -17,6 +17,7 @@
 
 #include <grpcpp/completion_queue.h>
 
+#include <algorithm>
 #include <memory>
 
 #include <grpc/grpc.h>
@@ -70,6 +71,55 @@ CompletionQueue::NextStatus CompletionQueue::AsyncNextInternal(
   }
 }
 
+size_t CompletionQueue::NextBatch(void** tags, bool* oks, size_t max_events) {
+  size_t num_events = 0;
+  if (AsyncNextBatchInternal(tags, oks, max_events, &num_events,
+                             gpr_inf_future(GPR_CLOCK_REALTIME)) != GOT_EVENT) {
+    return 0;
+  }
+  return num_events;
+}
+
+CompletionQueue::NextStatus CompletionQueue::AsyncNextBatchInternal(
+    void** tags, bool* oks, size_t max_events, size_t* num_events,
+    gpr_timespec deadline) {
+  // Events are fetched from the core in chunks of at most this many.
+  constexpr size_t kMaxCoreBatch = 64;
+  grpc_event events[kMaxCoreBatch];
+  GPR_ASSERT(max_events > 0);
+  for (;;) {
+    size_t n = grpc_completion_queue_next_batch(
+        cq_, events, std::min(max_events, kMaxCoreBatch), deadline, nullptr);
+    switch (events[0].type) {
+      case GRPC_QUEUE_TIMEOUT:
+        return TIMEOUT;
+      case GRPC_QUEUE_SHUTDOWN:
+        return SHUTDOWN;
+      case GRPC_OP_COMPLETE:
+        break;
+    }
+    size_t num_returned = 0;
+    for (size_t i = 0; i < n; i++) {
+      GPR_ASSERT(events[i].type == GRPC_OP_COMPLETE);
+      auto core_cq_tag =
+          static_cast<::grpc::internal::CompletionQueueTag*>(events[i].tag);
+      bool ok = events[i].success != 0;
+      void* tag = core_cq_tag;
+      // Internal tags (e.g. from the server's own request matching) may
+      // consume the event; only the ones that surface are returned.
+      if (core_cq_tag->FinalizeResult(&tag, &ok)) {
+        tags[num_returned] = tag;
+        oks[num_returned] = ok;
+        num_returned++;
+      }
+    }
+    if (num_returned > 0) {
+      *num_events = num_returned;
+      return GOT_EVENT;
+    }
+  }
+}
+
 CompletionQueue::CompletionQueueTLSCache::CompletionQueueTLSCache(
     CompletionQueue* cq)
     : cq_(cq), flushed_(false) {
@@ -136,6 +136,12 @@ ServerBuilder& ServerBuilder::experimental_type::SetContextAllocator(
   return *builder_;
 }
 
+ServerBuilder& ServerBuilder::experimental_type::SetThreadPerCore(
+    bool enable) {
+  builder_->thread_per_core_ = enable;
+  return *builder_;
+}
+
 std::unique_ptr<grpc::experimental::ExternalConnectionAcceptor>
 ServerBuilder::experimental_type::AddExternalConnectionAcceptor(
     experimental_type::ExternalConnectionType type,
@@ -251,6 +257,11 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
                               grpc_resource_quota_arg_vtable());
   }
 
+  if (thread_per_core_) {
+    args.SetInt(GRPC_ARG_SERVER_CPU_AFFINITY, 1);
+    sync_server_settings_.num_cqs = static_cast<int>(gpr_cpu_num_cores());
+  }
+
   for (const auto& plugin : plugins_) {
     plugin->UpdateServerBuilder(this);
     plugin->UpdateChannelArguments(&args);
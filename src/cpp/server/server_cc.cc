@@ -799,6 +799,25 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
     GPR_UNREACHABLE_CODE(return TIMEOUT);
   }
 
+  WorkStatus PollForWorkBatch(void** tags, bool* oks, size_t max_items,
+                              size_t* num_items) override {
+    gpr_timespec deadline =
+        gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                     gpr_time_from_millis(cq_timeout_msec_, GPR_TIMESPAN));
+
+    switch (server_cq_->AsyncNextBatchInternal(tags, oks, max_items, num_items,
+                                               deadline)) {
+      case grpc::CompletionQueue::TIMEOUT:
+        return TIMEOUT;
+      case grpc::CompletionQueue::SHUTDOWN:
+        return SHUTDOWN;
+      case grpc::CompletionQueue::GOT_EVENT:
+        return WORK_FOUND;
+    }
+
+    GPR_UNREACHABLE_CODE(return TIMEOUT);
+  }
+
   void DoWork(void* tag, bool ok, bool resources) override {
     SyncRequest* sync_req = static_cast<SyncRequest*>(tag);
 
@@ -956,6 +975,14 @@ Server::Server(
         strcmp(channel_args.args[i].key, GRPC_ARG_MAX_RECEIVE_MESSAGE_LENGTH)) {
       max_receive_message_size_ = channel_args.args[i].value.integer;
     }
+    if (0 == strcmp(channel_args.args[i].key, GRPC_ARG_SERVER_CPU_AFFINITY) &&
+        channel_args.args[i].value.integer != 0) {
+      // Connections received on core i go to the i-th sync server CQ, so
+      // serve that CQ from core i as well.
+      for (size_t j = 0; j < sync_req_mgrs_.size(); j++) {
+        sync_req_mgrs_[j]->SetCpuAffinity(static_cast<int>(j));
+      }
+    }
   }
   server_ = grpc_server_create(&channel_args, nullptr);
   grpc_server_set_config_fetcher(server_, server_config_fetcher);
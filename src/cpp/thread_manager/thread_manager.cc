@@ -18,16 +18,72 @@
 
 #include "src/cpp/thread_manager/thread_manager.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <climits>
 
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
+#include <grpc/support/port_platform.h>
+#include <grpc/support/time.h>
+
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_STRING(
+    grpc_sync_server_strategy, "legacy",
+    "Declares how synchronous servers run their threads: 'legacy' (every "
+    "thread polls and works) or 'pooled' (pollers feeding a worker pool).")
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_sync_server_max_workers, 0,
+    "Most worker threads each completion queue of a synchronous server runs "
+    "with the 'pooled' strategy. 0 means 4 per core.")
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_sync_server_worker_idle_ms, 10000,
+    "How long, in milliseconds, a worker thread of the 'pooled' synchronous "
+    "server strategy waits for work before exiting.")
+
 namespace grpc {
 
-ThreadManager::WorkerThread::WorkerThread(ThreadManager* thd_mgr)
-    : thd_mgr_(thd_mgr) {
+namespace {
+
+// Most work items a poller fetches at once in the pooled strategy
+constexpr size_t kMaxPollBatch = 16;
+
+// Bounds of the number of spin iterations of an idle pooled worker
+constexpr int kMinSpin = 16;
+constexpr int kMaxSpin = 16 * 1024;
+
+// Worker threads per core in the pooled strategy, by default
+constexpr int kDefaultMaxWorkersPerCore = 4;
+
+int MaxPooledWorkers() {
+  int max_workers = GPR_GLOBAL_CONFIG_GET(grpc_sync_server_max_workers);
+  if (max_workers <= 0) {
+    max_workers = kDefaultMaxWorkersPerCore * gpr_cpu_num_cores();
+  }
+  return max_workers;
+}
+
+bool UsePooledStrategy() {
+  grpc_core::UniquePtr<char> strategy =
+      GPR_GLOBAL_CONFIG_GET(grpc_sync_server_strategy);
+  if (strcmp(strategy.get(), "pooled") == 0) return true;
+  if (strcmp(strategy.get(), "legacy") != 0) {
+    gpr_log(GPR_ERROR, "Unknown sync server strategy '%s', using 'legacy'",
+            strategy.get());
+  }
+  return false;
+}
+
+}  // namespace
+
+ThreadManager::WorkerThread::WorkerThread(
+    ThreadManager* thd_mgr, void (ThreadManager::*work_loop)())
+    : thd_mgr_(thd_mgr), work_loop_(work_loop) {
   // Make thread creation exclusive with respect to its join happening in
   // ~WorkerThread().
   thd_ = grpc_core::Thread(
@@ -40,7 +96,12 @@ ThreadManager::WorkerThread::WorkerThread(ThreadManager* thd_mgr)
 }
 
 void ThreadManager::WorkerThread::Run() {
-  thd_mgr_->MainWorkLoop();
+  if (thd_mgr_->cpu_affinity_ >= 0 &&
+      !grpc_core::Thread::PinCurrentToCore(thd_mgr_->cpu_affinity_)) {
+    gpr_log(GPR_DEBUG, "Failed to pin grpcpp_sync_server thread to core %d",
+            thd_mgr_->cpu_affinity_);
+  }
+  (thd_mgr_->*work_loop_)();
   thd_mgr_->MarkAsCompleted(this);
 }
 
@@ -57,7 +118,12 @@ ThreadManager::ThreadManager(const char* name,
       min_pollers_(min_pollers),
       max_pollers_(max_pollers == -1 ? INT_MAX : max_pollers),
       num_threads_(0),
-      max_active_threads_sofar_(0) {
+      max_active_threads_sofar_(0),
+      pooled_(UsePooledStrategy()),
+      max_workers_(MaxPooledWorkers()),
+      worker_idle_ms_(
+          std::max(0, GPR_GLOBAL_CONFIG_GET(grpc_sync_server_worker_idle_ms))),
+      max_spin_(gpr_cpu_num_cores() > 1 ? kMaxSpin : 0) {
   resource_user_ = grpc_resource_user_create(resource_quota, name);
 }
 
@@ -94,12 +160,22 @@ int ThreadManager::GetMaxActiveThreadsSoFar() {
   return max_active_threads_sofar_;
 }
 
+int ThreadManager::GetNumActiveThreads() {
+  grpc_core::MutexLock lock(&mu_);
+  return num_threads_;
+}
+
 void ThreadManager::MarkAsCompleted(WorkerThread* thd) {
   {
     grpc_core::MutexLock list_lock(&list_mu_);
     completed_threads_.push_back(thd);
   }
 
+  // Give a thread back to the resource quota. This must happen before the
+  // count drops: once it reaches zero, Wait() returns and the ThreadManager,
+  // along with resource_user_, may be destroyed.
+  grpc_resource_user_free_threads(resource_user_, 1);
+
   {
     grpc_core::MutexLock lock(&mu_);
     num_threads_--;
@@ -107,9 +183,6 @@ void ThreadManager::MarkAsCompleted(WorkerThread* thd) {
       shutdown_cv_.Signal();
     }
   }
-
-  // Give a thread back to the resource quota
-  grpc_resource_user_free_threads(resource_user_, 1);
 }
 
 void ThreadManager::CleanupCompletedThreads() {
@@ -124,6 +197,10 @@ void ThreadManager::CleanupCompletedThreads() {
 }
 
 void ThreadManager::Initialize() {
+  if (pooled_) {
+    InitializePooled();
+    return;
+  }
   if (!grpc_resource_user_allocate_threads(resource_user_, min_pollers_)) {
     gpr_log(GPR_ERROR,
             "No thread quota available to even create the minimum required "
@@ -140,7 +217,7 @@ void ThreadManager::Initialize() {
   }
 
   for (int i = 0; i < min_pollers_; i++) {
-    WorkerThread* worker = new WorkerThread(this);
+    WorkerThread* worker = new WorkerThread(this, &ThreadManager::MainWorkLoop);
     GPR_ASSERT(worker->created());  // Must be able to create the minimum
     worker->Start();
   }
@@ -180,7 +257,8 @@ void ThreadManager::MainWorkLoop() {
             }
             // Drop lock before spawning thread to avoid contention
             lock.Unlock();
-            WorkerThread* worker = new WorkerThread(this);
+            WorkerThread* worker =
+                new WorkerThread(this, &ThreadManager::MainWorkLoop);
             if (worker->created()) {
               worker->Start();
             } else {
@@ -262,4 +340,195 @@ void ThreadManager::MainWorkLoop() {
   // enough threads.
 }
 
+ThreadManager::WorkStatus ThreadManager::PollForWorkBatch(void** tags,
+                                                          bool* oks,
+                                                          size_t /*max_items*/,
+                                                          size_t* num_items) {
+  WorkStatus work_status = PollForWork(&tags[0], &oks[0]);
+  *num_items = work_status == WORK_FOUND ? 1 : 0;
+  return work_status;
+}
+
+void ThreadManager::InitializePooled() {
+  const int num_pollers = std::max(1, min_pollers_);
+  if (!grpc_resource_user_allocate_threads(resource_user_, num_pollers)) {
+    gpr_log(GPR_ERROR,
+            "No thread quota available to even create the required polling "
+            "threads (i.e %d). Unable to start the thread manager",
+            num_pollers);
+    abort();
+  }
+
+  {
+    grpc_core::MutexLock lock(&mu_);
+    num_pollers_ = num_pollers;
+    num_threads_ = num_pollers;
+    max_active_threads_sofar_ = num_pollers;
+  }
+
+  for (int i = 0; i < num_pollers; i++) {
+    WorkerThread* poller = new WorkerThread(this, &ThreadManager::PollerLoop);
+    GPR_ASSERT(poller->created());  // Must be able to create the pollers
+    poller->Start();
+  }
+}
+
+void ThreadManager::PollerLoop() {
+  void* tags[kMaxPollBatch];
+  bool oks[kMaxPollBatch];
+  while (true) {
+    size_t num_items = 0;
+    WorkStatus work_status =
+        PollForWorkBatch(tags, oks, kMaxPollBatch, &num_items);
+    if (work_status == SHUTDOWN) break;
+    if (work_status == WORK_FOUND) DispatchWork(tags, oks, num_items);
+    // As in MainWorkLoop(), work found is still done after a shutdown, but
+    // no more polling happens.
+    if (IsShutdown()) break;
+  }
+
+  {
+    grpc_core::MutexLock lock(&mu_);
+    num_pollers_--;
+    if (num_pollers_ == 0) {
+      // No more work can come in: have the workers drain the queue and exit
+      work_cv_.Broadcast();
+    }
+  }
+  CleanupCompletedThreads();
+}
+
+void ThreadManager::DispatchWork(void** tags, bool* oks, size_t num_items) {
+  grpc_core::ReleasableMutexLock lock(&mu_);
+  for (size_t i = 0; i < num_items; i++) {
+    work_queue_.push_back({tags[i], oks[i]});
+  }
+  num_queued_.fetch_add(num_items, std::memory_order_relaxed);
+
+  // Spinning workers notice the new work by themselves; wake up as many
+  // sleeping ones as there are items left for them.
+  int num_spinning = num_idle_workers_ - num_sleeping_workers_;
+  int num_to_wake =
+      std::min(static_cast<int>(num_items) - num_spinning,
+               num_sleeping_workers_ - num_signalled_workers_);
+  for (int i = 0; i < num_to_wake; i++) {
+    num_signalled_workers_++;
+    work_cv_.Signal();
+  }
+
+  // Grow the pool when the idle workers cannot absorb the whole queue, up to
+  // max_workers_. New workers count as idle from the start, so that
+  // concurrent batches do not spawn threads for the same items.
+  int num_to_spawn = 0;
+  while (!shutdown_ &&
+         static_cast<int>(work_queue_.size()) >
+             num_idle_workers_ + num_to_spawn &&
+         num_workers_ + num_to_spawn < max_workers_ &&
+         grpc_resource_user_allocate_threads(resource_user_, 1)) {
+    num_to_spawn++;
+  }
+  num_workers_ += num_to_spawn;
+  num_idle_workers_ += num_to_spawn;
+  num_threads_ += num_to_spawn;
+  if (num_threads_ > max_active_threads_sofar_) {
+    max_active_threads_sofar_ = num_threads_;
+  }
+  // Drop lock before spawning threads to avoid contention
+  lock.Unlock();
+
+  for (int i = 0; i < num_to_spawn; i++) {
+    WorkerThread* worker =
+        new WorkerThread(this, &ThreadManager::PooledWorkerLoop);
+    if (worker->created()) {
+      worker->Start();
+    } else {
+      grpc_core::MutexLock failure_lock(&mu_);
+      num_workers_--;
+      num_idle_workers_--;
+      num_threads_--;
+      grpc_resource_user_free_threads(resource_user_, 1);
+      delete worker;
+    }
+  }
+
+  // Without any worker (the thread quota is exhausted) the poller has to do
+  // the work itself, and reports the lack of resources as MainWorkLoop()
+  // does when no thread is left.
+  while (true) {
+    lock.Lock();
+    if (num_workers_ > 0 || work_queue_.empty()) {
+      lock.Unlock();
+      break;
+    }
+    WorkItem item = work_queue_.front();
+    work_queue_.pop_front();
+    num_queued_.fetch_sub(1, std::memory_order_relaxed);
+    lock.Unlock();
+    DoWork(item.tag, item.ok, false);
+  }
+}
+
+void ThreadManager::PooledWorkerLoop() {
+  int spin_limit = max_spin_;
+  grpc_core::ReleasableMutexLock lock(&mu_);
+  // A new worker starts out idle (see DispatchWork())
+  while (true) {
+    if (!work_queue_.empty()) {
+      WorkItem item = work_queue_.front();
+      work_queue_.pop_front();
+      num_queued_.fetch_sub(1, std::memory_order_relaxed);
+      num_idle_workers_--;
+      // Pass the wake-up on if more work is waiting for a sleeping worker
+      if (!work_queue_.empty() &&
+          num_sleeping_workers_ > num_signalled_workers_) {
+        num_signalled_workers_++;
+        work_cv_.Signal();
+      }
+      lock.Unlock();
+      DoWork(item.tag, item.ok, true);
+      lock.Lock();
+      num_idle_workers_++;
+      continue;
+    }
+    // Queue drained and no poller left: shutdown is complete
+    if (num_pollers_ == 0) break;
+
+    lock.Unlock();
+    bool found_work = SpinForWork(&spin_limit);
+    lock.Lock();
+    if (found_work || !work_queue_.empty() || num_pollers_ == 0) continue;
+
+    num_sleeping_workers_++;
+    gpr_timespec idle_deadline =
+        gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                     gpr_time_from_millis(worker_idle_ms_, GPR_TIMESPAN));
+    bool timed_out = work_cv_.Wait(&mu_, idle_deadline);
+    num_sleeping_workers_--;
+    // A spurious wake-up may consume another worker's signal: harmless, as
+    // whoever takes an item passes the wake-up on.
+    if (num_signalled_workers_ > 0) num_signalled_workers_--;
+    // Idle for worker_idle_ms_: give the thread back. DispatchWork() creates
+    // new workers if the load comes back.
+    if (timed_out && work_queue_.empty()) break;
+  }
+  num_idle_workers_--;
+  num_workers_--;
+  lock.Unlock();
+
+  CleanupCompletedThreads();
+}
+
+bool ThreadManager::SpinForWork(int* spin_limit) {
+  for (int i = 0; i < *spin_limit; i++) {
+    if (num_queued_.load(std::memory_order_relaxed) > 0) {
+      *spin_limit = std::min(*spin_limit * 2, max_spin_);
+      return true;
+    }
+  }
+  // Spinning did not pay off this time: spin less next time, but keep
+  // spinning a little so that the limit can grow again.
+  *spin_limit = std::max(*spin_limit / 2, std::min(kMinSpin, max_spin_));
+  return false;
+}
+
 }  // namespace grpc
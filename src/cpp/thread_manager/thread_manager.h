@@ -19,23 +19,46 @@
 #ifndef GRPC_INTERNAL_CPP_THREAD_MANAGER_H
 #define GRPC_INTERNAL_CPP_THREAD_MANAGER_H
 
+#include <atomic>
+#include <deque>
 #include <list>
 #include <memory>
 
 #include <grpcpp/support/config.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/resource_quota.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_STRING(grpc_sync_server_strategy);
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_sync_server_max_workers);
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_sync_server_worker_idle_ms);
+
 namespace grpc {
 
+// A ThreadManager runs one of two strategies, picked at construction from the
+// GRPC_SYNC_SERVER_STRATEGY global config:
+//  - "legacy" (default): every thread polls, does the work it found itself and
+//    then polls again. Threads are created and retired to keep the number of
+//    pollers between min_pollers and max_pollers.
+//  - "pooled": min_pollers threads (at least one) only poll, and hand batches
+//    of work to a pool of worker threads. Workers are created when the idle
+//    ones cannot absorb a batch, up to GRPC_SYNC_SERVER_MAX_WORKERS and as far
+//    as the resource quota allows, and exit after waiting
+//    GRPC_SYNC_SERVER_WORKER_IDLE_MS for work. Idle workers spin briefly
+//    before sleeping, adapting the spin length to how often spinning found
+//    work.
 class ThreadManager {
  public:
   explicit ThreadManager(const char* name, grpc_resource_quota* resource_quota,
                          int min_pollers, int max_pollers);
   virtual ~ThreadManager();
 
+  // Pins every thread this manager creates to core \a cpu (modulo the number
+  // of cores). Must be called before Initialize(). Only effective on Linux.
+  void SetCpuAffinity(int cpu) { cpu_affinity_ = cpu; }
+
   // Initializes and Starts the Rpc Manager threads
   void Initialize();
 
@@ -64,6 +87,14 @@ class ThreadManager {
   //    implementation
   virtual WorkStatus PollForWork(void** tag, bool* ok) = 0;
 
+  // Like PollForWork(), but may return several work items at once: on
+  // WORK_FOUND, the first *num_items (at most max_items) entries of tags and
+  // oks describe the items found, each of which is passed to DoWork(). Only
+  // called by the "pooled" strategy. The default implementation calls
+  // PollForWork() once.
+  virtual WorkStatus PollForWorkBatch(void** tags, bool* oks, size_t max_items,
+                                      size_t* num_items);
+
   // The implementation of DoWork() is supposed to perform the work found by
   // PollForWork(). The tag and ok parameters are the same as returned by
   // PollForWork(). The resources parameter indicates that the call actually
@@ -92,6 +123,10 @@ class ThreadManager {
   // to check if resource_quota is properly being enforced.
   int GetMaxActiveThreadsSoFar();
 
+  // Number of threads currently active in this thread manager, pollers
+  // included. Also for debugging purposes and unit tests.
+  int GetNumActiveThreads();
+
  private:
   // Helper wrapper class around grpc_core::Thread. Takes a ThreadManager object
   // and starts a new grpc_core::Thread to calls the Run() function.
@@ -119,18 +154,20 @@ class ThreadManager {
   // not be called (and the need for this WorkerThread class is eliminated)
   class WorkerThread {
    public:
-    explicit WorkerThread(ThreadManager* thd_mgr);
+    // Runs \a work_loop, one of the *Loop() methods of \a thd_mgr
+    WorkerThread(ThreadManager* thd_mgr, void (ThreadManager::*work_loop)());
     ~WorkerThread();
 
     bool created() const { return created_; }
     void Start() { thd_.Start(); }
 
    private:
-    // Calls thd_mgr_->MainWorkLoop() and once that completes, calls
+    // Calls the work loop and once that completes, calls
     // thd_mgr_>MarkAsCompleted(this) to mark the thread as completed
     void Run();
 
     ThreadManager* const thd_mgr_;
+    void (ThreadManager::*const work_loop_)();
     grpc_core::Thread thd_;
     bool created_;
   };
@@ -138,6 +175,16 @@ class ThreadManager {
   // The main function in ThreadManager
   void MainWorkLoop();
 
+  // The "pooled" strategy counterparts of Initialize() and MainWorkLoop()
+  void InitializePooled();
+  void PollerLoop();
+  void PooledWorkerLoop();
+  // Queues work found by a poller and makes sure that workers pick it up
+  void DispatchWork(void** tags, bool* oks, size_t num_items);
+  // Busy-waits for up to *spin_limit iterations for work to be queued, then
+  // adapts *spin_limit to the outcome. Returns true if work was seen.
+  bool SpinForWork(int* spin_limit);
+
   void MarkAsCompleted(WorkerThread* thd);
   void CleanupCompletedThreads();
 
@@ -172,6 +219,38 @@ class ThreadManager {
   // ever set so far
   int max_active_threads_sofar_;
 
+  // The core to pin threads to, or -1 to leave them unpinned
+  int cpu_affinity_ = -1;
+
+  // True if this manager runs the "pooled" strategy
+  const bool pooled_;
+
+  // The remaining fields are only used by the "pooled" strategy. There,
+  // num_pollers_ counts the poller threads still running.
+  struct WorkItem {
+    void* tag;
+    bool ok;
+  };
+  // Work found by the pollers and not picked up yet, protected by mu_
+  std::deque<WorkItem> work_queue_;
+  // Mirrors work_queue_.size(), so that spinning workers can watch for work
+  // without taking mu_
+  std::atomic<size_t> num_queued_{0};
+  // Bound on num_workers_, and how long a worker waits for work before
+  // exiting
+  const int max_workers_;
+  const int worker_idle_ms_;
+  // Worker threads alive, and those not running DoWork(), protected by mu_
+  int num_workers_ = 0;
+  int num_idle_workers_ = 0;
+  // Workers blocked on work_cv_, and how many of them have been signalled
+  // but not woken up yet, protected by mu_
+  int num_sleeping_workers_ = 0;
+  int num_signalled_workers_ = 0;
+  grpc_core::CondVar work_cv_;
+  // Upper bound for spinning, 0 on single-core machines
+  int max_spin_;
+
   grpc_core::Mutex list_mu_;
   std::list<WorkerThread*> completed_threads_;
 };
@@ -29,6 +29,7 @@
 #include "src/core/lib/channel/channelz_registry.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/work_serializer.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/server.h"
@@ -553,6 +554,41 @@ TEST_F(ChannelzRegistryBasedTest, ManyServersTest) {
   ValidateGetServers(10);
 }
 
+TEST(ChannelzSerializerProfileTest, BasicSerializerProfile) {
+  grpc_core::ExecCtx exec_ctx;
+  WorkSerializer work_serializer;
+  const int run_line = __LINE__ + 1;
+  const DebugLocation run_location = DEBUG_LOCATION;
+  // Long enough a callback to rank among the costliest locations
+  work_serializer.Run(
+      []() { gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(100)); },
+      run_location);
+  char* json_str = grpc_channelz_get_serializer_profile();
+  grpc_error* error = GRPC_ERROR_NONE;
+  Json json = Json::Parse(json_str, &error);
+  gpr_free(json_str);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_string(error);
+  ASSERT_EQ(json.type(), Json::Type::OBJECT);
+#ifdef GRPC_SERIALIZER_PROFILING
+  // The callback run above must be attributed to its location.
+  auto it = json.object_value().find("location");
+  ASSERT_NE(it, json.object_value().end());
+  const std::string location =
+      std::string(__FILE__) + ":" + std::to_string(run_line);
+  bool found = false;
+  for (const Json& entry : it->second.array_value()) {
+    if (entry.object_value().at("location").string_value() == location) {
+      found = true;
+    }
+  }
+  EXPECT_TRUE(found) << location;
+  EXPECT_NE(json.object_value().find("serializer"), json.object_value().end());
+#else
+  (void)run_line;
+  EXPECT_TRUE(json.object_value().empty());
+#endif
+}
+
 INSTANTIATE_TEST_SUITE_P(ChannelzChannelTestSweep, ChannelzChannelTest,
                          ::testing::Values(0, 8, 64, 1024, 1024 * 1024));
 
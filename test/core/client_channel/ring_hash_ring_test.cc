@@ -0,0 +1,151 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/lib/gpr/murmur_hash.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+constexpr size_t kMinRingSize = 1024;
+constexpr size_t kMaxRingSize = 8 * 1024 * 1024;
+constexpr int kNumRequests = 10000;
+
+std::vector<std::string> MakeKeys(int first, int last) {
+  std::vector<std::string> keys;
+  for (int i = first; i <= last; ++i) {
+    keys.push_back(absl::StrCat("10.0.0.", i, ":443"));
+  }
+  return keys;
+}
+
+RefCountedPtr<RingHashRing> MakeRing(std::vector<std::string> keys,
+                                     const RingHashRing* previous) {
+  return MakeRefCounted<RingHashRing>(std::move(keys), kMinRingSize,
+                                      kMaxRingSize, previous);
+}
+
+// Returns the key of the address owning the hash of request \a i
+const std::string& Owner(const RingHashRing& ring, int i) {
+  uint32_t hash = gpr_murmur_hash3(&i, sizeof(i), 0);
+  return ring.keys()[ring.entry(ring.Find(hash)).index];
+}
+
+void ExpectSameRing(const RingHashRing& a, const RingHashRing& b) {
+  EXPECT_EQ(a.keys(), b.keys());
+  EXPECT_EQ(a.points_per_address(), b.points_per_address());
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    EXPECT_EQ(a.entry(i).hash, b.entry(i).hash) << "at " << i;
+    EXPECT_EQ(a.entry(i).index, b.entry(i).index) << "at " << i;
+  }
+}
+
+TEST(RingHashRingTest, SpreadsPointsOverAddresses) {
+  auto ring = MakeRing(MakeKeys(1, 10), nullptr);
+  EXPECT_EQ(ring->points_per_address(), 103u);
+  EXPECT_EQ(ring->size(), 1030u);
+  std::vector<size_t> points(10, 0);
+  for (size_t i = 0; i < ring->size(); ++i) {
+    if (i > 0) {
+      EXPECT_LE(ring->entry(i - 1).hash, ring->entry(i).hash);
+    }
+    ++points[ring->entry(i).index];
+  }
+  for (size_t n : points) EXPECT_EQ(n, 103u);
+}
+
+TEST(RingHashRingTest, IncrementalRebuildMatchesFullRebuild) {
+  // 8 addresses before and after, so that both rings have 128 points per
+  // address
+  auto previous = MakeRing(MakeKeys(1, 8), nullptr);
+  std::vector<std::string> keys = MakeKeys(3, 10);
+  // The addresses kept change index too.
+  std::reverse(keys.begin(), keys.end());
+  auto incremental = MakeRing(keys, previous.get());
+  auto full = MakeRing(keys, nullptr);
+  ExpectSameRing(*incremental, *full);
+}
+
+TEST(RingHashRingTest, KeepsPointsPerAddressWithinBounds) {
+  auto previous = MakeRing(MakeKeys(1, 8), nullptr);
+  // 9 * 128 points are still within bounds.
+  auto grown = MakeRing(MakeKeys(1, 9), previous.get());
+  EXPECT_EQ(grown->points_per_address(), 128u);
+  EXPECT_EQ(grown->size(), 9 * 128u);
+  // 7 * 128 points are not.
+  auto shrunk = MakeRing(MakeKeys(1, 7), previous.get());
+  ExpectSameRing(*shrunk, *MakeRing(MakeKeys(1, 7), nullptr));
+}
+
+TEST(RingHashRingTest, AddingAddressMovesAboutOneNthOfKeys) {
+  auto previous = MakeRing(MakeKeys(1, 10), nullptr);
+  auto ring = MakeRing(MakeKeys(1, 11), previous.get());
+  const std::string new_key = ring->keys().back();
+  int moved = 0;
+  for (int i = 0; i < kNumRequests; ++i) {
+    const std::string& owner = Owner(*ring, i);
+    if (owner != Owner(*previous, i)) {
+      // Keys only move to the new address.
+      EXPECT_EQ(owner, new_key);
+      ++moved;
+    }
+  }
+  EXPECT_GT(moved, kNumRequests / 11 / 2);
+  EXPECT_LT(moved, kNumRequests / 11 * 3 / 2);
+}
+
+TEST(RingHashRingTest, RemovingAddressMovesOnlyItsKeys) {
+  // Grown from 10 addresses, so that 10 addresses fit its 103 points per
+  // address
+  auto previous =
+      MakeRing(MakeKeys(1, 11), MakeRing(MakeKeys(1, 10), nullptr).get());
+  auto ring = MakeRing(MakeKeys(1, 10), previous.get());
+  EXPECT_EQ(ring->points_per_address(), 103u);
+  const std::string removed_key = previous->keys().back();
+  int moved = 0;
+  for (int i = 0; i < kNumRequests; ++i) {
+    const std::string& previous_owner = Owner(*previous, i);
+    if (previous_owner == removed_key) {
+      ++moved;
+    } else {
+      EXPECT_EQ(Owner(*ring, i), previous_owner);
+    }
+  }
+  EXPECT_GT(moved, kNumRequests / 11 / 2);
+  EXPECT_LT(moved, kNumRequests / 11 * 3 / 2);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
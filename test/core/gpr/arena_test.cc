@@ -115,6 +115,24 @@ static void concurrent_test(void) {
   args.arena->Destroy();
 }
 
+// Arenas of the same size reuse each other's memory once destroyed; make sure
+// a recycled block is fully usable and can be released.
+static void recycle_test(void) {
+  gpr_log(GPR_DEBUG, "recycle_test");
+
+  for (size_t init_size = 1; init_size <= 128 * 1024; init_size *= 2) {
+    for (int i = 0; i < 3; i++) {
+      Arena* a = Arena::Create(init_size);
+      memset(a->Alloc(init_size), i, init_size);
+      // Force an additional zone, which is recycled as well.
+      memset(a->Alloc(2 * init_size), i, 2 * init_size);
+      a->Destroy();
+    }
+  }
+  Arena::ReleaseCachedBlocks();
+  Arena::Create(1024)->Destroy();
+}
+
 int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(argc, argv);
 
@@ -126,6 +144,7 @@ int main(int argc, char* argv[]) {
   TEST(1_inc, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11);
   TEST(6_123, 6, 1, 2, 3);
   concurrent_test();
+  recycle_test();
 
   return 0;
 }
@@ -0,0 +1,220 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "src/core/lib/iomgr/port.h"
+
+/* This test only relevant on linux systems where epoll() is available */
+#if defined(GRPC_LINUX_EPOLL_CREATE1) && defined(GRPC_LINUX_EVENTFD)
+#include "src/core/lib/iomgr/ev_epoll1_linux.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gpr/env.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "test/core/util/test_config.h"
+
+/* The spin budget is long enough that a poller which misses a kick or an
+   event spins well past the checks below */
+#define BUSY_POLL_US 1000000
+#define BUSY_POLL_US_STR "1000000"
+/* How long the tests wait for the poller to start spinning */
+#define SPIN_START_MS 100
+
+static gpr_mu* g_mu;
+static grpc_pollset* g_pollset;
+
+static void destroy_pollset(void* p, grpc_error* /*error*/) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
+}
+
+static int64_t elapsed_us(gpr_timespec start) {
+  return gpr_time_to_millis(
+             gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start)) *
+         GPR_US_PER_MS;
+}
+
+static grpc_millis deadline_from_now(int64_t ms) {
+  grpc_core::ExecCtx::Get()->InvalidateNow();
+  return grpc_core::ExecCtx::Get()->Now() + ms;
+}
+
+static gpr_atm stats_counter(int counter) {
+  grpc_stats_data stats;
+  grpc_stats_collect(&stats);
+  return stats.counters[counter];
+}
+
+static void kick_pollset(void* /*arg*/) {
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(SPIN_START_MS));
+  grpc_core::ExecCtx exec_ctx;
+  gpr_mu_lock(g_mu);
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("pollset_kick",
+                               grpc_pollset_kick(g_pollset, nullptr)));
+  gpr_mu_unlock(g_mu);
+}
+
+/* A kick that arrives while the designated poller spins stops the spin
+   without going through the wakeup fd */
+static void test_kick_while_spinning() {
+  gpr_log(GPR_INFO, "test_kick_while_spinning");
+  grpc_core::ExecCtx exec_ctx;
+  gpr_atm kicks_spinning =
+      stats_counter(GRPC_STATS_COUNTER_POLLSET_KICK_SPINNING);
+  gpr_atm kicks_wakeup_fd =
+      stats_counter(GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_FD);
+  grpc_core::Thread kicker("grpc_kicker", kick_pollset, nullptr);
+  kicker.Start();
+  gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_mu_lock(g_mu);
+  grpc_pollset_worker* worker = nullptr;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "pollset_work",
+      grpc_pollset_work(g_pollset, &worker, deadline_from_now(5000))));
+  gpr_mu_unlock(g_mu);
+  int64_t spun_us = elapsed_us(start);
+  kicker.Join();
+  gpr_log(GPR_INFO, "kicked poller returned after %" PRId64 "us", spun_us);
+  GPR_ASSERT(spun_us < BUSY_POLL_US);
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  GPR_ASSERT(stats_counter(GRPC_STATS_COUNTER_POLLSET_KICK_SPINNING) ==
+             kicks_spinning + 1);
+  GPR_ASSERT(stats_counter(GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_FD) ==
+             kicks_wakeup_fd);
+#else
+  (void)kicks_spinning;
+  (void)kicks_wakeup_fd;
+#endif
+}
+
+/* A kick that arrives while nobody polls is not lost: the next poller returns
+   without spinning out its budget */
+static void test_kick_before_spinning() {
+  gpr_log(GPR_INFO, "test_kick_before_spinning");
+  grpc_core::ExecCtx exec_ctx;
+  gpr_mu_lock(g_mu);
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("pollset_kick",
+                               grpc_pollset_kick(g_pollset, nullptr)));
+  gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  grpc_pollset_worker* worker = nullptr;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "pollset_work",
+      grpc_pollset_work(g_pollset, &worker, deadline_from_now(5000))));
+  gpr_mu_unlock(g_mu);
+  GPR_ASSERT(elapsed_us(start) < BUSY_POLL_US);
+}
+
+static void write_eventfd(void* arg) {
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(SPIN_START_MS));
+  GPR_ASSERT(eventfd_write(*static_cast<int*>(arg), 1) == 0);
+}
+
+static void set_readable(void* arg, grpc_error* /*error*/) {
+  gpr_mu_lock(g_mu);
+  *static_cast<bool*>(arg) = true;
+  gpr_mu_unlock(g_mu);
+}
+
+/* An fd that becomes readable while the designated poller spins is picked up
+   by the spin */
+static void test_event_while_spinning() {
+  gpr_log(GPR_INFO, "test_event_while_spinning");
+  grpc_core::ExecCtx exec_ctx;
+  int ev_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  GPR_ASSERT(ev_fd >= 0);
+  grpc_fd* fd = grpc_fd_create(ev_fd, "epoll1-busy-poll-test", false);
+  grpc_pollset_add_fd(g_pollset, fd);
+  bool readable = false;
+  grpc_closure on_readable;
+  GRPC_CLOSURE_INIT(&on_readable, set_readable, &readable,
+                    grpc_schedule_on_exec_ctx);
+  grpc_fd_notify_on_read(fd, &on_readable);
+  grpc_core::ExecCtx::Get()->Flush();
+  grpc_core::Thread writer("grpc_writer", write_eventfd, &ev_fd);
+  writer.Start();
+  gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_mu_lock(g_mu);
+  while (!readable) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(g_pollset, &worker, deadline_from_now(5000))));
+    gpr_mu_unlock(g_mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+  GPR_ASSERT(elapsed_us(start) < BUSY_POLL_US);
+  writer.Join();
+  grpc_fd_orphan(fd, nullptr, nullptr, "epoll1-busy-poll-test");
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
+/* The spin never outlasts the deadline of the poll */
+static void test_spin_bounded_by_deadline() {
+  gpr_log(GPR_INFO, "test_spin_bounded_by_deadline");
+  grpc_core::ExecCtx exec_ctx;
+  gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_mu_lock(g_mu);
+  grpc_pollset_worker* worker = nullptr;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "pollset_work",
+      grpc_pollset_work(g_pollset, &worker, deadline_from_now(20))));
+  gpr_mu_unlock(g_mu);
+  GPR_ASSERT(elapsed_us(start) < BUSY_POLL_US / 2);
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  gpr_setenv("GRPC_EPOLL1_BUSY_POLL_US", BUSY_POLL_US_STR);
+  grpc_init();
+  {
+    grpc_core::ExecCtx exec_ctx;
+    const char* poll_strategy = grpc_get_poll_strategy_name();
+    if (poll_strategy != nullptr && strcmp(poll_strategy, "epoll1") == 0) {
+      g_pollset = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+      grpc_pollset_init(g_pollset, &g_mu);
+      test_kick_while_spinning();
+      test_kick_before_spinning();
+      test_event_while_spinning();
+      test_spin_bounded_by_deadline();
+      grpc_closure destroyed;
+      GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
+                        grpc_schedule_on_exec_ctx);
+      grpc_pollset_shutdown(g_pollset, &destroyed);
+      grpc_core::ExecCtx::Get()->Flush();
+      gpr_free(g_pollset);
+    } else {
+      gpr_log(GPR_INFO,
+              "Skipping the test. The test is only relevant for 'epoll1' "
+              "strategy. and the current strategy is: '%s'",
+              poll_strategy);
+    }
+  }
+  grpc_shutdown();
+  return 0;
+}
+#else /* defined(GRPC_LINUX_EPOLL_CREATE1) && defined(GRPC_LINUX_EVENTFD) */
+int main(int /*argc*/, char** /*argv*/) { return 0; }
+#endif
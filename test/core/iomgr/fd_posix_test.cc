@@ -41,6 +41,7 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/gpr/env.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/socket_utils_posix.h"
@@ -513,9 +514,8 @@ static void destroy_pollset(void* p, grpc_error* /*error*/) {
   grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
 }
 
-int main(int argc, char** argv) {
+static void run_tests(void) {
   grpc_closure destroyed;
-  grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
   {
     grpc_core::ExecCtx exec_ctx;
@@ -529,7 +529,16 @@ int main(int argc, char** argv) {
     grpc_core::ExecCtx::Get()->Flush();
     gpr_free(g_pollset);
   }
-  grpc_shutdown();
+  grpc_shutdown_blocking();
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  run_tests();
+  /* Again with the epoll1 poller spinning before it blocks; other pollers
+     ignore this */
+  gpr_setenv("GRPC_EPOLL1_BUSY_POLL_US", "1000");
+  run_tests();
   return 0;
 }
 
@@ -18,10 +18,16 @@
 
 #include "src/core/lib/iomgr/resource_quota.h"
 
+#include <string.h>
+
+#include <vector>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/read_buffer_pool.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "test/core/util/test_config.h"
 
@@ -174,6 +180,51 @@ static void test_simple_async_alloc(void) {
   destroy_user(usr);
 }
 
+static void test_concurrent_alloc_free(void) {
+  gpr_log(GPR_INFO, "** test_concurrent_alloc_free **");
+  grpc_resource_quota* q =
+      grpc_resource_quota_create("test_concurrent_alloc_free");
+  grpc_resource_quota_resize(q, 64 * 1024);
+  grpc_resource_user* usr1 = grpc_resource_user_create(q, "usr1");
+  grpc_resource_user* usr2 = grpc_resource_user_create(q, "usr2");
+  // Allocations and frees racing on the same user, through both the lock-free
+  // and the locked paths.
+  std::vector<grpc_core::Thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back(
+        "test_concurrent_alloc_free",
+        [](void* arg) {
+          grpc_resource_user* usr = static_cast<grpc_resource_user*>(arg);
+          grpc_core::ExecCtx exec_ctx;
+          for (int j = 0; j < 10000; j++) {
+            grpc_resource_user_alloc(usr, 1024, nullptr);
+            grpc_resource_user_free(usr, 1024);
+            grpc_core::ExecCtx::Get()->Flush();
+          }
+        },
+        usr1);
+  }
+  for (auto& th : threads) th.Start();
+  for (auto& th : threads) th.Join();
+  {
+    // Everything usr1 cached must be reclaimable: no byte may have been lost.
+    gpr_event ev;
+    gpr_event_init(&ev);
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(!grpc_resource_user_alloc(usr2, 64 * 1024, set_event(&ev)));
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(gpr_event_wait(&ev, grpc_timeout_seconds_to_deadline(5)) !=
+               nullptr);
+  }
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_resource_user_free(usr2, 64 * 1024);
+  }
+  grpc_resource_quota_unref(q);
+  destroy_user(usr1);
+  destroy_user(usr2);
+}
+
 static void test_async_alloc_blocked_by_size(void) {
   gpr_log(GPR_INFO, "** test_async_alloc_blocked_by_size **");
   grpc_resource_quota* q =
@@ -751,6 +802,60 @@ static void test_one_slice_deleted_late(void) {
   }
 }
 
+static void test_pooled_slices(void) {
+  gpr_log(GPR_INFO, "** test_pooled_slices **");
+
+  const size_t slice_size = grpc_core::ReadBufferPool::RoundUp(10000);
+  GPR_ASSERT(grpc_core::ReadBufferPool::SizeClassFor(slice_size) >= 0);
+  GPR_ASSERT(grpc_core::ReadBufferPool::SizeClassFor(10000) < 0);
+  /* Large reads are not inflated by more than half */
+  GPR_ASSERT(grpc_core::ReadBufferPool::RoundUp(64 * 1024 + 1) <=
+             (64 * 1024 + 1) * 3 / 2);
+
+  grpc_resource_quota* q = grpc_resource_quota_create("test_pooled_slices");
+  grpc_resource_quota_resize(q, 4 * slice_size);
+
+  grpc_resource_user* usr = grpc_resource_user_create(q, "usr");
+
+  grpc_resource_user_slice_allocator alloc;
+  int num_allocs = 0;
+  grpc_resource_user_slice_allocator_init(&alloc, usr, inc_int_cb, &num_allocs);
+
+  grpc_slice_buffer buffer;
+  grpc_slice_buffer_init(&buffer);
+
+  /* The whole quota is used twice over: the second round of slices can only be
+     allocated if the first one returned its memory to the quota when its
+     buffers went back to the pool */
+  for (int round = 0; round < 2; round++) {
+    {
+      const int start_allocs = num_allocs;
+      grpc_core::ExecCtx exec_ctx;
+      if (!grpc_resource_user_alloc_slices(&alloc, slice_size, 4, &buffer)) {
+        grpc_core::ExecCtx::Get()->Flush();
+        assert_counter_becomes(&num_allocs, start_allocs + 1);
+      }
+    }
+    GPR_ASSERT(buffer.count == 4);
+    for (size_t i = 0; i < buffer.count; i++) {
+      GPR_ASSERT(GRPC_SLICE_LENGTH(buffer.slices[i]) == slice_size);
+      memset(GRPC_SLICE_START_PTR(buffer.slices[i]), static_cast<int>(i),
+             slice_size);
+    }
+    {
+      grpc_core::ExecCtx exec_ctx;
+      grpc_slice_buffer_reset_and_unref_internal(&buffer);
+    }
+  }
+
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_slice_buffer_destroy_internal(&buffer);
+  }
+  destroy_user(usr);
+  grpc_resource_quota_unref(q);
+}
+
 static void test_resize_to_zero(void) {
   gpr_log(GPR_INFO, "** test_resize_to_zero **");
   grpc_resource_quota* q = grpc_resource_quota_create("test_resize_to_zero");
@@ -902,6 +1007,7 @@ int main(int argc, char** argv) {
   test_instant_alloc_then_free();
   test_instant_alloc_free_pair();
   test_simple_async_alloc();
+  test_concurrent_alloc_free();
   test_async_alloc_blocked_by_size();
   test_scavenge();
   test_scavenge_blocked();
@@ -916,6 +1022,7 @@ int main(int argc, char** argv) {
   test_reclaimers_can_be_posted_repeatedly();
   test_one_slice();
   test_one_slice_deleted_late();
+  test_pooled_slices();
   test_resize_to_zero();
   test_negative_rq_free_pool();
   gpr_mu_destroy(&g_mu);
@@ -35,6 +35,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/ev_posix.h"
@@ -300,6 +301,148 @@ static void large_read_test(size_t slice_size) {
   grpc_endpoint_destroy(ep);
 }
 
+/* Write to a TCP socket until it fills up, then read from it using the grpc_tcp
+   API with receive zerocopy enabled. Whether the pages end up mapped or copied
+   depends on the kernel and on the alignment of the received data, so this
+   only checks that the bytes read are the bytes written. */
+static void rx_zerocopy_read_test(size_t threshold) {
+  int sv[2];
+  grpc_endpoint* ep;
+  struct read_socket_state state;
+  ssize_t written_bytes;
+  grpc_millis deadline =
+      grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "Start rx zerocopy read test, threshold %" PRIuPTR,
+          threshold);
+
+  create_inet_sockets(sv);
+
+  grpc_arg a[2];
+  a[0].key = const_cast<char*>(GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED);
+  a[0].type = GRPC_ARG_INTEGER;
+  a[0].value.integer = 1;
+  a[1].key = const_cast<char*>(GRPC_ARG_TCP_RX_ZEROCOPY_RECV_BYTES_THRESHOLD);
+  a[1].type = GRPC_ARG_INTEGER;
+  a[1].value.integer = static_cast<int>(threshold);
+  grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
+  ep = grpc_tcp_create(grpc_fd_create(sv[1], "rx_zerocopy_read_test", false),
+                       &args, "test");
+  grpc_endpoint_add_to_pollset(ep, g_pollset);
+
+  written_bytes = fill_socket(sv[0]);
+  gpr_log(GPR_INFO, "Wrote %" PRIuPTR " bytes", written_bytes);
+
+  state.ep = ep;
+  state.read_bytes = 0;
+  state.target_read_bytes = static_cast<size_t>(written_bytes);
+  grpc_slice_buffer_init(&state.incoming);
+  GRPC_CLOSURE_INIT(&state.read_cb, read_cb, &state, grpc_schedule_on_exec_ctx);
+
+  grpc_endpoint_read(ep, &state.incoming, &state.read_cb, /*urgent=*/false);
+
+  gpr_mu_lock(g_mu);
+  while (state.read_bytes < state.target_read_bytes) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+
+    gpr_mu_lock(g_mu);
+  }
+  GPR_ASSERT(state.read_bytes == state.target_read_bytes);
+  gpr_mu_unlock(g_mu);
+
+  grpc_slice_buffer_destroy_internal(&state.incoming);
+  grpc_endpoint_destroy(ep);
+  close(sv[0]);
+}
+
+/* Write to a socket, pause, then write again, reading everything using the
+   grpc_tcp API with idle mode enabled. While the socket is quiet, the endpoint
+   is expected to release its read buffers, and allocate new ones once the rest
+   of the data arrives. */
+static void idle_read_test(int release_ms) {
+  int sv[2];
+  grpc_endpoint* ep;
+  struct read_socket_state state;
+  grpc_millis deadline =
+      grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "Start idle read test, release after %d ms", release_ms);
+
+  create_sockets(sv);
+
+  grpc_arg a[1];
+  a[0].key = const_cast<char*>(GRPC_ARG_IDLE_READ_BUFFER_RELEASE_MS);
+  a[0].type = GRPC_ARG_INTEGER;
+  a[0].value.integer = release_ms;
+  grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
+  ep = grpc_tcp_create(grpc_fd_create(sv[1], "idle_read_test", false), &args,
+                       "test");
+  grpc_endpoint_add_to_pollset(ep, g_pollset);
+
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data before;
+  grpc_stats_collect(&before);
+#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+
+  /* Write a multiple of 256 bytes at a time, so that the bytes of both writes
+     follow each other in the pattern checked by read_cb(). */
+  GPR_ASSERT(fill_socket_partial(sv[0], 256) == 256);
+
+  state.ep = ep;
+  state.read_bytes = 0;
+  state.target_read_bytes = 512;
+  grpc_slice_buffer_init(&state.incoming);
+  GRPC_CLOSURE_INIT(&state.read_cb, read_cb, &state, grpc_schedule_on_exec_ctx);
+
+  grpc_endpoint_read(ep, &state.incoming, &state.read_cb, /*urgent=*/false);
+
+  gpr_mu_lock(g_mu);
+  while (state.read_bytes < 256) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+
+  /* Let the endpoint wait for more data long enough to go idle. */
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(release_ms + 100));
+  GPR_ASSERT(fill_socket_partial(sv[0], 256) == 256);
+
+  gpr_mu_lock(g_mu);
+  while (state.read_bytes < state.target_read_bytes) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+
+    gpr_mu_lock(g_mu);
+  }
+  GPR_ASSERT(state.read_bytes == state.target_read_bytes);
+  gpr_mu_unlock(g_mu);
+
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data after;
+  grpc_stats_collect(&after);
+  GPR_ASSERT(
+      after.counters[GRPC_STATS_COUNTER_TCP_IDLE_READ_BUFFERS_RELEASED] >
+      before.counters[GRPC_STATS_COUNTER_TCP_IDLE_READ_BUFFERS_RELEASED]);
+  GPR_ASSERT(
+      after.counters[GRPC_STATS_COUNTER_TCP_IDLE_READ_BUFFERS_REALLOCATED] >
+      before.counters[GRPC_STATS_COUNTER_TCP_IDLE_READ_BUFFERS_REALLOCATED]);
+#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+
+  grpc_slice_buffer_destroy_internal(&state.incoming);
+  grpc_endpoint_destroy(ep);
+}
+
 struct write_socket_state {
   grpc_endpoint* ep;
   int write_done;
@@ -567,6 +710,10 @@ void run_tests(void) {
   read_test(10000, 1);
   large_read_test(8192);
   large_read_test(1);
+  rx_zerocopy_read_test(0);
+  rx_zerocopy_read_test(64 * 1024);
+  idle_read_test(0);
+  idle_read_test(100);
 
   write_test(100, 8192, false);
   write_test(100, 1, false);
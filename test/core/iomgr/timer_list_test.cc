@@ -37,6 +37,9 @@
 extern grpc_core::TraceFlag grpc_timer_trace;
 extern grpc_core::TraceFlag grpc_timer_check_trace;
 
+extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_timer_wheel_vtable;
+
 static int cb_called[MAX_CB][2];
 static const int64_t kMillisIn25Days = 2160000000;
 static const int64_t kHoursIn25Days = 600;
@@ -218,13 +221,14 @@ void long_running_service_cleanup_test(void) {
   GPR_ASSERT(1 == cb_called[3][0]);
 }
 
-int main(int argc, char** argv) {
+static void run_tests(int argc, char** argv, grpc_timer_vtable* timer_impl) {
   /* Tests with default g_start_time */
   {
     grpc::testing::TestEnvironment env(argc, argv);
     grpc_core::ExecCtx::GlobalInit();
     grpc_core::ExecCtx exec_ctx;
     grpc_determine_iomgr_platform();
+    grpc_set_timer_impl(timer_impl);
     grpc_iomgr_platform_init();
     gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
     add_test();
@@ -246,6 +250,7 @@ int main(int argc, char** argv) {
     grpc_core::ExecCtx::TestOnlyGlobalInit(new_start);
     grpc_core::ExecCtx exec_ctx;
     grpc_determine_iomgr_platform();
+    grpc_set_timer_impl(timer_impl);
     grpc_iomgr_platform_init();
     gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
     long_running_service_cleanup_test();
@@ -254,7 +259,11 @@ int main(int argc, char** argv) {
     grpc_iomgr_platform_shutdown();
   }
   grpc_core::ExecCtx::GlobalShutdown();
+}
 
+int main(int argc, char** argv) {
+  run_tests(argc, argv, &grpc_generic_timer_vtable);
+  run_tests(argc, argv, &grpc_timer_wheel_vtable);
   return 0;
 }
 
@@ -0,0 +1,290 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/iomgr/executor/work_stealing_threadpool.h"
+
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/atomic.h"
+#include "test/core/util/test_config.h"
+
+static const int kSmallThreadPoolSize = 4;
+static const int kLargeThreadPoolSize = 16;
+static const int kThreadSmallIter = 100;
+static const int kThreadLargeIter = 10000;
+// More than a worker's deque holds, so that some of the fan-out overflows to
+// the injection queue.
+static const int kFanOut = 1000;
+
+static void test_size_zero(void) {
+  gpr_log(GPR_INFO, "test_size_zero");
+  grpc_core::WorkStealingThreadPool* pool_size_zero =
+      new grpc_core::WorkStealingThreadPool(0);
+  GPR_ASSERT(pool_size_zero->pool_capacity() == 1);
+  delete pool_size_zero;
+}
+
+static void test_constructor_option(void) {
+  gpr_log(GPR_INFO, "test_constructor_option");
+  grpc_core::Thread::Options options;
+  options.set_stack_size(192 * 1024);  // Random non-default value
+  grpc_core::WorkStealingThreadPool* pool =
+      new grpc_core::WorkStealingThreadPool(2, "test_constructor_option",
+                                            options, /*pin_threads=*/true);
+  GPR_ASSERT(pool->thread_options().stack_size() == options.stack_size());
+  GPR_ASSERT(strcmp(pool->thread_name(), "test_constructor_option") == 0);
+  delete pool;
+}
+
+// Counts how many times it has been run.
+class SimpleFunctorForAdd : public grpc_experimental_completion_queue_functor {
+ public:
+  SimpleFunctorForAdd() {
+    functor_run = &SimpleFunctorForAdd::Run;
+    inlineable = true;
+    internal_next = this;
+    internal_success = 0;
+  }
+  static void Run(struct grpc_experimental_completion_queue_functor* cb,
+                  int /*ok*/) {
+    auto* callback = static_cast<SimpleFunctorForAdd*>(cb);
+    callback->count_.FetchAdd(1, grpc_core::MemoryOrder::RELAXED);
+  }
+
+  int count() { return count_.Load(grpc_core::MemoryOrder::RELAXED); }
+
+ private:
+  grpc_core::Atomic<int> count_{0};
+};
+
+static void test_add(void) {
+  gpr_log(GPR_INFO, "test_add");
+  grpc_core::WorkStealingThreadPool* pool =
+      new grpc_core::WorkStealingThreadPool(kSmallThreadPoolSize, "test_add");
+  SimpleFunctorForAdd* functor = new SimpleFunctorForAdd();
+  for (int i = 0; i < kThreadSmallIter; ++i) {
+    pool->Add(functor);
+  }
+  // Destructor of the pool waits for all closures to finish.
+  delete pool;
+  GPR_ASSERT(functor->count() == kThreadSmallIter);
+  delete functor;
+}
+
+// Thread that adds closures to pool
+class WorkThread {
+ public:
+  WorkThread(grpc_core::WorkStealingThreadPool* pool, SimpleFunctorForAdd* cb,
+             int num_add)
+      : num_add_(num_add), cb_(cb), pool_(pool) {
+    thd_ = grpc_core::Thread(
+        "work_stealing_threadpool_test_add_thd",
+        [](void* th) { static_cast<WorkThread*>(th)->Run(); }, this);
+  }
+
+  void Start() { thd_.Start(); }
+  void Join() { thd_.Join(); }
+
+ private:
+  void Run() {
+    for (int i = 0; i < num_add_; ++i) {
+      pool_->Add(cb_);
+    }
+  }
+
+  int num_add_;
+  SimpleFunctorForAdd* cb_;
+  grpc_core::WorkStealingThreadPool* pool_;
+  grpc_core::Thread thd_;
+};
+
+static void test_multi_add(void) {
+  gpr_log(GPR_INFO, "test_multi_add");
+  const int num_work_thds = 10;
+  grpc_core::WorkStealingThreadPool* pool =
+      new grpc_core::WorkStealingThreadPool(kLargeThreadPoolSize,
+                                            "test_multi_add");
+  SimpleFunctorForAdd* functor = new SimpleFunctorForAdd();
+  WorkThread** work_thds = static_cast<WorkThread**>(
+      gpr_zalloc(sizeof(WorkThread*) * num_work_thds));
+  for (int i = 0; i < num_work_thds; ++i) {
+    work_thds[i] = new WorkThread(pool, functor, kThreadLargeIter);
+    work_thds[i]->Start();
+  }
+  for (int i = 0; i < num_work_thds; ++i) {
+    work_thds[i]->Join();
+    delete work_thds[i];
+  }
+  gpr_free(work_thds);
+  delete pool;
+  GPR_ASSERT(functor->count() == kThreadLargeIter * num_work_thds);
+  delete functor;
+}
+
+// Checks the current count with a given number.
+class SimpleFunctorCheckForAdd
+    : public grpc_experimental_completion_queue_functor {
+ public:
+  SimpleFunctorCheckForAdd(int ok, int* count) : count_(count) {
+    functor_run = &SimpleFunctorCheckForAdd::Run;
+    inlineable = true;
+    internal_success = ok;
+  }
+  static void Run(struct grpc_experimental_completion_queue_functor* cb,
+                  int /*ok*/) {
+    auto* callback = static_cast<SimpleFunctorCheckForAdd*>(cb);
+    (*callback->count_)++;
+    GPR_ASSERT(*callback->count_ == callback->internal_success);
+  }
+
+ private:
+  int* count_;
+};
+
+// Work added from outside the pool goes through the injection queue, so a
+// single worker runs it in order.
+static void test_one_thread_FIFO(void) {
+  gpr_log(GPR_INFO, "test_one_thread_FIFO");
+  int counter = 0;
+  grpc_core::WorkStealingThreadPool* pool =
+      new grpc_core::WorkStealingThreadPool(1, "test_one_thread_FIFO");
+  SimpleFunctorCheckForAdd** check_functors =
+      static_cast<SimpleFunctorCheckForAdd**>(
+          gpr_zalloc(sizeof(SimpleFunctorCheckForAdd*) * kThreadSmallIter));
+  for (int i = 0; i < kThreadSmallIter; ++i) {
+    check_functors[i] = new SimpleFunctorCheckForAdd(i + 1, &counter);
+    pool->Add(check_functors[i]);
+  }
+  delete pool;
+  for (int i = 0; i < kThreadSmallIter; ++i) {
+    delete check_functors[i];
+  }
+  gpr_free(check_functors);
+}
+
+struct FanOutState {
+  grpc_core::WorkStealingThreadPool* pool;
+  grpc_closure root;
+  grpc_closure children[kFanOut];
+  grpc_core::Atomic<int> count{0};
+  grpc_core::Atomic<int> errors{0};
+};
+
+static void child_cb(void* arg, grpc_error* error) {
+  FanOutState* state = static_cast<FanOutState*>(arg);
+  if (error != GRPC_ERROR_NONE) {
+    state->errors.FetchAdd(1, grpc_core::MemoryOrder::RELAXED);
+  }
+  state->count.FetchAdd(1, grpc_core::MemoryOrder::RELAXED);
+}
+
+static void root_cb(void* arg, grpc_error* /*error*/) {
+  FanOutState* state = static_cast<FanOutState*>(arg);
+  // Scheduled from a worker: lands in its LIFO slot and deque, where the other
+  // workers have to steal it from.
+  for (int i = 0; i < kFanOut; ++i) {
+    GRPC_CLOSURE_INIT(&state->children[i], child_cb, state, nullptr);
+    state->pool->Run(&state->children[i],
+                     i % 2 == 0 ? GRPC_ERROR_NONE
+                                : GRPC_ERROR_CREATE_FROM_STATIC_STRING("test"));
+  }
+}
+
+static void test_fan_out_from_worker(void) {
+  gpr_log(GPR_INFO, "test_fan_out_from_worker");
+  FanOutState* state = new FanOutState();
+  state->pool = new grpc_core::WorkStealingThreadPool(kSmallThreadPoolSize,
+                                                      "test_fan_out");
+  GRPC_CLOSURE_INIT(&state->root, root_cb, state, nullptr);
+  state->pool->Run(&state->root, GRPC_ERROR_NONE);
+  delete state->pool;
+  GPR_ASSERT(state->count.Load(grpc_core::MemoryOrder::RELAXED) == kFanOut);
+  GPR_ASSERT(state->errors.Load(grpc_core::MemoryOrder::RELAXED) ==
+             kFanOut / 2);
+  delete state;
+}
+
+// How many times the two closures of test_lifo_budget() reschedule each other.
+static const int kPingPongs = 100;
+
+struct PingPongState {
+  grpc_core::WorkStealingThreadPool* pool;
+  grpc_closure root;
+  grpc_closure waiting;
+  grpc_closure ping;
+  grpc_closure pong;
+  // Only ever touched by the single worker.
+  int ping_pongs = 0;
+  int ping_pongs_before_waiting = -1;
+};
+
+static void waiting_cb(void* arg, grpc_error* /*error*/) {
+  PingPongState* state = static_cast<PingPongState*>(arg);
+  state->ping_pongs_before_waiting = state->ping_pongs;
+}
+
+static void ping_pong_cb(void* arg, grpc_error* /*error*/) {
+  PingPongState* state = static_cast<PingPongState*>(arg);
+  if (++state->ping_pongs == kPingPongs) return;
+  state->pool->Run(
+      state->ping_pongs % 2 == 0 ? &state->ping : &state->pong,
+      GRPC_ERROR_NONE);
+}
+
+static void ping_pong_root_cb(void* arg, grpc_error* /*error*/) {
+  PingPongState* state = static_cast<PingPongState*>(arg);
+  // The waiting closure goes to the LIFO slot, and is pushed out to the deque
+  // by the first ping.
+  state->pool->Run(&state->waiting, GRPC_ERROR_NONE);
+  state->pool->Run(&state->ping, GRPC_ERROR_NONE);
+}
+
+// Two closures that keep rescheduling each other through the LIFO slot do not
+// starve the rest of the worker's deque.
+static void test_lifo_budget(void) {
+  gpr_log(GPR_INFO, "test_lifo_budget");
+  PingPongState* state = new PingPongState();
+  state->pool = new grpc_core::WorkStealingThreadPool(1, "test_lifo_budget");
+  GRPC_CLOSURE_INIT(&state->root, ping_pong_root_cb, state, nullptr);
+  GRPC_CLOSURE_INIT(&state->waiting, waiting_cb, state, nullptr);
+  GRPC_CLOSURE_INIT(&state->ping, ping_pong_cb, state, nullptr);
+  GRPC_CLOSURE_INIT(&state->pong, ping_pong_cb, state, nullptr);
+  state->pool->Run(&state->root, GRPC_ERROR_NONE);
+  delete state->pool;
+  GPR_ASSERT(state->ping_pongs == kPingPongs);
+  GPR_ASSERT(state->ping_pongs_before_waiting >= 0);
+  GPR_ASSERT(state->ping_pongs_before_waiting < kPingPongs);
+  delete state;
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  test_size_zero();
+  test_constructor_option();
+  test_add();
+  test_multi_add();
+  test_one_thread_FIFO();
+  test_fan_out_from_worker();
+  test_lifo_budget();
+  grpc_shutdown();
+  return 0;
+}
@@ -24,6 +24,7 @@
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "test/core/util/test_config.h"
 
@@ -165,6 +166,176 @@ static void test_cq_end_op(void) {
   }
 }
 
+static void test_cq_next_batch(void) {
+  grpc_event events[8];
+  grpc_completion_queue* cc;
+  grpc_cq_completion completions[5];
+  void* tags[GPR_ARRAY_SIZE(completions)];
+  grpc_cq_polling_type polling_types[] = {
+      GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
+  grpc_completion_queue_attributes attr;
+  size_t num_events;
+
+  LOG_TEST("test_cq_next_batch");
+
+  attr.version = 1;
+  attr.cq_completion_type = GRPC_CQ_NEXT;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(polling_types); i++) {
+    grpc_core::ExecCtx exec_ctx;
+    attr.cq_polling_type = polling_types[i];
+    cc = grpc_completion_queue_create(
+        grpc_completion_queue_factory_lookup(&attr), &attr, nullptr);
+
+    num_events = grpc_completion_queue_next_batch(
+        cc, events, GPR_ARRAY_SIZE(events), gpr_inf_past(GPR_CLOCK_REALTIME),
+        nullptr);
+    GPR_ASSERT(num_events == 1);
+    GPR_ASSERT(events[0].type == GRPC_QUEUE_TIMEOUT);
+
+    for (size_t j = 0; j < GPR_ARRAY_SIZE(completions); j++) {
+      tags[j] = create_test_tag();
+      GPR_ASSERT(grpc_cq_begin_op(cc, tags[j]));
+      grpc_cq_end_op(cc, tags[j], GRPC_ERROR_NONE, do_nothing_end_completion,
+                     nullptr, &completions[j]);
+    }
+
+    /* Every queued event is returned exactly once, across as many calls as
+       it takes; there is no ordering guarantee between them. */
+    size_t num_seen = 0;
+    bool seen[GPR_ARRAY_SIZE(completions)] = {false};
+    while (num_seen < GPR_ARRAY_SIZE(completions)) {
+      num_events = grpc_completion_queue_next_batch(
+          cc, events, 2, gpr_inf_past(GPR_CLOCK_REALTIME), nullptr);
+      GPR_ASSERT(num_events >= 1 && num_events <= 2);
+      for (size_t j = 0; j < num_events; j++) {
+        GPR_ASSERT(events[j].type == GRPC_OP_COMPLETE);
+        GPR_ASSERT(events[j].success);
+        size_t k = 0;
+        while (k < GPR_ARRAY_SIZE(tags) && tags[k] != events[j].tag) k++;
+        GPR_ASSERT(k < GPR_ARRAY_SIZE(tags));
+        GPR_ASSERT(!seen[k]);
+        seen[k] = true;
+        num_seen++;
+      }
+    }
+
+    grpc_completion_queue_shutdown(cc);
+    num_events = grpc_completion_queue_next_batch(
+        cc, events, GPR_ARRAY_SIZE(events), gpr_inf_future(GPR_CLOCK_REALTIME),
+        nullptr);
+    GPR_ASSERT(num_events == 1);
+    GPR_ASSERT(events[0].type == GRPC_QUEUE_SHUTDOWN);
+    grpc_completion_queue_destroy(cc);
+  }
+}
+
+static void test_cq_next_fifo(void) {
+  grpc_event ev;
+  grpc_completion_queue* cc;
+  grpc_cq_completion completions[5];
+  void* tags[GPR_ARRAY_SIZE(completions)];
+  grpc_completion_queue_attributes attr = {};
+
+  LOG_TEST("test_cq_next_fifo");
+
+  /* Without cq_sharded, events come back in the order they completed in. */
+  attr.version = GRPC_CQ_VERSION_MINIMUM_FOR_SHARDING;
+  attr.cq_completion_type = GRPC_CQ_NEXT;
+  attr.cq_polling_type = GRPC_CQ_NON_POLLING;
+  grpc_core::ExecCtx exec_ctx;
+  cc = grpc_completion_queue_create(grpc_completion_queue_factory_lookup(&attr),
+                                    &attr, nullptr);
+
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(completions); i++) {
+    tags[i] = create_test_tag();
+    GPR_ASSERT(grpc_cq_begin_op(cc, tags[i]));
+    grpc_cq_end_op(cc, tags[i], GRPC_ERROR_NONE, do_nothing_end_completion,
+                   nullptr, &completions[i]);
+  }
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(completions); i++) {
+    ev = grpc_completion_queue_next(cc, gpr_inf_past(GPR_CLOCK_REALTIME),
+                                    nullptr);
+    GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+    GPR_ASSERT(ev.tag == tags[i]);
+  }
+
+  shutdown_and_destroy(cc);
+}
+
+static void test_cq_next_sharded(void) {
+  const size_t kNumThreads = 4;
+  const size_t kEventsPerThread = 100;
+  const size_t kNumEvents = kNumThreads * kEventsPerThread;
+  grpc_event ev;
+  grpc_completion_queue* cc;
+  grpc_cq_polling_type polling_types[] = {
+      GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
+  grpc_completion_queue_attributes attr = {};
+  struct thread_state {
+    grpc_completion_queue* cc;
+    grpc_cq_completion completions[kEventsPerThread];
+    void* tags[kEventsPerThread];
+  };
+  thread_state states[kNumThreads];
+
+  LOG_TEST("test_cq_next_sharded");
+
+  attr.version = GRPC_CQ_VERSION_MINIMUM_FOR_SHARDING;
+  attr.cq_completion_type = GRPC_CQ_NEXT;
+  attr.cq_sharded = 1;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(polling_types); i++) {
+    attr.cq_polling_type = polling_types[i];
+    cc = grpc_completion_queue_create(
+        grpc_completion_queue_factory_lookup(&attr), &attr, nullptr);
+
+    /* Producers complete their events from as many threads, and so CPUs. */
+    grpc_core::Thread threads[kNumThreads];
+    for (size_t j = 0; j < kNumThreads; j++) {
+      states[j].cc = cc;
+      for (size_t k = 0; k < kEventsPerThread; k++) {
+        states[j].tags[k] = create_test_tag();
+        GPR_ASSERT(grpc_cq_begin_op(cc, states[j].tags[k]));
+      }
+      threads[j] = grpc_core::Thread(
+          "grpc_cq_sharded_producer",
+          [](void* arg) {
+            thread_state* state = static_cast<thread_state*>(arg);
+            grpc_core::ExecCtx exec_ctx;
+            for (size_t k = 0; k < kEventsPerThread; k++) {
+              grpc_cq_end_op(state->cc, state->tags[k], GRPC_ERROR_NONE,
+                             do_nothing_end_completion, nullptr,
+                             &state->completions[k]);
+            }
+          },
+          &states[j]);
+      threads[j].Start();
+    }
+
+    /* Every event is returned exactly once, whatever the shard it went to. */
+    bool seen[kNumEvents] = {false};
+    for (size_t j = 0; j < kNumEvents; j++) {
+      ev = grpc_completion_queue_next(cc, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr);
+      GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+      GPR_ASSERT(ev.success);
+      size_t k = 0;
+      while (k < kNumEvents &&
+             states[k / kEventsPerThread].tags[k % kEventsPerThread] !=
+                 ev.tag) {
+        k++;
+      }
+      GPR_ASSERT(k < kNumEvents);
+      GPR_ASSERT(!seen[k]);
+      seen[k] = true;
+    }
+    for (size_t j = 0; j < kNumThreads; j++) {
+      threads[j].Join();
+    }
+
+    shutdown_and_destroy(cc);
+  }
+}
+
 static void test_cq_tls_cache_full(void) {
   grpc_event ev;
   grpc_completion_queue* cc;
@@ -495,6 +666,9 @@ int main(int argc, char** argv) {
   test_shutdown_then_next_polling();
   test_shutdown_then_next_with_timeout();
   test_cq_end_op();
+  test_cq_next_batch();
+  test_cq_next_fifo();
+  test_cq_next_sharded();
   test_pluck();
   test_pluck_after_shutdown();
   test_cq_tls_cache_full();
@@ -0,0 +1,113 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/transport/bottleneck_estimator.h"
+
+#include <math.h>
+
+#include <gtest/gtest.h>
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+
+TEST(BottleneckEstimator, NoOp) {
+  BottleneckEstimator est;
+  EXPECT_FALSE(est.has_samples());
+  EXPECT_EQ(est.EstimateBdp(), 0);
+}
+
+TEST(BottleneckEstimator, IgnoresEmptyRounds) {
+  BottleneckEstimator est;
+  est.AddSample(1000, 0, 0);
+  EXPECT_FALSE(est.has_samples());
+}
+
+// 10 Gbps over a 100ms round trip
+static const double kBandwidth = 1.25e9;
+static const double kRtt = 0.1;
+
+TEST(BottleneckEstimator, ModelsPath) {
+  BottleneckEstimator est;
+  est.AddSample(static_cast<int64_t>(kBandwidth * kRtt), kRtt, 100);
+  EXPECT_TRUE(est.has_samples());
+  EXPECT_DOUBLE_EQ(est.max_bandwidth(), kBandwidth);
+  EXPECT_DOUBLE_EQ(est.min_rtt(), kRtt);
+  EXPECT_DOUBLE_EQ(est.EstimateBdp(), kBandwidth * kRtt);
+}
+
+TEST(BottleneckEstimator, IgnoresQueueingAndLimitedRounds) {
+  BottleneckEstimator est;
+  est.AddSample(static_cast<int64_t>(kBandwidth * kRtt), kRtt, 100);
+  // A round limited by the application delivers less; one that saw queueing
+  // takes longer. Neither changes the model of the path.
+  est.AddSample(1000, kRtt, 200);
+  est.AddSample(static_cast<int64_t>(kBandwidth * kRtt), 2 * kRtt, 400);
+  EXPECT_DOUBLE_EQ(est.max_bandwidth(), kBandwidth);
+  EXPECT_DOUBLE_EQ(est.min_rtt(), kRtt);
+}
+
+TEST(BottleneckEstimator, BandwidthExpires) {
+  BottleneckEstimator est(
+      BottleneckEstimator::Args().set_bandwidth_window_rounds(3));
+  est.AddSample(static_cast<int64_t>(kBandwidth * kRtt), kRtt, 100);
+  for (int i = 0; i < 3; i++) {
+    est.AddSample(static_cast<int64_t>(kBandwidth * kRtt / 2), kRtt,
+                  200 + 100 * i);
+  }
+  EXPECT_DOUBLE_EQ(est.max_bandwidth(), kBandwidth / 2);
+}
+
+TEST(BottleneckEstimator, MinRttExpires) {
+  BottleneckEstimator est(BottleneckEstimator::Args().set_min_rtt_window(1000));
+  est.AddSample(1000, kRtt, 100);
+  est.AddSample(1000, 2 * kRtt, 1000);
+  EXPECT_DOUBLE_EQ(est.min_rtt(), kRtt);
+  est.AddSample(1000, 2 * kRtt, 1200);
+  EXPECT_DOUBLE_EQ(est.min_rtt(), 2 * kRtt);
+}
+
+// While the window limits delivery, each round delivers a window's worth of
+// bytes: targeting twice the estimated BDP must double the window every round
+// until the path's BDP is reached, and then hold it there.
+TEST(BottleneckEstimator, WindowConverges) {
+  BottleneckEstimator est;
+  const double bdp = kBandwidth * kRtt;
+  double window = 65536;
+  int rounds = 0;
+  while (window < bdp) {
+    est.AddSample(static_cast<int64_t>(window), kRtt, 100 * (rounds + 1));
+    window = 2 * est.EstimateBdp();
+    rounds++;
+  }
+  EXPECT_LE(rounds, static_cast<int>(ceil(log2(bdp / 65536))));
+  for (int i = 0; i < 20; i++) {
+    est.AddSample(static_cast<int64_t>(bdp), kRtt * (1 + (i % 3) * 0.1),
+                  100 * (rounds + i + 1));
+    EXPECT_DOUBLE_EQ(est.EstimateBdp(), bdp);
+  }
+}
+
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -135,6 +135,9 @@ int main(int argc, char** argv) {
   EXPECT_SLICE_EQ(
       "\x9d\x29\xad\x17\x18\x63\xc7\x8f\x0b\x97\xc8\xe9\xae\x82\xae\x43\xd3",
       HUFF("https://www.example.com"));
+  /* Codes longer than 24 bits following a partial byte */
+  EXPECT_SLICE_EQ("\x1c\x64\xff\xff\xfb\xbf\xff\xff\xf3",
+                  HUFF("abc\xff\x7f"));
 
   /* Various test vectors for combined encoding */
   EXPECT_COMBINED_EQUIV("");
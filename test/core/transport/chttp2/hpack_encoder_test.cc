@@ -30,6 +30,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
+#include "src/core/ext/transport/chttp2/transport/varint.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
@@ -394,6 +395,61 @@ static void test_interned_key_indexed() {
   }
 }
 
+/* encode kNumKeys headers with distinct interned keys and the same
+   non-interned value, returning the number of header bytes written */
+static const int kNumKeys = 100;
+static size_t encode_many_interned_keys() {
+  grpc_slice_buffer output;
+  grpc_linked_mdelem* e =
+      static_cast<grpc_linked_mdelem*>(gpr_malloc(sizeof(*e) * kNumKeys));
+  grpc_metadata_batch b;
+  grpc_metadata_batch_init(&b);
+  for (int i = 0; i < kNumKeys; i++) {
+    std::string key = absl::StrFormat("key%02d", i);
+    grpc_slice key_slice = grpc_slice_from_copied_string(key.c_str());
+    e[i].md = grpc_mdelem_from_slices(grpc_slice_intern(key_slice),
+                                      grpc_slice_from_static_string("v"));
+    grpc_slice_unref_internal(key_slice);
+    e[i].prev = i > 0 ? &e[i - 1] : nullptr;
+    e[i].next = i < kNumKeys - 1 ? &e[i + 1] : nullptr;
+  }
+  b.list.head = &e[0];
+  b.list.tail = &e[kNumKeys - 1];
+  b.list.count = kNumKeys;
+  grpc_slice_buffer_init(&output);
+
+  grpc_transport_one_way_stats stats;
+  stats = {};
+  grpc_encode_header_options hopt = {0xdeadbeef, /* stream_id */
+                                     false,      /* is_eof */
+                                     false,      /* use_true_binary_metadata */
+                                     16384,      /* max_frame_size */
+                                     &stats /* stats */};
+  grpc_chttp2_encode_header(&g_compressor, nullptr, 0, &b, &hopt, &output);
+  verify_frames(output, false);
+  grpc_slice_buffer_destroy_internal(&output);
+  grpc_metadata_batch_destroy(&b);
+  gpr_free(e);
+  return stats.header_bytes;
+}
+
+static void test_many_interned_keys_indexed() {
+  encode_many_interned_keys();
+  /* every key is now in the decoder table (the newest at index 62), so each
+     header is encoded as a literal with an indexed name */
+  size_t expected = 0;
+  for (int i = 0; i < kNumKeys; i++) {
+    const uint32_t key_index = 62 + (kNumKeys - 1 - i);
+    expected += GRPC_CHTTP2_VARINT_LENGTH(key_index, 4) + 2;
+  }
+  size_t got = encode_many_interned_keys();
+  if (got != expected) {
+    gpr_log(GPR_ERROR, "expected %" PRIuPTR " header bytes, got %" PRIuPTR,
+            expected, got);
+    g_failure = 1;
+  }
+}
+
 static void run_test(void (*test)(), const char* name) {
   gpr_log(GPR_INFO, "RUN TEST: %s", name);
   grpc_core::ExecCtx exec_ctx;
@@ -411,6 +467,7 @@ int main(int argc, char** argv) {
   TEST(test_decode_table_overflow);
   TEST(test_encode_header_size);
   TEST(test_interned_key_indexed);
+  TEST(test_many_interned_keys_indexed);
   TEST(test_continuation_headers);
   grpc_shutdown();
   for (i = 0; i < num_to_delete; i++) {
@@ -212,11 +212,38 @@ static void test_vectors(grpc_slice_split_mode mode) {
   grpc_chttp2_hpack_parser_destroy(&parser);
 }
 
+/* The buffers holding decoded header strings can be released between header
+   fields, and are allocated again by the next header strings. */
+static void test_release_buffers(grpc_slice_split_mode mode) {
+  grpc_chttp2_hpack_parser parser;
+  grpc_core::ExecCtx exec_ctx;
+
+  grpc_chttp2_hpack_parser_init(&parser);
+  new (&parser.table) grpc_chttp2_hptbl();
+  GPR_ASSERT(grpc_chttp2_hpack_parser_release_buffers(&parser) == 0);
+  /* D.4.1 */
+  test_vector(&parser, mode,
+              "8286 8441 8cf1 e3c2 e5f2 3a6b a0ab 90f4"
+              "ff",
+              ":method", "GET", ":scheme", "http", ":path", "/", ":authority",
+              "www.example.com", NULL);
+  GPR_ASSERT(grpc_chttp2_hpack_parser_release_buffers(&parser) > 0);
+  GPR_ASSERT(grpc_chttp2_hpack_parser_release_buffers(&parser) == 0);
+  /* D.4.2 */
+  test_vector(&parser, mode, "8286 84be 5886 a8eb 1064 9cbf", ":method", "GET",
+              ":scheme", "http", ":path", "/", ":authority", "www.example.com",
+              "cache-control", "no-cache", NULL);
+  GPR_ASSERT(grpc_chttp2_hpack_parser_release_buffers(&parser) > 0);
+  grpc_chttp2_hpack_parser_destroy(&parser);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
   test_vectors(GRPC_SLICE_SPLIT_MERGE_ALL);
   test_vectors(GRPC_SLICE_SPLIT_ONE_BYTE);
+  test_release_buffers(GRPC_SLICE_SPLIT_MERGE_ALL);
+  test_release_buffers(GRPC_SLICE_SPLIT_ONE_BYTE);
   grpc_shutdown();
   return 0;
 }
@@ -165,6 +165,57 @@ static void test_periodic_compaction(uint32_t n) {
   grpc_chttp2_stream_map_destroy(&map);
 }
 
+/* keep one stream open while others come and go, as with long lived streams:
+   it must stay reachable, without the backing array growing */
+static void test_long_lived_stream(uint32_t n) {
+  grpc_chttp2_stream_map map;
+  uint32_t i;
+  uint32_t del;
+
+  LOG_TEST("test_long_lived_stream");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 16);
+  grpc_chttp2_stream_map_add(&map, 1, reinterpret_cast<void*>(1));
+  for (i = 3; i <= 2 * n + 1; i += 2) {
+    grpc_chttp2_stream_map_add(&map, i, reinterpret_cast<void*>(i));
+    if (i > 9) {
+      del = i - 8;
+      GPR_ASSERT((void*)(uintptr_t)del ==
+                 grpc_chttp2_stream_map_delete(&map, del));
+    }
+    GPR_ASSERT(reinterpret_cast<void*>(1) ==
+               grpc_chttp2_stream_map_find(&map, 1));
+  }
+  GPR_ASSERT(map.capacity == 16);
+  GPR_ASSERT(reinterpret_cast<void*>(1) ==
+             grpc_chttp2_stream_map_delete(&map, 1));
+  GPR_ASSERT(grpc_chttp2_stream_map_size(&map) == (n < 4 ? n : 4));
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
+static void delete_visited(void* user_data, uint32_t stream_id, void* ptr) {
+  grpc_chttp2_stream_map* map = static_cast<grpc_chttp2_stream_map*>(user_data);
+  GPR_ASSERT(ptr == grpc_chttp2_stream_map_delete(map, stream_id));
+}
+
+/* delete every key from within for_each, as closing a transport does */
+static void test_delete_in_for_each(uint32_t n) {
+  grpc_chttp2_stream_map map;
+  uint32_t i;
+
+  LOG_TEST("test_delete_in_for_each");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, i, reinterpret_cast<void*>(i));
+  }
+  grpc_chttp2_stream_map_for_each(&map, delete_visited, &map);
+  GPR_ASSERT(0 == grpc_chttp2_stream_map_size(&map));
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
 int main(int argc, char** argv) {
   uint32_t n = 1;
   uint32_t prev = 1;
@@ -180,6 +231,8 @@ int main(int argc, char** argv) {
     test_delete_evens_sweep(n);
     test_delete_evens_incremental(n);
     test_periodic_compaction(n);
+    test_long_lived_stream(n);
+    test_delete_in_for_each(n);
 
     tmp = n;
     n += prev;
@@ -0,0 +1,206 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/ext/transport/chttp2/transport/write_scheduler.h"
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/transport/transport.h"
+#include "test/core/util/mock_endpoint.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+using chttp2::WeightedFairWriteScheduler;
+
+void discard_write(grpc_slice /*slice*/) {}
+
+// A transport over a mock endpoint, whose writable lists the tests drive the
+// way grpc_chttp2_begin_write() does, without writing anything out
+class WriteSchedulerTest : public ::testing::Test {
+ protected:
+  void Init(const char* scheduler) {
+    ExecCtx exec_ctx;
+    grpc_arg arg = grpc_channel_arg_string_create(
+        const_cast<char*>(GRPC_ARG_HTTP2_WRITE_SCHEDULER),
+        const_cast<char*>(scheduler));
+    grpc_channel_args args = {1, &arg};
+    resource_quota_ = grpc_resource_quota_create("write_scheduler_test");
+    grpc_endpoint* mock_endpoint =
+        grpc_mock_endpoint_create(discard_write, resource_quota_);
+    transport_ = grpc_create_chttp2_transport(&args, mock_endpoint, true);
+    GRPC_STREAM_REF_INIT(&ref_, 1, nullptr, nullptr, "write_scheduler_test");
+  }
+
+  void TearDown() override {
+    ExecCtx exec_ctx;
+    for (grpc_chttp2_stream* s : streams_) {
+      grpc_chttp2_list_remove_writable_stream(t(), s);
+      // Never opened, so that the stream need not be closed to be destroyed
+      s->id = 0;
+      grpc_transport_destroy_stream(transport_,
+                                    reinterpret_cast<grpc_stream*>(s), nullptr);
+      exec_ctx.Flush();
+      gpr_free(s);
+    }
+    grpc_transport_destroy(transport_);
+    grpc_resource_quota_unref(resource_quota_);
+  }
+
+  grpc_chttp2_transport* t() {
+    return reinterpret_cast<grpc_chttp2_transport*>(transport_);
+  }
+
+  // Creates a stream with \a bytes of data waiting to be written
+  grpc_chttp2_stream* CreateStream(size_t bytes, uint32_t weight = 1) {
+    grpc_chttp2_stream* s = static_cast<grpc_chttp2_stream*>(
+        gpr_malloc(grpc_transport_stream_size(transport_)));
+    grpc_transport_init_stream(transport_, reinterpret_cast<grpc_stream*>(s),
+                               &ref_, nullptr, nullptr);
+    s->id = 2 * static_cast<uint32_t>(streams_.size()) + 1;
+    s->write_weight = weight;
+    grpc_slice data = GRPC_SLICE_MALLOC(bytes);
+    memset(GRPC_SLICE_START_PTR(data), 0, bytes);
+    grpc_slice_buffer_add(&s->flow_controlled_buffer, data);
+    streams_.push_back(s);
+    return s;
+  }
+
+  // Gives the next writable stream its turn, in which it writes as much of
+  // its data as the scheduler allows. Returns the stream, or nullptr if no
+  // stream is writable.
+  grpc_chttp2_stream* WriteOneTurn(int64_t* sent) {
+    grpc_chttp2_stream* s;
+    if (!grpc_chttp2_list_pop_writable_stream(t(), &s)) return nullptr;
+    int64_t budget = t()->write_scheduler->BeginTurn(s);
+    *sent = GPR_MIN(budget,
+                    static_cast<int64_t>(s->flow_controlled_buffer.length));
+    grpc_slice_buffer_trim_end(&s->flow_controlled_buffer,
+                               static_cast<size_t>(*sent), nullptr);
+    bool more = s->flow_controlled_buffer.length > 0;
+    t()->write_scheduler->EndTurn(s, *sent, more);
+    if (more) {
+      EXPECT_TRUE(grpc_chttp2_list_add_writable_stream(t(), s));
+    }
+    return s;
+  }
+
+  grpc_resource_quota* resource_quota_ = nullptr;
+  grpc_transport* transport_ = nullptr;
+  grpc_stream_refcount ref_;
+  std::vector<grpc_chttp2_stream*> streams_;
+};
+
+TEST_F(WriteSchedulerTest, FifoWritesEverythingInOrder) {
+  Init("fifo");
+  ExecCtx exec_ctx;
+  grpc_chttp2_stream* bulk = CreateStream(1024 * 1024);
+  grpc_chttp2_stream* small = CreateStream(100);
+  EXPECT_TRUE(grpc_chttp2_list_add_writable_stream(t(), bulk));
+  EXPECT_TRUE(grpc_chttp2_list_add_writable_stream(t(), small));
+  int64_t sent;
+  EXPECT_EQ(WriteOneTurn(&sent), bulk);
+  EXPECT_EQ(sent, 1024 * 1024);
+  EXPECT_EQ(WriteOneTurn(&sent), small);
+  EXPECT_EQ(sent, 100);
+  EXPECT_EQ(WriteOneTurn(&sent), nullptr);
+}
+
+TEST_F(WriteSchedulerTest, WeightedFairSplitsBytesByWeight) {
+  Init("wfq");
+  ExecCtx exec_ctx;
+  const int64_t kQuantum = WeightedFairWriteScheduler::kQuantum;
+  grpc_chttp2_stream* light = CreateStream(1024 * 1024, 1);
+  grpc_chttp2_stream* heavy = CreateStream(1024 * 1024, 3);
+  EXPECT_TRUE(grpc_chttp2_list_add_writable_stream(t(), light));
+  EXPECT_TRUE(grpc_chttp2_list_add_writable_stream(t(), heavy));
+  int64_t light_sent = 0;
+  int64_t heavy_sent = 0;
+  for (int round = 1; round <= 8; round++) {
+    for (int i = 0; i < 2; i++) {
+      int64_t sent;
+      grpc_chttp2_stream* s = WriteOneTurn(&sent);
+      ASSERT_NE(s, nullptr);
+      (s == light ? light_sent : heavy_sent) += sent;
+    }
+    EXPECT_EQ(light_sent, round * kQuantum);
+    EXPECT_EQ(heavy_sent, 3 * round * kQuantum);
+  }
+}
+
+TEST_F(WriteSchedulerTest, WeightedFairDrainsPriorityListFirst) {
+  Init("wfq");
+  ExecCtx exec_ctx;
+  grpc_chttp2_stream* bulk = CreateStream(1024 * 1024);
+  EXPECT_TRUE(grpc_chttp2_list_add_writable_stream(t(), bulk));
+  EXPECT_FALSE(bulk->included[GRPC_CHTTP2_LIST_WRITABLE_PRIORITY]);
+  grpc_chttp2_stream* small1 = CreateStream(100);
+  grpc_chttp2_stream* small2 =
+      CreateStream(WeightedFairWriteScheduler::kPriorityBytes);
+  EXPECT_TRUE(grpc_chttp2_list_add_writable_stream(t(), small1));
+  EXPECT_TRUE(grpc_chttp2_list_add_writable_stream(t(), small2));
+  EXPECT_TRUE(small1->included[GRPC_CHTTP2_LIST_WRITABLE_PRIORITY]);
+  EXPECT_TRUE(small2->included[GRPC_CHTTP2_LIST_WRITABLE_PRIORITY]);
+  int64_t sent;
+  EXPECT_EQ(WriteOneTurn(&sent), small1);
+  EXPECT_EQ(sent, 100);
+  EXPECT_EQ(WriteOneTurn(&sent), small2);
+  EXPECT_EQ(sent, WeightedFairWriteScheduler::kPriorityBytes);
+  EXPECT_EQ(WriteOneTurn(&sent), bulk);
+  EXPECT_EQ(sent, WeightedFairWriteScheduler::kQuantum);
+}
+
+TEST_F(WriteSchedulerTest, StreamIsOnOneWritableListAtMost) {
+  Init("wfq");
+  ExecCtx exec_ctx;
+  grpc_chttp2_stream* s = CreateStream(1024 * 1024);
+  EXPECT_TRUE(grpc_chttp2_list_add_writable_stream(t(), s));
+  // The stream now qualifies for the priority list, but it already waits
+  // for its turn on the regular one
+  grpc_slice_buffer_trim_end(&s->flow_controlled_buffer,
+                             s->flow_controlled_buffer.length - 100, nullptr);
+  EXPECT_FALSE(grpc_chttp2_list_add_writable_stream(t(), s));
+  EXPECT_FALSE(s->included[GRPC_CHTTP2_LIST_WRITABLE_PRIORITY]);
+  int64_t sent;
+  EXPECT_EQ(WriteOneTurn(&sent), s);
+  EXPECT_EQ(WriteOneTurn(&sent), nullptr);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
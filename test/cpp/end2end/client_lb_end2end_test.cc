@@ -361,6 +361,8 @@ class ClientLbEnd2endTest : public ::testing::Test {
     std::unique_ptr<std::thread> thread_;
     bool server_ready_ = false;
     bool started_ = false;
+    // GRPC_ARG_MAX_CONCURRENT_STREAMS of the server, if positive.
+    int max_concurrent_streams_ = 0;
 
     explicit ServerData(int port = 0) {
       port_ = port > 0 ? port : grpc_pick_unused_port_or_die();
@@ -388,6 +390,10 @@ class ClientLbEnd2endTest : public ::testing::Test {
           grpc_fake_transport_security_server_credentials_create()));
       builder.AddListeningPort(server_address.str(), std::move(creds));
       builder.RegisterService(&service_);
+      if (max_concurrent_streams_ > 0) {
+        builder.AddChannelArgument(GRPC_ARG_MAX_CONCURRENT_STREAMS,
+                                   max_concurrent_streams_);
+      }
       server_ = builder.BuildAndStart();
       grpc::internal::MutexLock lock(mu);
       server_ready_ = true;
@@ -1636,6 +1642,67 @@ TEST_F(ClientLbEnd2endTest,
   EnableDefaultHealthCheckService(false);
 }
 
+TEST_F(ClientLbEnd2endTest, RingHash) {
+  // Start servers and create channel.  Without a key to hash, calls go to
+  // random points of the ring.
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("ring_hash_experimental", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION, true /* wait_for_ready */);
+  } while (!SeenAllServers());
+  // Check LB policy name for the channel.
+  EXPECT_EQ("ring_hash_experimental", channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(ClientLbEnd2endTest, RingHashHeaderAffinity) {
+  // Start servers and create channel.  All the calls carry the same value
+  // for the hashed header, so they all go to the same backend.
+  const int kNumServers = 3;
+  const int kNumRpcs = 20;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  const char* kServiceConfigJson =
+      "{\"loadBalancingConfig\": "
+      "[{\"ring_hash_experimental\": {\"hashHeader\": \"foo\"}}]}";
+  response_generator.SetNextResolution(GetServersPorts(), kServiceConfigJson);
+  for (int i = 0; i < kNumRpcs; ++i) {
+    CheckRpcSendOk(stub, DEBUG_LOCATION, true /* wait_for_ready */);
+  }
+  auto find_owner = [this, kNumRpcs]() {
+    int owner = -1;
+    for (size_t i = 0; i < servers_.size(); ++i) {
+      if (servers_[i]->service_.request_count() > 0) {
+        EXPECT_EQ(kNumRpcs, servers_[i]->service_.request_count());
+        owner = static_cast<int>(i);
+      }
+    }
+    return owner;
+  };
+  const int owner = find_owner();
+  ASSERT_NE(owner, -1);
+  // When that backend goes down, the calls fail over to another one, once
+  // the channel has seen the disconnection.
+  servers_[owner]->Shutdown();
+  ResetCounters();
+  while (servers_[(owner + 1) % kNumServers]->service_.request_count() == 0 &&
+         servers_[(owner + 2) % kNumServers]->service_.request_count() == 0) {
+    SendRpc(stub);
+  }
+  ResetCounters();
+  for (int i = 0; i < kNumRpcs; ++i) {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  }
+  const int new_owner = find_owner();
+  EXPECT_NE(new_owner, -1);
+  EXPECT_NE(new_owner, owner);
+}
+
 TEST_F(ClientLbEnd2endTest, ChannelIdleness) {
   // Start server.
   const int kNumServers = 1;
@@ -1665,6 +1732,188 @@ TEST_F(ClientLbEnd2endTest, ChannelIdleness) {
   EXPECT_EQ(channel->GetState(false), GRPC_CHANNEL_READY);
 }
 
+class ClientLbConnectionPoolTest : public ClientLbEnd2endTest {
+ protected:
+  // Streams the server accepts per connection.
+  static const int kStreamsPerConnection = 4;
+  // Calls the client puts on each connection before it opens another one,
+  // below kStreamsPerConnection so that the calls which trigger the growth
+  // are not held up by the server.
+  static const int kCallsPerConnection = 2;
+  static const int kMaxConnections = 2;
+
+  void StartPoolServer() {
+    CreateServers(1);
+    servers_[0]->max_concurrent_streams_ = kStreamsPerConnection;
+    StartServer(0);
+  }
+
+  std::shared_ptr<Channel> BuildPoolChannel(
+      const FakeResolverResponseGeneratorWrapper& response_generator) {
+    ChannelArguments args;
+    args.SetInt(GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS, kMaxConnections);
+    args.SetInt(GRPC_ARG_SUBCHANNEL_MAX_CALLS_PER_CONNECTION,
+                kCallsPerConnection);
+    return BuildChannel("", response_generator, args);
+  }
+
+  // Sends an RPC that holds the server for \a server_sleep_ms, and returns
+  // the peer the server saw it from, which tells the connection apart.
+  std::string SendRpcGetPeer(
+      const std::unique_ptr<grpc::testing::EchoTestService::Stub>& stub,
+      int server_sleep_ms = 0) {
+    EchoRequest request;
+    request.set_message(kRequestMessage_);
+    request.mutable_param()->set_echo_peer(true);
+    request.mutable_param()->set_server_sleep_us(server_sleep_ms * 1000);
+    EchoResponse response;
+    ClientContext context;
+    context.set_deadline(
+        grpc_timeout_milliseconds_to_deadline(server_sleep_ms + 5000));
+    context.set_wait_for_ready(true);
+    Status status = stub->Echo(&context, request, &response);
+    EXPECT_TRUE(status.ok()) << status.error_message();
+    return response.param().peer();
+  }
+
+  // Starts \a num_rpcs RPCs that hold the server for \a server_sleep_ms, and
+  // returns once the server has them all. Each thread stores the peer of its
+  // RPC in \a peers.
+  std::vector<std::thread> StartLongRpcs(
+      const std::unique_ptr<grpc::testing::EchoTestService::Stub>& stub,
+      int num_rpcs, int server_sleep_ms, std::vector<std::string>* peers) {
+    const int started = servers_[0]->service_.request_count();
+    peers->resize(num_rpcs);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_rpcs; ++i) {
+      threads.emplace_back([this, &stub, server_sleep_ms, peers, i]() {
+        (*peers)[i] = SendRpcGetPeer(stub, server_sleep_ms);
+      });
+    }
+    while (servers_[0]->service_.request_count() < started + num_rpcs) {
+      gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+    }
+    return threads;
+  }
+
+  // Sends short RPCs until one of them goes over a connection whose peer is
+  // not in \a known, and returns that peer, or an empty string if none did
+  // within 5 seconds.
+  std::string WaitForNewConnection(
+      const std::unique_ptr<grpc::testing::EchoTestService::Stub>& stub,
+      const std::set<std::string>& known) {
+    const gpr_timespec deadline = grpc_timeout_seconds_to_deadline(5);
+    while (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0) {
+      std::string peer = SendRpcGetPeer(stub);
+      if (known.find(peer) == known.end()) return peer;
+    }
+    return "";
+  }
+
+  static void JoinAll(std::vector<std::thread>* threads) {
+    for (std::thread& thread : *threads) thread.join();
+  }
+};
+
+TEST_F(ClientLbConnectionPoolTest, GrowsWhenLoadedAndPicksLeastLoaded) {
+  StartPoolServer();
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildPoolChannel(response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  const std::string primary = SendRpcGetPeer(stub);
+  // Below kCallsPerConnection, calls all share the first connection.
+  std::vector<std::string> long_peers;
+  std::vector<std::thread> long_rpcs =
+      StartLongRpcs(stub, kCallsPerConnection - 1, 2000, &long_peers);
+  EXPECT_EQ(primary, SendRpcGetPeer(stub));
+  JoinAll(&long_rpcs);
+  EXPECT_EQ(primary, long_peers[0]);
+  // Once it carries kCallsPerConnection calls, the next call opens another
+  // connection, which then takes the calls while it is the least loaded.
+  long_rpcs = StartLongRpcs(stub, kCallsPerConnection, 2000, &long_peers);
+  const std::string pooled = WaitForNewConnection(stub, {primary});
+  ASSERT_NE(pooled, "");
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(pooled, SendRpcGetPeer(stub));
+  }
+  // With both connections at kCallsPerConnection calls, none is opened
+  // beyond kMaxConnections.
+  std::vector<std::string> more_long_peers;
+  std::vector<std::thread> more_long_rpcs =
+      StartLongRpcs(stub, kCallsPerConnection, 2000, &more_long_peers);
+  for (int i = 0; i < 5; ++i) {
+    const std::string peer = SendRpcGetPeer(stub);
+    EXPECT_TRUE(peer == primary || peer == pooled) << peer;
+  }
+  JoinAll(&long_rpcs);
+  JoinAll(&more_long_rpcs);
+  for (const std::string& peer : long_peers) EXPECT_EQ(primary, peer);
+  for (const std::string& peer : more_long_peers) EXPECT_EQ(pooled, peer);
+  EXPECT_EQ(servers_[0]->service_.clients().size(),
+            static_cast<size_t>(kMaxConnections));
+}
+
+TEST_F(ClientLbConnectionPoolTest, ClosesIdleConnection) {
+  StartPoolServer();
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildPoolChannel(response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  const std::string primary = SendRpcGetPeer(stub);
+  std::vector<std::string> primary_peers;
+  std::vector<std::thread> primary_rpcs =
+      StartLongRpcs(stub, kCallsPerConnection, 1000, &primary_peers);
+  const std::string pooled = WaitForNewConnection(stub, {primary});
+  ASSERT_NE(pooled, "");
+  // The pooled connection has the last call to finish: it is closed when
+  // that call is done, as the first connection is idle by then.
+  std::vector<std::string> pooled_peers;
+  std::vector<std::thread> pooled_rpcs =
+      StartLongRpcs(stub, 1, 2000, &pooled_peers);
+  JoinAll(&primary_rpcs);
+  JoinAll(&pooled_rpcs);
+  EXPECT_EQ(pooled, pooled_peers[0]);
+  // So loading the first connection again opens a new one.
+  EXPECT_EQ(primary, SendRpcGetPeer(stub));
+  primary_rpcs = StartLongRpcs(stub, kCallsPerConnection, 1000, &primary_peers);
+  const std::string new_pooled =
+      WaitForNewConnection(stub, {primary, pooled});
+  EXPECT_NE(new_pooled, "");
+  JoinAll(&primary_rpcs);
+}
+
+TEST_F(ClientLbConnectionPoolTest, DropsPoolWhenFirstConnectionFails) {
+  StartPoolServer();
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildPoolChannel(response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  const std::string primary = SendRpcGetPeer(stub);
+  std::vector<std::string> long_peers;
+  std::vector<std::thread> long_rpcs =
+      StartLongRpcs(stub, kCallsPerConnection, 1000, &long_peers);
+  const std::string pooled = WaitForNewConnection(stub, {primary});
+  ASSERT_NE(pooled, "");
+  JoinAll(&long_rpcs);
+  // Restart the server: the channel reconnects, without waiting for any
+  // attempt the pool had under way, and the new connection starts with an
+  // empty pool.
+  servers_[0]->Shutdown();
+  EXPECT_TRUE(WaitForChannelNotReady(channel.get()));
+  StartServer(0);
+  EXPECT_TRUE(WaitForChannelReady(channel.get()));
+  const std::string new_primary = SendRpcGetPeer(stub);
+  EXPECT_NE(new_primary, "");
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(new_primary, SendRpcGetPeer(stub));
+  }
+  long_rpcs = StartLongRpcs(stub, kCallsPerConnection, 1000, &long_peers);
+  EXPECT_NE(WaitForNewConnection(stub, {new_primary}), "");
+  JoinAll(&long_rpcs);
+  for (const std::string& peer : long_peers) EXPECT_EQ(new_primary, peer);
+}
+
 class ClientLbPickArgsTest : public ClientLbEnd2endTest {
  protected:
   void SetUp() override {
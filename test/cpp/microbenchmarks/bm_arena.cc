@@ -60,6 +60,21 @@ static void BM_Arena_Batch(benchmark::State& state) {
 }
 BENCHMARK(BM_Arena_Batch)->Ranges({{1, 64 * 1024}, {1, 64}, {1, 1024}});
 
+// Creates and destroys call-sized arenas from several threads at once, as
+// servers do for every RPC; exercises the recycling of arena blocks.
+static void BM_Arena_CreateDestroyConcurrent(benchmark::State& state) {
+  for (auto _ : state) {
+    Arena* a = Arena::Create(state.range(0));
+    benchmark::DoNotOptimize(a->Alloc(256));
+    a->Destroy();
+  }
+}
+BENCHMARK(BM_Arena_CreateDestroyConcurrent)
+    ->Arg(1024)
+    ->Arg(8 * 1024)
+    ->Arg(48 * 1024)
+    ->ThreadRange(1, 64);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -25,6 +25,7 @@
 #include <memory>
 #include <sstream>
 
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/ext/transport/chttp2/transport/incoming_metadata.h"
@@ -46,6 +47,19 @@ static grpc_slice MakeSlice(std::vector<uint8_t> bytes) {
   return s;
 }
 
+// A token-like header value (as found in auth and tracing headers) of the
+// given length.
+static grpc_slice MakeTokenValue(size_t length) {
+  static const char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_.";
+  grpc_slice s = grpc_slice_malloc(length);
+  uint8_t* p = GRPC_SLICE_START_PTR(s);
+  for (size_t i = 0; i < length; i++) {
+    p[i] = kAlphabet[(i * 7) % (sizeof(kAlphabet) - 1)];
+  }
+  return s;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // HPACK encoder
 //
@@ -427,6 +441,20 @@ BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
 
 }  // namespace hpack_encoder_fixtures
 
+static void BM_HpackEncoderHuffmanCompress(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_slice value = MakeTokenValue(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    grpc_slice compressed = grpc_chttp2_huffman_compress(value);
+    benchmark::DoNotOptimize(GRPC_SLICE_START_PTR(compressed));
+    grpc_slice_unref(compressed);
+  }
+  grpc_slice_unref(value);
+  state.SetBytesProcessed(state.range(0) * state.iterations());
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_HpackEncoderHuffmanCompress)->Range(8, 4096);
+
 ////////////////////////////////////////////////////////////////////////////////
 // HPACK parser
 //
@@ -650,6 +678,34 @@ class NonIndexedBinaryElem<100, false> {
   }
 };
 
+// A literal header with a huffman encoded token-like value of kLength bytes.
+template <int kLength>
+class NonIndexedHuffmanElem {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    grpc_slice value = MakeTokenValue(kLength);
+    grpc_slice compressed = grpc_chttp2_huffman_compress(value);
+    std::vector<uint8_t> v = {0x00, 0x03, 'a', 'b', 'c'};
+    // Huffman flag plus a 7 bit prefix length.
+    size_t length = GRPC_SLICE_LENGTH(compressed);
+    if (length < 0x7f) {
+      v.push_back(static_cast<uint8_t>(0x80 | length));
+    } else {
+      v.push_back(0xff);
+      for (length -= 0x7f; length >= 0x80; length >>= 7) {
+        v.push_back(static_cast<uint8_t>(0x80 | (length & 0x7f)));
+      }
+      v.push_back(static_cast<uint8_t>(length));
+    }
+    v.insert(v.end(), GRPC_SLICE_START_PTR(compressed),
+             GRPC_SLICE_END_PTR(compressed));
+    grpc_slice_unref(compressed);
+    grpc_slice_unref(value);
+    return {MakeSlice(v)};
+  }
+};
+
 class RepresentativeClientInitialMetadata {
  public:
   static std::vector<grpc_slice> GetInitSlices() {
@@ -913,6 +969,12 @@ BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBinaryElem<31, true>,
                    UnrefHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedBinaryElem<100, true>,
                    UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedHuffmanElem<10>,
+                   UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedHuffmanElem<100>,
+                   UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, NonIndexedHuffmanElem<1000>,
+                   UnrefHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
                    RepresentativeClientInitialMetadata, UnrefHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
@@ -0,0 +1,132 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the chttp2 stream map */
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+
+#include "src/core/ext/transport/chttp2/transport/stream_map.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+// The streams of one peer: odd ids, opened in increasing order
+class Streams {
+ public:
+  explicit Streams(int count) {
+    grpc_chttp2_stream_map_init(&map_, 8);
+    for (int i = 0; i < count; i++) Open();
+  }
+  ~Streams() { grpc_chttp2_stream_map_destroy(&map_); }
+
+  grpc_chttp2_stream_map* map() { return &map_; }
+  const std::deque<uint32_t>& live() const { return live_; }
+
+  void Open() {
+    grpc_chttp2_stream_map_add(&map_, next_id_, &next_id_);
+    live_.push_back(next_id_);
+    next_id_ += 2;
+  }
+
+  // Leaves the oldest stream open for good, returning its id
+  uint32_t KeepOldest() {
+    uint32_t id = live_.front();
+    live_.pop_front();
+    return id;
+  }
+
+  void CloseOldest() {
+    grpc_chttp2_stream_map_delete(&map_, live_.front());
+    live_.pop_front();
+  }
+
+ private:
+  grpc_chttp2_stream_map map_;
+  std::deque<uint32_t> live_;
+  uint32_t next_id_ = 1;
+};
+
+}  // namespace
+
+// Looks up the stream of each incoming frame, with frames spread over all the
+// open streams; every 16 frames a stream completes and a new one opens.
+static void BM_StreamMap_FrameDispatch(benchmark::State& state) {
+  Streams streams(state.range(0));
+  uint32_t frame = 0;
+  for (auto _ : state) {
+    const std::deque<uint32_t>& live = streams.live();
+    /* visit the streams in a scattered order */
+    uint32_t id = live[(frame * 2654435761u) % live.size()];
+    benchmark::DoNotOptimize(grpc_chttp2_stream_map_find(streams.map(), id));
+    if (++frame % 16 == 0) {
+      streams.CloseOldest();
+      streams.Open();
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamMap_FrameDispatch)->Arg(10)->Arg(1000)->Arg(10000);
+
+// As above, with one long lived stream (such as a watch) also receiving
+// frames while the other streams come and go.
+static void BM_StreamMap_FrameDispatchLongLived(benchmark::State& state) {
+  Streams streams(state.range(0) + 1);
+  const uint32_t long_lived_id = streams.KeepOldest();
+  uint32_t frame = 0;
+  for (auto _ : state) {
+    const std::deque<uint32_t>& live = streams.live();
+    uint32_t id = frame % 4 == 0 ? long_lived_id
+                                 : live[(frame * 2654435761u) % live.size()];
+    benchmark::DoNotOptimize(grpc_chttp2_stream_map_find(streams.map(), id));
+    if (++frame % 16 == 0) {
+      streams.CloseOldest();
+      streams.Open();
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamMap_FrameDispatchLongLived)->Arg(10)->Arg(1000)->Arg(10000);
+
+// Opens and closes streams, oldest first, with a constant number open.
+static void BM_StreamMap_Churn(benchmark::State& state) {
+  Streams streams(state.range(0));
+  for (auto _ : state) {
+    streams.CloseOldest();
+    streams.Open();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamMap_Churn)->Arg(10)->Arg(1000)->Arg(10000);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
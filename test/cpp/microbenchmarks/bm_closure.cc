@@ -23,6 +23,7 @@
 #include <sstream>
 
 #include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -347,6 +348,67 @@ static void BM_ClosureSched4OnTwoCombiners(benchmark::State& state) {
 }
 BENCHMARK(BM_ClosureSched4OnTwoCombiners);
 
+// A call combiner whose first closure starts two more from inside it before
+// yielding, as a filter returning several callbacks to the surface does.
+struct CallCombinerBenchmarkArgs {
+  grpc_core::CallCombiner call_combiner;
+  grpc_closure first;
+  grpc_closure second;
+  grpc_closure third;
+  bool while_holding;
+};
+
+static void StopCallCombiner(void* arg, grpc_error* /*error*/) {
+  GRPC_CALL_COMBINER_STOP(static_cast<grpc_core::CallCombiner*>(arg),
+                          "benchmark");
+}
+
+static void StartFromCallCombiner(void* arg, grpc_error* /*error*/) {
+  auto* args = static_cast<CallCombinerBenchmarkArgs*>(arg);
+  if (args->while_holding) {
+    GRPC_CALL_COMBINER_START_WHILE_HOLDING(
+        &args->call_combiner, &args->second, GRPC_ERROR_NONE, "benchmark");
+    GRPC_CALL_COMBINER_START_WHILE_HOLDING(&args->call_combiner, &args->third,
+                                           GRPC_ERROR_NONE, "benchmark");
+  } else {
+    GRPC_CALL_COMBINER_START(&args->call_combiner, &args->second,
+                             GRPC_ERROR_NONE, "benchmark");
+    GRPC_CALL_COMBINER_START(&args->call_combiner, &args->third,
+                             GRPC_ERROR_NONE, "benchmark");
+  }
+  GRPC_CALL_COMBINER_STOP(&args->call_combiner, "benchmark");
+}
+
+static void RunCallCombinerBenchmark(benchmark::State& state,
+                                     bool while_holding) {
+  TrackCounters track_counters;
+  CallCombinerBenchmarkArgs args;
+  args.while_holding = while_holding;
+  GRPC_CLOSURE_INIT(&args.first, StartFromCallCombiner, &args, nullptr);
+  GRPC_CLOSURE_INIT(&args.second, StopCallCombiner, &args.call_combiner,
+                    nullptr);
+  GRPC_CLOSURE_INIT(&args.third, StopCallCombiner, &args.call_combiner,
+                    nullptr);
+  grpc_core::ExecCtx exec_ctx;
+  for (auto _ : state) {
+    GRPC_CALL_COMBINER_START(&args.call_combiner, &args.first, GRPC_ERROR_NONE,
+                             "benchmark");
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+
+  track_counters.Finish(state);
+}
+
+static void BM_CallCombinerStart3(benchmark::State& state) {
+  RunCallCombinerBenchmark(state, false);
+}
+BENCHMARK(BM_CallCombinerStart3);
+
+static void BM_CallCombinerStart3WhileHolding(benchmark::State& state) {
+  RunCallCombinerBenchmark(state, true);
+}
+BENCHMARK(BM_CallCombinerStart3WhileHolding);
+
 // Helper that continuously reschedules the same closure against something until
 // the benchmark is complete
 class Rescheduler {
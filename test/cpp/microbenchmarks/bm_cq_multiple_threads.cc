@@ -24,6 +24,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/surface/completion_queue.h"
@@ -39,6 +40,8 @@ static gpr_mu g_mu;
 static gpr_cv g_cv;
 static int g_threads_active;
 static bool g_active;
+// Number of completions queued by each call to pollset_work
+static int g_events_per_work = 1;
 
 namespace grpc {
 namespace testing {
@@ -66,7 +69,7 @@ static void cq_done_cb(void* /*done_arg*/, grpc_cq_completion* cq_completion) {
   gpr_free(cq_completion);
 }
 
-/* Queues a completion tag if deadline is > 0.
+/* Queues g_events_per_work completion tags if deadline is > 0.
  * Does nothing if deadline is 0 (i.e gpr_time_0(GPR_CLOCK_MONOTONIC)) */
 static grpc_error* pollset_work(grpc_pollset* ps,
                                 grpc_pollset_worker** /*worker*/,
@@ -79,10 +82,12 @@ static grpc_error* pollset_work(grpc_pollset* ps,
   gpr_mu_unlock(&ps->mu);
 
   void* tag = reinterpret_cast<void*>(10);  // Some random number
-  GPR_ASSERT(grpc_cq_begin_op(g_cq, tag));
-  grpc_cq_end_op(
-      g_cq, tag, GRPC_ERROR_NONE, cq_done_cb, nullptr,
-      static_cast<grpc_cq_completion*>(gpr_malloc(sizeof(grpc_cq_completion))));
+  for (int i = 0; i < g_events_per_work; i++) {
+    GPR_ASSERT(grpc_cq_begin_op(g_cq, tag));
+    grpc_cq_end_op(g_cq, tag, GRPC_ERROR_NONE, cq_done_cb, nullptr,
+                   static_cast<grpc_cq_completion*>(
+                       gpr_malloc(sizeof(grpc_cq_completion))));
+  }
   grpc_core::ExecCtx::Get()->Flush();
   gpr_mu_lock(&ps->mu);
   return GRPC_ERROR_NONE;
@@ -156,10 +161,9 @@ static void teardown() {
  and its Finish call must take place before grpc_shutdown so that it can use
  grpc_stats).
 */
-static void BM_Cq_Throughput(benchmark::State& state) {
+/* Waits for all the benchmark threads to arrive; thread 0 does the setup */
+static void start_thread(int thd_idx) {
   gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
-  auto thd_idx = state.thread_index;
-
   gpr_mu_lock(&g_mu);
   g_threads_active++;
   if (thd_idx == 0) {
@@ -172,19 +176,11 @@ static void BM_Cq_Throughput(benchmark::State& state) {
     }
   }
   gpr_mu_unlock(&g_mu);
+}
 
-  // Use a TrackCounters object to monitor the gRPC performance statistics
-  // (optionally including low-level counters) before and after the test
-  TrackCounters track_counters;
-
-  for (auto _ : state) {
-    GPR_ASSERT(grpc_completion_queue_next(g_cq, deadline, nullptr).type ==
-               GRPC_OP_COMPLETE);
-  }
-
-  state.SetItemsProcessed(state.iterations());
-  track_counters.Finish(state);
-
+/* Waits for all the benchmark threads to finish; thread 0 does the teardown */
+static void finish_thread(int thd_idx) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
   gpr_mu_lock(&g_mu);
   g_threads_active--;
   if (g_threads_active == 0) {
@@ -202,7 +198,63 @@ static void BM_Cq_Throughput(benchmark::State& state) {
   }
 }
 
+static void BM_Cq_Throughput(benchmark::State& state) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  auto thd_idx = state.thread_index;
+
+  start_thread(thd_idx);
+
+  // Use a TrackCounters object to monitor the gRPC performance statistics
+  // (optionally including low-level counters) before and after the test
+  TrackCounters track_counters;
+
+  for (auto _ : state) {
+    GPR_ASSERT(grpc_completion_queue_next(g_cq, deadline, nullptr).type ==
+               GRPC_OP_COMPLETE);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  track_counters.Finish(state);
+
+  finish_thread(thd_idx);
+}
+
+/* Like BM_Cq_Throughput, but each poll queues state.range(0) events, which are
+   then drained with grpc_completion_queue_next_batch. */
+static void BM_Cq_BatchThroughput(benchmark::State& state) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  auto thd_idx = state.thread_index;
+  const size_t max_events = static_cast<size_t>(state.range(0));
+  grpc_event events[32];
+  GPR_ASSERT(max_events <= GPR_ARRAY_SIZE(events));
+
+  if (thd_idx == 0) g_events_per_work = static_cast<int>(max_events);
+  start_thread(thd_idx);
+
+  TrackCounters track_counters;
+
+  int64_t items = 0;
+  for (auto _ : state) {
+    size_t n = grpc_completion_queue_next_batch(g_cq, events, max_events,
+                                                deadline, nullptr);
+    GPR_ASSERT(n > 0 && events[0].type == GRPC_OP_COMPLETE);
+    items += n;
+  }
+
+  state.SetItemsProcessed(items);
+  track_counters.Finish(state);
+
+  finish_thread(thd_idx);
+  if (thd_idx == 0) g_events_per_work = 1;
+}
+
 BENCHMARK(BM_Cq_Throughput)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_Cq_BatchThroughput)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(32)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
 
 }  // namespace testing
 }  // namespace grpc
@@ -20,7 +20,10 @@
 
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/memory/memory.h"
@@ -77,18 +80,50 @@ static void write_csv(std::ostream* out, A0&& a0, Arg&&... arg) {
   write_csv(out, std::forward<Arg>(arg)...);
 }
 
+// Flow control policies to compare, indexed by benchmark argument
+static const char* const kFlowControlPolicies[] = {"pid", "bbr"};
+// Write schedulers to compare, indexed by benchmark argument
+static const char* const kWriteSchedulers[] = {"fifo", "wfq"};
+
+class TransportConfiguration : public FixtureConfiguration {
+ public:
+  TransportConfiguration(const char* policy, const char* write_scheduler)
+      : policy_(policy), write_scheduler_(write_scheduler) {}
+
+  void ApplyCommonChannelArguments(ChannelArguments* c) const override {
+    FixtureConfiguration::ApplyCommonChannelArguments(c);
+    c->SetString(GRPC_ARG_HTTP2_FLOW_CONTROL_POLICY, policy_);
+    c->SetString(GRPC_ARG_HTTP2_WRITE_SCHEDULER, write_scheduler_);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+    b->AddChannelArgument(GRPC_ARG_HTTP2_FLOW_CONTROL_POLICY, policy_);
+    b->AddChannelArgument(GRPC_ARG_HTTP2_WRITE_SCHEDULER, write_scheduler_);
+  }
+
+ private:
+  const char* const policy_;
+  const char* const write_scheduler_;
+};
+
 class TrickledCHTTP2 : public EndpointPairFixture {
  public:
   TrickledCHTTP2(Service* service, bool streaming, size_t req_size,
                  size_t resp_size, size_t kilobits_per_second,
-                 grpc_passthru_endpoint_stats* stats)
-      : EndpointPairFixture(service, MakeEndpoints(kilobits_per_second, stats),
-                            FixtureConfiguration()),
+                 int flow_control_policy, grpc_passthru_endpoint_stats* stats,
+                 int write_scheduler = 0)
+      : EndpointPairFixture(
+            service, MakeEndpoints(kilobits_per_second, stats),
+            TransportConfiguration(kFlowControlPolicies[flow_control_policy],
+                                   kWriteSchedulers[write_scheduler])),
         stats_(stats) {
     if (absl::GetFlag(FLAGS_log)) {
       std::ostringstream fn;
       fn << "trickle." << (streaming ? "streaming" : "unary") << "." << req_size
-         << "." << resp_size << "." << kilobits_per_second << ".csv";
+         << "." << resp_size << "." << kilobits_per_second << "."
+         << kFlowControlPolicies[flow_control_policy] << "."
+         << kWriteSchedulers[write_scheduler] << ".csv";
       log_ = absl::make_unique<std::ofstream>(fn.str().c_str());
       write_csv(log_.get(), "t", "iteration", "client_backlog",
                 "server_backlog", "client_t_stall", "client_s_stall",
@@ -129,7 +164,15 @@ class TrickledCHTTP2 : public EndpointPairFixture {
         << " svr_stream_stalls/iter:"
         << (static_cast<double>(
                 server_stats_.streams_stalled_due_to_stream_flow_control) /
-            static_cast<double>(state.iterations()));
+            static_cast<double>(state.iterations()))
+        << " cli_window_settled_ms:"
+        << static_cast<double>(client_window_.settled_at_us - start_us_) /
+               1000.0
+        << " cli_window_changes:" << client_window_.changes
+        << " svr_window_settled_ms:"
+        << static_cast<double>(server_window_.settled_at_us - start_us_) /
+               1000.0
+        << " svr_window_changes:" << server_window_.changes;
   }
 
   void Log(int64_t iteration) GPR_ATTRIBUTE_NO_TSAN {
@@ -139,12 +182,14 @@ class TrickledCHTTP2 : public EndpointPairFixture {
     grpc_chttp2_transport* server =
         reinterpret_cast<grpc_chttp2_transport*>(server_transport_);
     grpc_chttp2_stream* client_stream =
-        client->stream_map.count == 1
-            ? static_cast<grpc_chttp2_stream*>(client->stream_map.values[0])
+        grpc_chttp2_stream_map_size(&client->stream_map) == 1
+            ? static_cast<grpc_chttp2_stream*>(
+                  grpc_chttp2_stream_map_rand(&client->stream_map))
             : nullptr;
     grpc_chttp2_stream* server_stream =
-        server->stream_map.count == 1
-            ? static_cast<grpc_chttp2_stream*>(server->stream_map.values[0])
+        grpc_chttp2_stream_map_size(&server->stream_map) == 1
+            ? static_cast<grpc_chttp2_stream*>(
+                  grpc_chttp2_stream_map_rand(&server->stream_map))
             : nullptr;
     write_csv(
         log_.get(),
@@ -202,6 +247,11 @@ class TrickledCHTTP2 : public EndpointPairFixture {
       UpdateStats(reinterpret_cast<grpc_chttp2_transport*>(server_transport_),
                   &server_stats_, server_backlog);
     }
+    // Windows ramp up during warmup too: track them from the start
+    UpdateWindow(reinterpret_cast<grpc_chttp2_transport*>(client_transport_),
+                 &client_window_);
+    UpdateWindow(reinterpret_cast<grpc_chttp2_transport*>(server_transport_),
+                 &server_window_);
   }
 
  private:
@@ -212,8 +262,18 @@ class TrickledCHTTP2 : public EndpointPairFixture {
   };
   Stats client_stats_;
   Stats server_stats_;
+  // How the target initial window of a transport settled: the number of
+  // times it moved by more than a tenth, and the (simulated) time it last did
+  struct Window {
+    int64_t target = -1;
+    int changes = 0;
+    gpr_atm settled_at_us = 0;
+  };
+  Window client_window_;
+  Window server_window_;
   std::unique_ptr<std::ofstream> log_;
   gpr_timespec start_ = gpr_now(GPR_CLOCK_MONOTONIC);
+  const gpr_atm start_us_ = gpr_atm_no_barrier_load(&g_now_us);
 
   static grpc_endpoint_pair MakeEndpoints(size_t kilobits,
                                           grpc_passthru_endpoint_stats* stats) {
@@ -237,8 +297,32 @@ class TrickledCHTTP2 : public EndpointPairFixture {
       }
     }
   }
+
+  void UpdateWindow(grpc_chttp2_transport* t, Window* w) GPR_ATTRIBUTE_NO_TSAN {
+    int64_t target = t->flow_control->target_initial_window_size_;
+    gpr_atm now = gpr_atm_no_barrier_load(&g_now_us);
+    if (w->target < 0) {
+      w->target = target;
+      w->settled_at_us = now;
+    } else if (std::abs(target - w->target) * 10 > w->target) {
+      w->target = target;
+      w->changes++;
+      w->settled_at_us = now;
+    }
+  }
 };
 
+// Reports the throughput of the measured iterations in simulated time, which
+// (unlike bytes_per_second) reflects how well flow control fills the pipe.
+static void SetSimulatedThroughput(benchmark::State& state, gpr_atm start_us,
+                                   int64_t bytes) {
+  gpr_atm elapsed_us = gpr_atm_no_barrier_load(&g_now_us) - start_us;
+  state.counters["sim_bytes_per_second"] =
+      elapsed_us > 0 ? static_cast<double>(bytes) * GPR_US_PER_SEC /
+                           static_cast<double>(elapsed_us)
+                     : 0;
+}
+
 static void TrickleCQNext(TrickledCHTTP2* fixture, void** t, bool* ok,
                           int64_t iteration) {
   while (true) {
@@ -262,6 +346,7 @@ static void BM_PumpStreamServerToClient_Trickle(benchmark::State& state) {
   std::unique_ptr<TrickledCHTTP2> fixture(new TrickledCHTTP2(
       &service, true, state.range(0) /* req_size */,
       state.range(0) /* resp_size */, state.range(1) /* bw in kbit/s */,
+      state.range(2) /* flow control policy */,
       grpc_passthru_endpoint_stats_create()));
   {
     EchoResponse send_response;
@@ -317,9 +402,12 @@ static void BM_PumpStreamServerToClient_Trickle(benchmark::State& state) {
         break;
       }
     }
+    const gpr_atm measure_start_us = gpr_atm_no_barrier_load(&g_now_us);
     while (state.KeepRunning()) {
       inner_loop(false);
     }
+    SetSimulatedThroughput(state, measure_start_us,
+                           state.range(0) * state.iterations());
     response_rw.Finish(Status::OK, tag(1));
     grpc::Status status;
     request_rw->Finish(&status, tag(2));
@@ -341,12 +429,15 @@ static void BM_PumpStreamServerToClient_Trickle(benchmark::State& state) {
 }
 
 static void StreamingTrickleArgs(benchmark::internal::Benchmark* b) {
-  for (int i = 1; i <= 128 * 1024 * 1024; i *= 8) {
-    for (int j = 64; j <= 128 * 1024 * 1024; j *= 8) {
-      double expected_time =
-          static_cast<double>(14 + i) / (125.0 * static_cast<double>(j));
-      if (expected_time > 2.0) continue;
-      b->Args({i, j});
+  for (int p = 0; p < static_cast<int> GPR_ARRAY_SIZE(kFlowControlPolicies);
+       p++) {
+    for (int i = 1; i <= 128 * 1024 * 1024; i *= 8) {
+      for (int j = 64; j <= 128 * 1024 * 1024; j *= 8) {
+        double expected_time =
+            static_cast<double>(14 + i) / (125.0 * static_cast<double>(j));
+        if (expected_time > 2.0) continue;
+        b->Args({i, j, p});
+      }
     }
   }
 }
@@ -357,6 +448,7 @@ static void BM_PumpUnbalancedUnary_Trickle(benchmark::State& state) {
   std::unique_ptr<TrickledCHTTP2> fixture(new TrickledCHTTP2(
       &service, false, state.range(0) /* req_size */,
       state.range(1) /* resp_size */, state.range(2) /* bw in kbit/s */,
+      state.range(3) /* flow control policy */,
       grpc_passthru_endpoint_stats_create()));
   EchoRequest send_request;
   EchoResponse send_response;
@@ -431,9 +523,13 @@ static void BM_PumpUnbalancedUnary_Trickle(benchmark::State& state) {
       break;
     }
   }
+  const gpr_atm measure_start_us = gpr_atm_no_barrier_load(&g_now_us);
   while (state.KeepRunning()) {
     inner_loop(false);
   }
+  SetSimulatedThroughput(
+      state, measure_start_us,
+      (state.range(0) + state.range(1)) * state.iterations());
   fixture->Finish(state);
   fixture.reset();
   server_env[0]->~ServerEnv();
@@ -443,19 +539,190 @@ static void BM_PumpUnbalancedUnary_Trickle(benchmark::State& state) {
 }
 
 static void UnaryTrickleArgs(benchmark::internal::Benchmark* b) {
-  for (int bw = 64; bw <= 128 * 1024 * 1024; bw *= 16) {
-    b->Args({1, 1, bw});
-    for (int i = 64; i <= 128 * 1024 * 1024; i *= 64) {
-      double expected_time =
-          static_cast<double>(14 + i) / (125.0 * static_cast<double>(bw));
-      if (expected_time > 2.0) continue;
-      b->Args({i, 1, bw});
-      b->Args({1, i, bw});
-      b->Args({i, i, bw});
+  for (int p = 0; p < static_cast<int> GPR_ARRAY_SIZE(kFlowControlPolicies);
+       p++) {
+    for (int bw = 64; bw <= 128 * 1024 * 1024; bw *= 16) {
+      b->Args({1, 1, bw, p});
+      for (int i = 64; i <= 128 * 1024 * 1024; i *= 64) {
+        double expected_time =
+            static_cast<double>(14 + i) / (125.0 * static_cast<double>(bw));
+        if (expected_time > 2.0) continue;
+        b->Args({i, 1, bw, p});
+        b->Args({1, i, bw, p});
+        b->Args({i, i, bw, p});
+      }
     }
   }
 }
 BENCHMARK(BM_PumpUnbalancedUnary_Trickle)->Apply(UnaryTrickleArgs);
+
+// Mixed traffic: the server streams bulk messages to the client as fast as the
+// link allows, while the client makes unary calls on the same connection, one
+// per iteration. Reports the latency of the unary calls, in simulated time.
+static void BM_PumpUnaryWithBulkStream_Trickle(benchmark::State& state) {
+  EchoTestService::AsyncService service;
+  std::unique_ptr<TrickledCHTTP2> fixture(new TrickledCHTTP2(
+      &service, true, 1 /* req_size */, state.range(0) /* resp_size */,
+      state.range(1) /* bw in kbit/s */, 0 /* flow control policy */,
+      grpc_passthru_endpoint_stats_create(),
+      state.range(2) /* write scheduler */));
+  EchoRequest send_request;
+  EchoResponse send_response;
+  EchoResponse recv_response;
+  EchoResponse send_bulk;
+  EchoResponse recv_bulk;
+  send_request.set_message("a");
+  send_response.set_message("a");
+  send_bulk.set_message(std::string(state.range(0), 'a'));
+  Status recv_status;
+  struct ServerEnv {
+    ServerContext ctx;
+    EchoRequest recv_request;
+    grpc::ServerAsyncResponseWriter<EchoResponse> response_writer;
+    ServerEnv() : response_writer(&ctx) {}
+  };
+  ServerEnv* server_env = new ServerEnv;
+  ServerContext svr_ctx;
+  ServerAsyncReaderWriter<EchoResponse, EchoRequest> response_rw(&svr_ctx);
+  service.RequestBidiStream(&svr_ctx, &response_rw, fixture->cq(),
+                            fixture->cq(), tag(0));
+  std::unique_ptr<EchoTestService::Stub> stub(
+      EchoTestService::NewStub(fixture->channel()));
+  ClientContext bulk_ctx;
+  auto request_rw = stub->AsyncBidiStream(&bulk_ctx, fixture->cq(), tag(1));
+  void* t;
+  bool ok;
+  for (int need_tags = (1 << 0) | (1 << 1); need_tags != 0;) {
+    TrickleCQNext(fixture.get(), &t, &ok, -1);
+    GPR_ASSERT(ok);
+    need_tags &= ~(1 << static_cast<int>(reinterpret_cast<intptr_t>(t)));
+  }
+  // From now on: 0 is a bulk message read by the client, 1 one written by the
+  // server, 2 a unary call received by the server, 3 its response sent, and 4
+  // the call completed on the client.
+  service.RequestEcho(&server_env->ctx, &server_env->recv_request,
+                      &server_env->response_writer, fixture->cq(),
+                      fixture->cq(), tag(2));
+  request_rw->Read(&recv_bulk, tag(0));
+  response_rw.Write(send_bulk, tag(1));
+  bool writing_bulk = true;
+  bool keep_writing_bulk = true;
+  int64_t bulk_bytes = 0;
+  auto handle_bulk = [&](intptr_t tagnum) {
+    if (tagnum == 0) {
+      bulk_bytes += state.range(0);
+      request_rw->Read(&recv_bulk, tag(0));
+    } else if (keep_writing_bulk) {
+      response_rw.Write(send_bulk, tag(1));
+    } else {
+      writing_bulk = false;
+    }
+  };
+  std::vector<gpr_atm> latencies_us;
+  auto inner_loop = [&](bool in_warmup) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    recv_response.Clear();
+    ClientContext cli_ctx;
+    const gpr_atm start_us = gpr_atm_no_barrier_load(&g_now_us);
+    std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader(
+        stub->AsyncEcho(&cli_ctx, send_request, fixture->cq()));
+    response_reader->Finish(&recv_response, &recv_status, tag(4));
+    for (int i = (1 << 3) | (1 << 4); i != 0;) {
+      TrickleCQNext(fixture.get(), &t, &ok,
+                    in_warmup ? -1 : state.iterations());
+      GPR_ASSERT(ok);
+      intptr_t tagnum = reinterpret_cast<intptr_t>(t);
+      switch (tagnum) {
+        case 0:
+        case 1:
+          handle_bulk(tagnum);
+          break;
+        case 2:
+          server_env->response_writer.Finish(send_response, Status::OK,
+                                             tag(3));
+          break;
+        case 3:
+        case 4:
+          if (tagnum == 4 && !in_warmup) {
+            latencies_us.push_back(gpr_atm_no_barrier_load(&g_now_us) -
+                                   start_us);
+          }
+          i &= ~(1 << tagnum);
+          break;
+        default:
+          GPR_ASSERT(false);
+      }
+    }
+    GPR_ASSERT(recv_status.ok());
+    delete server_env;
+    server_env = new ServerEnv;
+    service.RequestEcho(&server_env->ctx, &server_env->recv_request,
+                        &server_env->response_writer, fixture->cq(),
+                        fixture->cq(), tag(2));
+  };
+  gpr_timespec warmup_start = gpr_now(GPR_CLOCK_MONOTONIC);
+  for (int i = 0; i < absl::GetFlag(FLAGS_warmup_iterations); i++) {
+    inner_loop(true);
+    if (gpr_time_cmp(
+            gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), warmup_start),
+            gpr_time_from_seconds(absl::GetFlag(FLAGS_warmup_max_time_seconds),
+                                  GPR_TIMESPAN)) > 0) {
+      break;
+    }
+  }
+  const gpr_atm measure_start_us = gpr_atm_no_barrier_load(&g_now_us);
+  bulk_bytes = 0;
+  while (state.KeepRunning()) {
+    inner_loop(false);
+  }
+  SetSimulatedThroughput(state, measure_start_us, bulk_bytes);
+  std::sort(latencies_us.begin(), latencies_us.end());
+  auto percentile_ms = [&](double p) {
+    if (latencies_us.empty()) return 0.0;
+    size_t i = static_cast<size_t>(p * (latencies_us.size() - 1));
+    return static_cast<double>(latencies_us[i]) / 1000.0;
+  };
+  state.counters["unary_p50_ms"] = percentile_ms(0.5);
+  state.counters["unary_p99_ms"] = percentile_ms(0.99);
+  // Wind down the bulk stream once its last write is done
+  keep_writing_bulk = false;
+  while (writing_bulk) {
+    TrickleCQNext(fixture.get(), &t, &ok, -1);
+    GPR_ASSERT(ok);
+    handle_bulk(reinterpret_cast<intptr_t>(t));
+  }
+  response_rw.Finish(Status::OK, tag(1));
+  grpc::Status status;
+  request_rw->Finish(&status, tag(5));
+  for (int need_tags = (1 << 0) | (1 << 1) | (1 << 5); need_tags != 0;) {
+    TrickleCQNext(fixture.get(), &t, &ok, -1);
+    if (t == tag(0) && ok) {
+      request_rw->Read(&recv_bulk, tag(0));
+      continue;
+    }
+    int i = static_cast<int>(reinterpret_cast<intptr_t>(t));
+    GPR_ASSERT(need_tags & (1 << i));
+    need_tags &= ~(1 << i);
+  }
+  fixture->Finish(state);
+  fixture.reset();
+  delete server_env;
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void MixedTrafficTrickleArgs(benchmark::internal::Benchmark* b) {
+  for (int s = 0; s < static_cast<int> GPR_ARRAY_SIZE(kWriteSchedulers); s++) {
+    for (int bw = 1024; bw <= 128 * 1024 * 1024; bw *= 32) {
+      for (int i = 64 * 1024; i <= 4 * 1024 * 1024; i *= 8) {
+        double expected_time =
+            static_cast<double>(14 + i) / (125.0 * static_cast<double>(bw));
+        if (expected_time > 2.0) continue;
+        b->Args({i, bw, s});
+      }
+    }
+  }
+}
+BENCHMARK(BM_PumpUnaryWithBulkStream_Trickle)->Apply(MixedTrafficTrickleArgs);
 }  // namespace testing
 }  // namespace grpc
 
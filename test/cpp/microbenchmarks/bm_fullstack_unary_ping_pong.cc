@@ -162,6 +162,20 @@ BENCHMARK_TEMPLATE(BM_UnaryPingPong, InProcess, NoOpMutator,
                    Server_AddInitialMetadata<RandomAsciiMetadata<10>, 100>)
     ->Args({0, 0});
 
+// Throughput versus latency with and without HTTP2 write coalescing, by the
+// number of calls kept in flight.
+BENCHMARK_TEMPLATE(BM_UnaryPingPongInFlight, TCP)->Range(1, 64);
+BENCHMARK_TEMPLATE(BM_UnaryPingPongInFlight, WriteCoalescingTCP)
+    ->Range(1, 64);
+
+// Throughput by the number of calls kept in flight, when the server takes 16
+// calls at a time per connection: beyond that, a single connection queues the
+// calls, where a connection pool opens more connections to carry them.
+BENCHMARK_TEMPLATE(BM_UnaryPingPongInFlight, SingleConnectionTCP)
+    ->Range(16, 128);
+BENCHMARK_TEMPLATE(BM_UnaryPingPongInFlight, ConnectionPoolTCP)
+    ->Range(16, 128);
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -69,6 +69,56 @@ static void BM_SliceReIntern(benchmark::State& state) {
 }
 BENCHMARK(BM_SliceReIntern);
 
+// Interns strings that are already in the table from several threads, which
+// only needs the lock-free lookup path.
+static std::vector<grpc_slice>* g_interned_keys;
+static void BM_SliceInternExistingConcurrent(benchmark::State& state) {
+  TrackCounters track_counters;
+  constexpr int kNumKeys = 64;
+  std::vector<std::string> keys;
+  for (int i = 0; i < kNumKeys; ++i) {
+    keys.push_back("x-key-" + std::to_string(i));
+  }
+  // Holds a ref to every key for the duration of the run.
+  if (state.thread_index == 0) {
+    g_interned_keys = new std::vector<grpc_slice>();
+    for (const std::string& key : keys) {
+      g_interned_keys->push_back(
+          grpc_core::ManagedMemorySlice(key.data(), key.size()));
+    }
+  }
+  size_t n = state.thread_index;
+  for (auto _ : state) {
+    const std::string& key = keys[n++ % kNumKeys];
+    grpc_slice_unref(grpc_core::ManagedMemorySlice(key.data(), key.size()));
+  }
+  if (state.thread_index == 0) {
+    for (const grpc_slice& slice : *g_interned_keys) grpc_slice_unref(slice);
+    delete g_interned_keys;
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_SliceInternExistingConcurrent)->ThreadRange(1, 64);
+
+// Every thread interns and releases its own strings, so each iteration
+// inserts into and removes from the table.
+static void BM_SliceInternUniqueConcurrent(benchmark::State& state) {
+  TrackCounters track_counters;
+  constexpr int kNumKeys = 64;
+  std::vector<std::string> keys;
+  for (int i = 0; i < kNumKeys; ++i) {
+    keys.push_back("x-key-" + std::to_string(state.thread_index) + "-" +
+                   std::to_string(i));
+  }
+  size_t n = 0;
+  for (auto _ : state) {
+    const std::string& key = keys[n++ % kNumKeys];
+    grpc_slice_unref(grpc_core::ManagedMemorySlice(key.data(), key.size()));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_SliceInternUniqueConcurrent)->ThreadRange(1, 64);
+
 static void BM_SliceInternStaticMetadata(benchmark::State& state) {
   TrackCounters track_counters;
   for (auto _ : state) {
@@ -0,0 +1,106 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the ring of the ring_hash LB policy */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+#include "src/core/lib/gpr/murmur_hash.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+constexpr size_t kMinRingSize = 1024;
+constexpr size_t kMaxRingSize = 8 * 1024 * 1024;
+
+std::vector<std::string> MakeKeys(int count, int first = 0) {
+  std::vector<std::string> keys;
+  for (int i = first; i < first + count; i++) {
+    keys.push_back(absl::StrCat("10.0.", i / 256, ".", i % 256, ":443"));
+  }
+  return keys;
+}
+
+}  // namespace
+
+// Picks the address of a request key, as the picker does: hash the key, then
+// binary search the ring.
+static void BM_RingHash_Pick(benchmark::State& state) {
+  grpc_core::RingHashRing ring(MakeKeys(state.range(0)), kMinRingSize,
+                               kMaxRingSize, nullptr);
+  std::vector<std::string> request_keys;
+  for (int i = 0; i < 1024; i++) {
+    request_keys.push_back(absl::StrCat("user-", i));
+  }
+  size_t request = 0;
+  for (auto _ : state) {
+    const std::string& key = request_keys[request++ % request_keys.size()];
+    benchmark::DoNotOptimize(
+        ring.entry(ring.Find(gpr_murmur_hash3(key.data(), key.size(), 0)))
+            .index);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingHash_Pick)->Arg(3)->Arg(100)->Arg(1000);
+
+// Builds the ring from scratch.
+static void BM_RingHash_Build(benchmark::State& state) {
+  const std::vector<std::string> keys = MakeKeys(state.range(0));
+  for (auto _ : state) {
+    grpc_core::RingHashRing ring(keys, kMinRingSize, kMaxRingSize, nullptr);
+    benchmark::DoNotOptimize(ring.size());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingHash_Build)->Arg(3)->Arg(100)->Arg(1000);
+
+// Rebuilds the ring after an update that replaces one address.
+static void BM_RingHash_RebuildOneChanged(benchmark::State& state) {
+  const int count = state.range(0);
+  grpc_core::RingHashRing previous(MakeKeys(count), kMinRingSize, kMaxRingSize,
+                                   nullptr);
+  const std::vector<std::string> keys = MakeKeys(count, 1);
+  for (auto _ : state) {
+    grpc_core::RingHashRing ring(keys, kMinRingSize, kMaxRingSize, &previous);
+    benchmark::DoNotOptimize(ring.size());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingHash_RebuildOneChanged)->Arg(3)->Arg(100)->Arg(1000);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
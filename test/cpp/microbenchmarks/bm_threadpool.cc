@@ -23,6 +23,7 @@
 #include <mutex>
 
 #include "src/core/lib/iomgr/executor/threadpool.h"
+#include "src/core/lib/iomgr/executor/work_stealing_threadpool.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
@@ -30,6 +31,9 @@
 namespace grpc {
 namespace testing {
 
+using grpc_core::ThreadPool;
+using grpc_core::WorkStealingThreadPool;
+
 // This helper class allows a thread to block for a pre-specified number of
 // actions. BlockingCounter has an initial non-negative count on initialization.
 // Each call to DecrementCount will decrease the count by 1. When making a call
@@ -64,8 +68,8 @@ class BlockingCounter {
 // the end, therefore, no need for caller to do clean-ups.
 class AddAnotherFunctor : public grpc_experimental_completion_queue_functor {
  public:
-  AddAnotherFunctor(grpc_core::ThreadPool* pool, BlockingCounter* counter,
-                    int num_add)
+  AddAnotherFunctor(grpc_core::ThreadPoolInterface* pool,
+                    BlockingCounter* counter, int num_add)
       : pool_(pool), counter_(counter), num_add_(num_add) {
     functor_run = &AddAnotherFunctor::Run;
     inlineable = false;
@@ -87,18 +91,18 @@ class AddAnotherFunctor : public grpc_experimental_completion_queue_functor {
   }
 
  private:
-  grpc_core::ThreadPool* pool_;
+  grpc_core::ThreadPoolInterface* pool_;
   BlockingCounter* counter_;
   int num_add_;
 };
 
-template <int kConcurrentFunctor>
+template <class Pool, int kConcurrentFunctor>
 static void ThreadPoolAddAnother(benchmark::State& state) {
   const int num_iterations = state.range(0);
   const int num_threads = state.range(1);
   // Number of adds done by each closure.
   const int num_add = num_iterations / kConcurrentFunctor;
-  grpc_core::ThreadPool pool(num_threads);
+  Pool pool(num_threads);
   while (state.KeepRunningBatch(num_iterations)) {
     BlockingCounter counter(kConcurrentFunctor);
     for (int i = 0; i < kConcurrentFunctor; ++i) {
@@ -111,20 +115,41 @@ static void ThreadPoolAddAnother(benchmark::State& state) {
 
 // First pair of arguments is range for number of iterations (num_iterations).
 // Second pair of arguments is range for thread pool size (num_threads).
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 1)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 4)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 8)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 16)
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, ThreadPool, 1)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, ThreadPool, 4)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, ThreadPool, 8)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, ThreadPool, 16)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, ThreadPool, 32)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, ThreadPool, 64)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, ThreadPool, 128)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, ThreadPool, 512)
     ->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 32)
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, ThreadPool, 2048)
     ->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 64)
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, WorkStealingThreadPool, 1)
     ->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 128)
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, WorkStealingThreadPool, 4)
     ->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 512)
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, WorkStealingThreadPool, 8)
     ->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 2048)
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, WorkStealingThreadPool, 16)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, WorkStealingThreadPool, 32)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, WorkStealingThreadPool, 64)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, WorkStealingThreadPool, 128)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, WorkStealingThreadPool, 512)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, WorkStealingThreadPool, 2048)
     ->RangePair(524288, 524288, 1, 1024);
 
 // A functor class that will delete self on end of running.
@@ -149,12 +174,13 @@ class SuicideFunctorForAdd : public grpc_experimental_completion_queue_functor {
 };
 
 // Performs the scenario of external thread(s) adding closures into pool.
+template <class Pool>
 static void BM_ThreadPoolExternalAdd(benchmark::State& state) {
-  static grpc_core::ThreadPool* external_add_pool = nullptr;
+  static Pool* external_add_pool = nullptr;
   // Setup for each run of test.
   if (state.thread_index == 0) {
     const int num_threads = state.range(1);
-    external_add_pool = new grpc_core::ThreadPool(num_threads);
+    external_add_pool = new Pool(num_threads);
   }
   const int num_iterations = state.range(0) / state.threads;
   while (state.KeepRunningBatch(num_iterations)) {
@@ -171,18 +197,21 @@ static void BM_ThreadPoolExternalAdd(benchmark::State& state) {
     delete external_add_pool;
   }
 }
-BENCHMARK(BM_ThreadPoolExternalAdd)
+BENCHMARK_TEMPLATE(BM_ThreadPoolExternalAdd, ThreadPool)
     // First pair is range for number of iterations (num_iterations).
     // Second pair is range for thread pool size (num_threads).
     ->RangePair(524288, 524288, 1, 1024)
     ->ThreadRange(1, 256);  // Concurrent external thread(s) up to 256
+BENCHMARK_TEMPLATE(BM_ThreadPoolExternalAdd, WorkStealingThreadPool)
+    ->RangePair(524288, 524288, 1, 1024)
+    ->ThreadRange(1, 256);
 
 // Functor (closure) that adds itself into pool repeatedly. By adding self, the
 // overhead would be low and can measure the time of add more accurately.
 class AddSelfFunctor : public grpc_experimental_completion_queue_functor {
  public:
-  AddSelfFunctor(grpc_core::ThreadPool* pool, BlockingCounter* counter,
-                 int num_add)
+  AddSelfFunctor(grpc_core::ThreadPoolInterface* pool,
+                 BlockingCounter* counter, int num_add)
       : pool_(pool), counter_(counter), num_add_(num_add) {
     functor_run = &AddSelfFunctor::Run;
     inlineable = false;
@@ -203,18 +232,18 @@ class AddSelfFunctor : public grpc_experimental_completion_queue_functor {
   }
 
  private:
-  grpc_core::ThreadPool* pool_;
+  grpc_core::ThreadPoolInterface* pool_;
   BlockingCounter* counter_;
   int num_add_;
 };
 
-template <int kConcurrentFunctor>
+template <class Pool, int kConcurrentFunctor>
 static void ThreadPoolAddSelf(benchmark::State& state) {
   const int num_iterations = state.range(0);
   const int num_threads = state.range(1);
   // Number of adds done by each closure.
   const int num_add = num_iterations / kConcurrentFunctor;
-  grpc_core::ThreadPool pool(num_threads);
+  Pool pool(num_threads);
   while (state.KeepRunningBatch(num_iterations)) {
     BlockingCounter counter(kConcurrentFunctor);
     for (int i = 0; i < kConcurrentFunctor; ++i) {
@@ -227,15 +256,42 @@ static void ThreadPoolAddSelf(benchmark::State& state) {
 
 // First pair of arguments is range for number of iterations (num_iterations).
 // Second pair of arguments is range for thread pool size (num_threads).
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 1)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 4)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 8)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 16)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 32)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 64)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 128)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 512)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 2048)->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, ThreadPool, 1)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, ThreadPool, 4)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, ThreadPool, 8)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, ThreadPool, 16)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, ThreadPool, 32)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, ThreadPool, 64)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, ThreadPool, 128)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, ThreadPool, 512)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, ThreadPool, 2048)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, WorkStealingThreadPool, 1)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, WorkStealingThreadPool, 4)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, WorkStealingThreadPool, 8)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, WorkStealingThreadPool, 16)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, WorkStealingThreadPool, 32)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, WorkStealingThreadPool, 64)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, WorkStealingThreadPool, 128)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, WorkStealingThreadPool, 512)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, WorkStealingThreadPool, 2048)
+    ->RangePair(524288, 524288, 1, 1024);
 
 #if defined(__GNUC__) && !defined(SWIG)
 #if defined(__i386__) || defined(__x86_64__)
@@ -290,13 +346,14 @@ class ShortWorkFunctorForAdd
 // continuously so the number of workers running changes overtime.
 //
 // In effect this tests how well the threadpool avoids spurious wakeups.
+template <class Pool>
 static void BM_SpikyLoad(benchmark::State& state) {
   const int num_threads = state.range(0);
 
   const int kNumSpikes = 1000;
   const int batch_size = 3 * num_threads;
   std::vector<ShortWorkFunctorForAdd> work_vector(batch_size);
-  grpc_core::ThreadPool pool(num_threads);
+  Pool pool(num_threads);
   while (state.KeepRunningBatch(kNumSpikes * batch_size)) {
     for (int i = 0; i != kNumSpikes; ++i) {
       BlockingCounter counter(batch_size);
@@ -309,7 +366,18 @@ static void BM_SpikyLoad(benchmark::State& state) {
   }
   state.SetItemsProcessed(state.iterations() * batch_size);
 }
-BENCHMARK(BM_SpikyLoad)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
+BENCHMARK_TEMPLATE(BM_SpikyLoad, ThreadPool)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16);
+BENCHMARK_TEMPLATE(BM_SpikyLoad, WorkStealingThreadPool)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16);
 
 }  // namespace testing
 }  // namespace grpc
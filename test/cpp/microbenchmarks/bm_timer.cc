@@ -100,6 +100,49 @@ BENCHMARK(BM_TimerBatch)
     ->Args({/*check=*/true, /*reverse=*/true})
     ->ThreadRange(1, 128);
 
+// Re-arms one timer per iteration while state.range(0) others are pending,
+// the way call deadlines are usually cancelled long before they fire. Run
+// with GRPC_TIMER_STRATEGY=heap and GRPC_TIMER_STRATEGY=wheel to compare the
+// two implementations.
+static void BM_TimerRearmWithOutstanding(benchmark::State& state) {
+  const size_t outstanding = state.range(0);
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<TimerClosure> timer_closures(outstanding);
+  const grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  // Spread deadlines over an hour, starting far enough out that none fire
+  // while the benchmark runs.
+  auto deadline_for = [now](size_t i) {
+    return now + 60000 + static_cast<grpc_millis>((i * 7919) % 3600000);
+  };
+  for (size_t i = 0; i < outstanding; i++) {
+    TimerClosure* timer_closure = &timer_closures[i];
+    GRPC_CLOSURE_INIT(
+        &timer_closure->closure, [](void* /*args*/, grpc_error* /*err*/) {},
+        nullptr, grpc_schedule_on_exec_ctx);
+    grpc_timer_init(&timer_closure->timer, deadline_for(i),
+                    &timer_closure->closure);
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    TimerClosure* timer_closure = &timer_closures[i % outstanding];
+    grpc_timer_cancel(&timer_closure->timer);
+    grpc_timer_init(&timer_closure->timer, deadline_for(i + outstanding),
+                    &timer_closure->closure);
+    exec_ctx.Flush();
+    i++;
+  }
+  for (TimerClosure& timer_closure : timer_closures) {
+    grpc_timer_cancel(&timer_closure.timer);
+  }
+  exec_ctx.Flush();
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_TimerRearmWithOutstanding)
+    ->Arg(1 << 10)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20);
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -326,6 +326,85 @@ typedef MinStackize<InProcess> MinInProcess;
 typedef MinStackize<SockPair> MinSockPair;
 typedef MinStackize<InProcessCHTTP2> MinInProcessCHTTP2;
 
+////////////////////////////////////////////////////////////////////////////////
+// TCP receive zerocopy fixtures
+
+class RxZerocopyConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED, 1);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED, 1);
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
+template <class Base>
+class RxZerocopyize : public Base {
+ public:
+  explicit RxZerocopyize(Service* service)
+      : Base(service, RxZerocopyConfiguration()) {}
+};
+
+typedef RxZerocopyize<TCP> RxZerocopyTCP;
+
+////////////////////////////////////////////////////////////////////////////////
+// HTTP2 write coalescing fixtures
+
+template <int kDelayMs>
+class WriteCoalescingConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_MS, kDelayMs);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_MS, kDelayMs);
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
+template <class Base, int kDelayMs>
+class WriteCoalescingize : public Base {
+ public:
+  explicit WriteCoalescingize(Service* service)
+      : Base(service, WriteCoalescingConfiguration<kDelayMs>()) {}
+};
+
+typedef WriteCoalescingize<TCP, 1> WriteCoalescingTCP;
+
+////////////////////////////////////////////////////////////////////////////////
+// Subchannel connection pool fixtures
+
+// The server takes at most kMaxStreams concurrent calls per connection, which
+// the client may spread over up to kConnections connections.
+template <int kConnections, int kMaxStreams>
+class ConnectionPoolConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS, kConnections);
+    a->SetInt(GRPC_ARG_SUBCHANNEL_MAX_CALLS_PER_CONNECTION, kMaxStreams);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(GRPC_ARG_MAX_CONCURRENT_STREAMS, kMaxStreams);
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
+template <class Base, int kConnections, int kMaxStreams>
+class ConnectionPoolize : public Base {
+ public:
+  explicit ConnectionPoolize(Service* service)
+      : Base(service,
+             ConnectionPoolConfiguration<kConnections, kMaxStreams>()) {}
+};
+
+typedef ConnectionPoolize<TCP, 1, 16> SingleConnectionTCP;
+typedef ConnectionPoolize<TCP, 4, 16> ConnectionPoolTCP;
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -125,6 +125,9 @@ class Server {
       builder->SetResourceQuota(ResourceQuota("AsyncQpsServerTest")
                                     .Resize(config.resource_quota_size()));
     }
+    if (config.thread_per_core()) {
+      builder->experimental().SetThreadPerCore(true);
+    }
     for (const auto& channel_arg : config.channel_args()) {
       switch (channel_arg.value_case()) {
         case ChannelArg::kStrValue:
@@ -35,6 +35,7 @@
 #include <grpcpp/support/config.h>
 
 #include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/surface/completion_queue.h"
 #include "src/proto/grpc/testing/benchmark_service.grpc.pb.h"
 #include "test/core/util/test_config.h"
@@ -89,12 +90,15 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
     register_service(builder.get(), &async_service_);
 
     int num_threads = config.async_server_threads();
-    if (num_threads <= 0) {  // dynamic sizing
+    if (num_threads <= 0 || config.thread_per_core()) {  // dynamic sizing
       num_threads = cores();
       gpr_log(GPR_INFO, "Sizing async server to %d threads", num_threads);
     }
 
-    int tpc = std::max(1, config.threads_per_cq());  // 1 if unspecified
+    // In thread-per-core mode, thread and CQ i are both tied to core i
+    int tpc = config.thread_per_core()
+                  ? 1
+                  : std::max(1, config.threads_per_cq());  // 1 if unspecified
     int num_cqs = (num_threads + tpc - 1) / tpc;     // ceiling operator
     for (int i = 0; i < num_cqs; i++) {
       srv_cqs_.emplace_back(builder->AddCompletionQueue());
@@ -157,6 +161,7 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
       }
     }
 
+    pin_threads_ = config.thread_per_core();
     for (int i = 0; i < num_threads; i++) {
       shutdown_state_.emplace_back(new PerThreadShutdownState());
       threads_.emplace_back(&AsyncQpsServerTest::ThreadFunc, this, i);
@@ -200,6 +205,9 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
 
  private:
   void ThreadFunc(int thread_idx) {
+    if (pin_threads_ && !grpc_core::Thread::PinCurrentToCore(thread_idx)) {
+      gpr_log(GPR_ERROR, "Failed to pin server thread to core %d", thread_idx);
+    }
     // Wait until work is available or we are shutting down
     bool ok;
     void* got_tag;
@@ -517,6 +525,7 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
   };
 
   std::vector<std::thread> threads_;
+  bool pin_threads_ = false;
   std::unique_ptr<grpc::Server> server_;
   std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> srv_cqs_;
   std::vector<int> cq_;
@@ -84,6 +84,15 @@ TEST_F(ServerBuilderTest, CreateServerRepeatedPortWithDisallowedReusePort) {
             nullptr);
 }
 
+TEST_F(ServerBuilderTest, CreateServerThreadPerCore) {
+  ServerBuilder builder;
+  builder.experimental().SetThreadPerCore(true);
+  builder.RegisterService(&g_service)
+      .AddListeningPort(GetPort(), InsecureServerCredentials())
+      .BuildAndStart()
+      ->Shutdown();
+}
+
 }  // namespace
 }  // namespace grpc
 
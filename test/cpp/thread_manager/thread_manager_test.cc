@@ -16,6 +16,7 @@
  *is % allowed in string
  */
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <climits>
@@ -55,6 +56,9 @@ struct TestThreadManagerSettings {
 
   // How many should be instantiated
   int thread_manager_count;
+
+  // The GRPC_SYNC_SERVER_STRATEGY to use
+  const char* strategy;
 };
 
 class TestThreadManager final : public grpc::ThreadManager {
@@ -126,6 +130,7 @@ class ThreadManagerTest
     : public ::testing::TestWithParam<TestThreadManagerSettings> {
  protected:
   void SetUp() override {
+    GPR_GLOBAL_CONFIG_SET(grpc_sync_server_strategy, GetParam().strategy);
     grpc_resource_quota* rq = grpc_resource_quota_create("Thread manager test");
     if (GetParam().thread_limit > 0) {
       grpc_resource_quota_set_max_threads(rq, GetParam().thread_limit);
@@ -149,10 +154,16 @@ class ThreadManagerTest
 TestThreadManagerSettings scenarios[] = {
     {2 /* min_pollers */, 10 /* max_pollers */, 10 /* poll_duration_ms */,
      1 /* work_duration_ms */, 50 /* max_poll_calls */,
-     INT_MAX /* thread_limit */, 1 /* thread_manager_count */},
+     INT_MAX /* thread_limit */, 1 /* thread_manager_count */, "legacy"},
     {1 /* min_pollers */, 1 /* max_pollers */, 1 /* poll_duration_ms */,
      10 /* work_duration_ms */, 50 /* max_poll_calls */, 3 /* thread_limit */,
-     2 /* thread_manager_count */}};
+     2 /* thread_manager_count */, "legacy"},
+    {2 /* min_pollers */, 10 /* max_pollers */, 10 /* poll_duration_ms */,
+     1 /* work_duration_ms */, 50 /* max_poll_calls */,
+     INT_MAX /* thread_limit */, 1 /* thread_manager_count */, "pooled"},
+    {1 /* min_pollers */, 1 /* max_pollers */, 1 /* poll_duration_ms */,
+     10 /* work_duration_ms */, 50 /* max_poll_calls */, 3 /* thread_limit */,
+     2 /* thread_manager_count */, "pooled"}};
 
 INSTANTIATE_TEST_SUITE_P(ThreadManagerTest, ThreadManagerTest,
                          ::testing::ValuesIn(scenarios));
@@ -176,6 +187,148 @@ TEST_P(ThreadManagerTest, TestThreadQuota) {
   }
 }
 
+// Returns work in batches, to check that the pooled strategy hands every item
+// of a batch to DoWork() exactly once.
+class BatchThreadManager final : public grpc::ThreadManager {
+ public:
+  BatchThreadManager(grpc_resource_quota* rq, int num_batches)
+      : ThreadManager("BatchThreadManager", rq, 1, 1),
+        num_batches_(num_batches) {}
+
+  grpc::ThreadManager::WorkStatus PollForWork(void** /*tag*/,
+                                              bool* /*ok*/) override {
+    GPR_ASSERT(false);  // The pooled strategy only calls PollForWorkBatch()
+    return SHUTDOWN;
+  }
+
+  grpc::ThreadManager::WorkStatus PollForWorkBatch(void** tags, bool* oks,
+                                                   size_t max_items,
+                                                   size_t* num_items) override {
+    if (num_poll_for_work_++ == num_batches_) {
+      Shutdown();
+      return SHUTDOWN;
+    }
+    for (size_t i = 0; i < max_items; i++) {
+      tags[i] = reinterpret_cast<void*>(i + 1);
+      oks[i] = true;
+    }
+    *num_items = max_items;
+    num_items_found_ += static_cast<int>(max_items);
+    return WORK_FOUND;
+  }
+
+  void DoWork(void* tag, bool ok, bool /*resources*/) override {
+    EXPECT_NE(tag, nullptr);
+    EXPECT_TRUE(ok);
+    num_do_work_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  int num_items_found() const { return num_items_found_; }
+  int num_do_work() const {
+    return num_do_work_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  const int num_batches_;
+  // Only accessed by the single poller thread
+  int num_poll_for_work_ = 0;
+  int num_items_found_ = 0;
+  std::atomic_int num_do_work_{0};
+};
+
+TEST(ThreadManagerPooledTest, TestBatchDispatch) {
+  GPR_GLOBAL_CONFIG_SET(grpc_sync_server_strategy, "pooled");
+  grpc_resource_quota* rq = grpc_resource_quota_create("Thread manager test");
+  grpc_resource_quota_set_max_threads(rq, 8);
+  BatchThreadManager tm(rq, 1000);
+  grpc_resource_quota_unref(rq);
+  tm.Initialize();
+  tm.Wait();
+  EXPECT_GT(tm.num_items_found(), 0);
+  EXPECT_EQ(tm.num_do_work(), tm.num_items_found());
+  EXPECT_LE(tm.GetMaxActiveThreadsSoFar(), 8);
+}
+
+// Finds one burst of slow work, then polls without finding any until shut
+// down, to check that the pooled strategy caps its workers and retires them
+// once they are idle.
+class BurstThreadManager final : public grpc::ThreadManager {
+ public:
+  BurstThreadManager(grpc_resource_quota* rq, int burst_size)
+      : ThreadManager("BurstThreadManager", rq, 1, 1),
+        burst_size_(burst_size) {}
+
+  grpc::ThreadManager::WorkStatus PollForWork(void** /*tag*/,
+                                              bool* /*ok*/) override {
+    GPR_ASSERT(false);  // The pooled strategy only calls PollForWorkBatch()
+    return SHUTDOWN;
+  }
+
+  grpc::ThreadManager::WorkStatus PollForWorkBatch(void** tags, bool* oks,
+                                                   size_t max_items,
+                                                   size_t* num_items) override {
+    if (IsShutdown()) return SHUTDOWN;
+    if (burst_found_ == burst_size_) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      return TIMEOUT;
+    }
+    *num_items =
+        std::min(max_items, static_cast<size_t>(burst_size_ - burst_found_));
+    for (size_t i = 0; i < *num_items; i++) {
+      tags[i] = reinterpret_cast<void*>(i + 1);
+      oks[i] = true;
+    }
+    burst_found_ += static_cast<int>(*num_items);
+    return WORK_FOUND;
+  }
+
+  void DoWork(void* /*tag*/, bool /*ok*/, bool resources) override {
+    EXPECT_TRUE(resources);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    num_do_work_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  int num_do_work() const {
+    return num_do_work_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  const int burst_size_;
+  // Only accessed by the single poller thread
+  int burst_found_ = 0;
+  std::atomic_int num_do_work_{0};
+};
+
+TEST(ThreadManagerPooledTest, TestWorkerCapAndIdleExit) {
+  const int kMaxWorkers = 4;
+  const int kBurstSize = 64;
+  GPR_GLOBAL_CONFIG_SET(grpc_sync_server_strategy, "pooled");
+  GPR_GLOBAL_CONFIG_SET(grpc_sync_server_max_workers, kMaxWorkers);
+  GPR_GLOBAL_CONFIG_SET(grpc_sync_server_worker_idle_ms, 100);
+  grpc_resource_quota* rq = grpc_resource_quota_create("Thread manager test");
+  BurstThreadManager tm(rq, kBurstSize);
+  grpc_resource_quota_unref(rq);
+  tm.Initialize();
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  while (tm.num_do_work() < kBurstSize &&
+         gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(tm.num_do_work(), kBurstSize);
+  // The poller and kMaxWorkers workers, however large the burst
+  EXPECT_EQ(tm.GetMaxActiveThreadsSoFar(), 1 + kMaxWorkers);
+  // Once idle, the workers exit and only the poller is left.
+  while (tm.GetNumActiveThreads() > 1 &&
+         gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(tm.GetNumActiveThreads(), 1);
+  tm.Shutdown();
+  tm.Wait();
+  GPR_GLOBAL_CONFIG_SET(grpc_sync_server_max_workers, 0);
+  GPR_GLOBAL_CONFIG_SET(grpc_sync_server_worker_idle_ms, 10000);
+}
+
 }  // namespace
 }  // namespace grpc
 
@@ -62,6 +62,9 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_pollset_kick_own_thread"] = massage_qps_stats_helpers.counter(
                     core_stats, "pollset_kick_own_thread")
+            stats[
+                "core_pollset_kick_spinning"] = massage_qps_stats_helpers.counter(
+                    core_stats, "pollset_kick_spinning")
             stats["core_syscall_epoll_ctl"] = massage_qps_stats_helpers.counter(
                 core_stats, "syscall_epoll_ctl")
             stats[
@@ -80,6 +83,12 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_tcp_backup_poller_polls"] = massage_qps_stats_helpers.counter(
                     core_stats, "tcp_backup_poller_polls")
+            stats[
+                "core_tcp_idle_read_buffers_released"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_idle_read_buffers_released")
+            stats[
+                "core_tcp_idle_read_buffers_reallocated"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_idle_read_buffers_reallocated")
             stats["core_http2_op_batches"] = massage_qps_stats_helpers.counter(
                 core_stats, "http2_op_batches")
             stats["core_http2_op_cancel"] = massage_qps_stats_helpers.counter(
@@ -119,6 +128,9 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_partial_writes"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_partial_writes")
+            stats[
+                "core_http2_writes_coalesced"] = massage_qps_stats_helpers.counter(
+                    core_stats, "http2_writes_coalesced")
             stats[
                 "core_http2_initiate_write_due_to_initial_write"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_initiate_write_due_to_initial_write")
@@ -196,6 +208,9 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_spurious_writes_begun"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_spurious_writes_begun")
+            stats[
+                "core_http2_idle_parser_buffers_released"] = massage_qps_stats_helpers.counter(
+                    core_stats, "http2_idle_parser_buffers_released")
             stats[
                 "core_hpack_recv_indexed"] = massage_qps_stats_helpers.counter(
                     core_stats, "hpack_recv_indexed")
@@ -347,6 +362,36 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_poll_events_returned_99p"] = massage_qps_stats_helpers.percentile(
                     h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "pollset_spin_time")
+            stats["core_pollset_spin_time"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_pollset_spin_time_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_pollset_spin_time_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_pollset_spin_time_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_pollset_spin_time_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "pollset_wakeup_latency")
+            stats["core_pollset_wakeup_latency"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_pollset_wakeup_latency_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_pollset_wakeup_latency_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_pollset_wakeup_latency_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_pollset_wakeup_latency_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
             h = massage_qps_stats_helpers.histogram(core_stats,
                                                     "tcp_write_size")
             stats["core_tcp_write_size"] = ",".join("%f" % x for x in h.buckets)
@@ -494,6 +539,126 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_send_flowctl_per_write_99p"] = massage_qps_stats_helpers.percentile(
                     h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "http2_write_batch_size")
+            stats["core_http2_write_batch_size"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_http2_write_batch_size_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_http2_write_batch_size_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_http2_write_batch_size_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_http2_write_batch_size_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "http2_write_requests_per_write")
+            stats["core_http2_write_requests_per_write"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_http2_write_requests_per_write_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_http2_write_requests_per_write_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_http2_write_requests_per_write_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_http2_write_requests_per_write_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "combiner_queue_depth")
+            stats["core_combiner_queue_depth"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_combiner_queue_depth_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_combiner_queue_depth_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_combiner_queue_depth_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_combiner_queue_depth_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "combiner_queue_time")
+            stats["core_combiner_queue_time"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_combiner_queue_time_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_combiner_queue_time_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_combiner_queue_time_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_combiner_queue_time_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "combiner_exec_time")
+            stats["core_combiner_exec_time"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_combiner_exec_time_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_combiner_exec_time_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_combiner_exec_time_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_combiner_exec_time_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "work_serializer_queue_depth")
+            stats["core_work_serializer_queue_depth"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_work_serializer_queue_depth_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_work_serializer_queue_depth_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_work_serializer_queue_depth_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_work_serializer_queue_depth_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "work_serializer_queue_time")
+            stats["core_work_serializer_queue_time"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_work_serializer_queue_time_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_work_serializer_queue_time_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_work_serializer_queue_time_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_work_serializer_queue_time_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "work_serializer_exec_time")
+            stats["core_work_serializer_exec_time"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_work_serializer_exec_time_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_work_serializer_exec_time_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_work_serializer_exec_time_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_work_serializer_exec_time_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
             h = massage_qps_stats_helpers.histogram(core_stats,
                                                     "server_cqs_checked")
             stats["core_server_cqs_checked"] = ",".join(
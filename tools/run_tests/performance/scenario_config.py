@@ -132,7 +132,8 @@ def _ping_pong_scenario(name,
                         messages_per_stream=None,
                         excluded_poll_engines=[],
                         minimal_stack=False,
-                        offered_load=None):
+                        offered_load=None,
+                        server_thread_per_core=False):
     """Creates a basic ping pong scenario."""
     scenario = {
         'name': name,
@@ -163,6 +164,8 @@ def _ping_pong_scenario(name,
     }
     if resource_quota_size:
         scenario['server_config']['resource_quota_size'] = resource_quota_size
+    if server_thread_per_core:
+        scenario['server_config']['thread_per_core'] = True
     if use_generic_payload:
         if server_type != 'ASYNC_GENERIC_SERVER':
             raise Exception('Use ASYNC_GENERIC_SERVER for generic payload.')
@@ -446,6 +449,28 @@ class CXXLanguage:
                 server_threads_per_cq=2,
                 categories=inproc_categories + [SCALABLE])
 
+            yield _ping_pong_scenario(
+                'cpp_protobuf_async_unary_qps_unconstrained_thread_per_core_%s'
+                % secstr,
+                rpc_type='UNARY',
+                client_type='ASYNC_CLIENT',
+                server_type='ASYNC_SERVER',
+                unconstrained_client='async',
+                secure=secure,
+                server_thread_per_core=True,
+                categories=[SCALABLE])
+
+            yield _ping_pong_scenario(
+                'cpp_protobuf_async_client_sync_server_unary_qps_unconstrained_thread_per_core_%s'
+                % secstr,
+                rpc_type='UNARY',
+                client_type='ASYNC_CLIENT',
+                server_type='SYNC_SERVER',
+                unconstrained_client='async',
+                secure=secure,
+                server_thread_per_core=True,
+                categories=[SCALABLE])
+
             yield _ping_pong_scenario(
                 'cpp_generic_async_streaming_qps_one_server_core_%s' % secstr,
                 rpc_type='STREAMING',